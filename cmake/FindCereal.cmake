@@ -4,6 +4,14 @@
 #
 #  CEREAL_FOUND - True if cereal is found.
 #  CEREAL_INCLUDE_DIR - Where to find cereal headers.
+#
+# When the headers are not installed they are downloaded with FetchContent,
+# unless ENABLE_CEREAL_FETCH is OFF (e.g. offline builds).
+
+# A stale or mistyped cache entry would skip the search below.
+if(CEREAL_INCLUDE_DIR AND NOT EXISTS "${CEREAL_INCLUDE_DIR}/cereal/cereal.hpp")
+    unset(CEREAL_INCLUDE_DIR CACHE)
+endif()
 
 find_path(CEREAL_INCLUDE_DIR
     cereal/cereal.hpp
@@ -11,13 +19,20 @@ find_path(CEREAL_INCLUDE_DIR
     HINTS ${Cereal_INCLUDE_DIR}
 )
 
-if(NOT CEREAL_INCLUDE_DIR)
+if(NOT CEREAL_INCLUDE_DIR AND (NOT DEFINED ENABLE_CEREAL_FETCH OR ENABLE_CEREAL_FETCH))
     include(FetchContent)
+    # Extracted files get the extraction time, so that a new URL triggers a rebuild.
+    if(POLICY CMP0135)
+        cmake_policy(SET CMP0135 NEW)
+    endif()
     FetchContent_Declare(
         cereal
         URL https://github.com/USCiLab/cereal/archive/refs/tags/v1.3.0.tar.gz
     )
-    FetchContent_Populate(cereal)
+    FetchContent_GetProperties(cereal)
+    if(NOT cereal_POPULATED)
+        FetchContent_Populate(cereal)
+    endif()
     set(CEREAL_INCLUDE_DIR ${cereal_SOURCE_DIR}/include)
 endif()
 # Handle the QUIET and REQUIRED arguments and
@@ -0,0 +1,19 @@
+#include "bench_utils.h"
+
+/**
+ * The benchmark driver. All the Google Benchmark flags apply, e.g.
+ *
+ *     container_bench --benchmark_filter=gemm --benchmark_out=bench.json --benchmark_out_format=json
+ *
+ * writes the results with the measured peaks in the context, to compare between releases.
+ */
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    container::bench::measure_peaks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
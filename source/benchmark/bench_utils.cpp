@@ -0,0 +1,103 @@
+#include "bench_utils.h"
+#include "../thread_pool.h"
+#include "../kernels/blas_op.h"
+
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+
+#include <unistd.h>
+
+namespace container {
+namespace bench {
+
+namespace {
+
+double dram_bandwidth_ = 0.0;
+double peak_flops_ = 0.0;
+
+// The size of the last level cache in bytes, 0 if unknown.
+size_t last_level_cache() {
+    for (const int name : {_SC_LEVEL4_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+        const long size = sysconf(name);
+        if (size > 0) {
+            return static_cast<size_t>(size);
+        }
+    }
+    return 0;
+}
+
+// The best of a few runs of f, in seconds.
+template <typename Function>
+double best_time(const int& repeats, const Function& f) {
+    double best = 1e300;
+    for (int ii = 0; ii < repeats; ii++) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, seconds_since(start));
+    }
+    return best;
+}
+
+std::string format_rate(const double& value, const char* unit) {
+    std::ostringstream os;
+    os.precision(4);
+    os << value * 1e-9 << " G" << unit;
+    return os.str();
+}
+
+} // namespace
+
+void measure_peaks() {
+    // Copies of twice the last level cache in each direction, at least 1 GiB in total and at most 4 GiB,
+    // so that no part of them is served from the cache. Each byte is read and written once.
+    const size_t bytes = std::min(std::max(2 * last_level_cache(), size_t(1) << 29), size_t(1) << 31);
+    std::vector<char> src(bytes, 1), dst(bytes, 0);
+    const double copy_time = best_time(3, [&]() {
+        parallel_for(0, bytes, 1 << 20, [&](int64_t begin, int64_t end) {
+            std::memcpy(dst.data() + begin, src.data() + begin, end - begin);
+        });
+    });
+    dram_bandwidth_ = 2.0 * bytes / copy_time;
+
+    const int n = 512;
+    std::vector<double> a(n * n), b(n * n), c(n * n);
+    fill(a.data(), n * n, 0.0);
+    fill(b.data(), n * n, 1.0);
+    const double alpha = 1.0, beta = 0.0;
+    const double gemm_time = best_time(3, [&]() {
+        op::gemm_op<double, DEVICE_CPU>()('N', 'N', n, n, n, &alpha, a.data(), n, b.data(), n, &beta, c.data(), n);
+    });
+    peak_flops_ = 2.0 * n * n * n / gemm_time;
+
+    benchmark::AddCustomContext("dram_bandwidth", format_rate(dram_bandwidth_, "B/s"));
+    benchmark::AddCustomContext("peak_flops", format_rate(peak_flops_, "FLOP/s"));
+    benchmark::AddCustomContext("num_threads", std::to_string(get_num_threads()));
+}
+
+double dram_bandwidth() {
+    return dram_bandwidth_;
+}
+
+double peak_flops() {
+    return peak_flops_;
+}
+
+void report_bandwidth(benchmark::State& state, const double& bytes, const double& seconds) {
+    const double total = bytes * state.iterations();
+    state.counters["bytes/s"] = benchmark::Counter(total, benchmark::Counter::kIsRate);
+    if (dram_bandwidth_ > 0 && seconds > 0) {
+        state.counters["of_dram"] = total / seconds / dram_bandwidth_;
+    }
+}
+
+void report_flops(benchmark::State& state, const double& flops, const double& seconds) {
+    const double total = flops * state.iterations();
+    state.counters["FLOP/s"] = benchmark::Counter(total, benchmark::Counter::kIsRate);
+    if (peak_flops_ > 0 && seconds > 0) {
+        state.counters["of_peak"] = total / seconds / peak_flops_;
+    }
+}
+
+} // namespace bench
+} // namespace container
@@ -0,0 +1,111 @@
+#ifndef CONTAINER_BENCHMARK_BENCH_UTILS_H
+#define CONTAINER_BENCHMARK_BENCH_UTILS_H
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <complex>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "../tensor_types.h"
+
+namespace container {
+namespace bench {
+
+/**
+ * @brief Measure the main memory bandwidth and the peak floating point rate of this machine.
+ *
+ * The bandwidth is that of multithreaded copies on the shared thread pool, several times larger
+ * than the last level cache, the flop rate that of a large double precision gemm_op. Both are
+ * added to the benchmark context, so that they are part of the JSON output. Memory-bound
+ * benchmarks report their rate as a fraction of the DRAM bandwidth in the "of_dram" counter,
+ * cache-resident sizes exceed 1. Compute-bound benchmarks report a fraction of the flop rate in
+ * the "of_peak" counter.
+ */
+void measure_peaks();
+
+/// @brief The measured main memory bandwidth in bytes per second.
+double dram_bandwidth();
+
+/// @brief The measured peak double precision rate in flops per second.
+double peak_flops();
+
+/**
+ * @brief The wall time since start in seconds.
+ *
+ * The benchmarks time their loops with it, the ratios to the peaks are plain numbers and need the
+ * elapsed time, which Google Benchmark only applies to rate counters.
+ */
+inline double seconds_since(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Report the bandwidth of a memory-bound benchmark, as bytes/s and as a fraction of the DRAM bandwidth.
+ *
+ * @param bytes The bytes read and written by one iteration.
+ * @param seconds The wall time of all the iterations.
+ */
+void report_bandwidth(benchmark::State& state, const double& bytes, const double& seconds);
+
+/**
+ * @brief Report the flop rate of a compute-bound benchmark, as FLOP/s and as a fraction of the peak.
+ *
+ * @param flops The real flops of one iteration, complex operations count 4 real flops per multiply-add.
+ * @param seconds The wall time of all the iterations.
+ */
+void report_flops(benchmark::State& state, const double& flops, const double& seconds);
+
+/**
+ * @brief Fill a buffer with reproducible values in [-1, 1].
+ */
+template <typename T>
+void fill(T* data, const int64_t& n, const double& seed = 0.0) {
+    for (int64_t ii = 0; ii < n; ii++) {
+        data[ii] = static_cast<T>(std::sin(seed + 0.7 * ii));
+    }
+}
+
+template <typename T>
+void fill(std::complex<T>* data, const int64_t& n, const double& seed = 0.0) {
+    for (int64_t ii = 0; ii < n; ii++) {
+        data[ii] = std::complex<T>(static_cast<T>(std::sin(seed + 0.7 * ii)), static_cast<T>(std::cos(seed + 0.3 * ii)));
+    }
+}
+
+/// @brief The complex conjugate, the identity for real values.
+template <typename T>
+T conjugate(const T& x) {
+    return x;
+}
+
+template <typename T>
+std::complex<T> conjugate(const std::complex<T>& x) {
+    return std::conj(x);
+}
+
+/**
+ * @brief A column-major Hermitian (symmetric for real T) n x n matrix with a dominant diagonal.
+ *
+ * @param shift Added to the diagonal, a large shift makes the matrix positive definite.
+ */
+template <typename T>
+std::vector<T> hermitian_matrix(const int& n, const double& shift, const double& seed = 0.0) {
+    std::vector<T> a(static_cast<size_t>(n) * n);
+    fill(a.data(), static_cast<int64_t>(a.size()), seed);
+    for (int jj = 0; jj < n; jj++) {
+        for (int ii = 0; ii < jj; ii++) {
+            a[ii + static_cast<size_t>(jj) * n] = conjugate(a[jj + static_cast<size_t>(ii) * n]);
+        }
+        // The diagonal of a Hermitian matrix is real.
+        a[jj + static_cast<size_t>(jj) * n] = static_cast<T>(shift + std::abs(a[jj + static_cast<size_t>(jj) * n]));
+    }
+    return a;
+}
+
+} // namespace bench
+} // namespace container
+
+#endif // CONTAINER_BENCHMARK_BENCH_UTILS_H
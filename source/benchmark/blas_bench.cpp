@@ -0,0 +1,164 @@
+#include "bench_utils.h"
+#include "../profiler.h"
+#include "../kernels/blas_op.h"
+
+#include <chrono>
+#include <vector>
+#include <complex>
+
+namespace container {
+namespace bench {
+
+namespace {
+
+// Vector lengths from 1 Ki to 16 Mi. BLAS may be threaded, all the benchmarks use the wall clock.
+void vector_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+}
+
+// Matrix orders from 8 to 512.
+void matrix_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(8, 512)->UseRealTime();
+}
+
+// The real type of T, the template parameter of the BLAS functors.
+template <typename T>
+struct real_type {
+    typedef T type;
+};
+
+template <typename T>
+struct real_type<std::complex<T>> {
+    typedef T type;
+};
+
+template <typename T>
+void BM_scal_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    const int n = static_cast<int>(state.range(0));
+    std::vector<T> x(n);
+    fill(x.data(), n);
+    const T alpha = static_cast<T>(1.0);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::scal_op<R, DEVICE_CPU>()(n, &alpha, x.data(), 1);
+        benchmark::ClobberMemory();
+    }
+    report_bandwidth(state, 2.0 * sizeof(T) * n, seconds_since(start));
+}
+
+template <typename T>
+void BM_axpy_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    const int n = static_cast<int>(state.range(0));
+    std::vector<T> x(n), y(n);
+    fill(x.data(), n, 0.0);
+    fill(y.data(), n, 1.0);
+    const T alpha = static_cast<T>(1e-3);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::axpy_op<R, DEVICE_CPU>()(n, &alpha, x.data(), 1, y.data(), 1);
+        benchmark::ClobberMemory();
+    }
+    report_bandwidth(state, 3.0 * sizeof(T) * n, seconds_since(start));
+}
+
+template <typename T>
+void BM_gemv_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    const int n = static_cast<int>(state.range(0));
+    std::vector<T> a(static_cast<size_t>(n) * n), x(n), y(n);
+    fill(a.data(), static_cast<int64_t>(a.size()));
+    fill(x.data(), n, 1.0);
+    const T alpha = static_cast<T>(1.0), beta = static_cast<T>(0.0);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::gemv_op<R, DEVICE_CPU>()('N', n, n, &alpha, a.data(), n, x.data(), 1, &beta, y.data(), 1);
+        benchmark::ClobberMemory();
+    }
+    report_flops(state, FlopFactor<T>::value() * 2.0 * n * n, seconds_since(start));
+}
+
+template <typename T>
+void BM_gemm_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    const int n = static_cast<int>(state.range(0));
+    std::vector<T> a(static_cast<size_t>(n) * n), b(a.size()), c(a.size());
+    fill(a.data(), static_cast<int64_t>(a.size()), 0.0);
+    fill(b.data(), static_cast<int64_t>(b.size()), 1.0);
+    const T alpha = static_cast<T>(1.0), beta = static_cast<T>(0.0);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::gemm_op<R, DEVICE_CPU>()('N', 'N', n, n, n, &alpha, a.data(), n, b.data(), n, &beta, c.data(), n);
+        benchmark::ClobberMemory();
+    }
+    report_flops(state, FlopFactor<T>::value() * 2.0 * n * n * n, seconds_since(start));
+}
+
+// Small products with the built-in kernel (threshold = n) and with BLAS (threshold = 0),
+// to tune set_small_gemm_threshold.
+template <typename T>
+void BM_gemm_op_small_vs_blas(benchmark::State& state) {
+    const int threshold = op::get_small_gemm_threshold();
+    op::set_small_gemm_threshold(state.range(1) != 0 ? static_cast<int>(state.range(0)) : 0);
+    BM_gemm_op<T>(state);
+    op::set_small_gemm_threshold(threshold);
+}
+
+template <typename T>
+void BM_trsm_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    const int n = static_cast<int>(state.range(0));
+    // A diagonally dominant factor. The solution is overwritten every iteration, alpha about
+    // the diagonal keeps its magnitude from decaying into denormals.
+    const std::vector<T> a = hermitian_matrix<T>(n, n);
+    std::vector<T> b(a.size());
+    fill(b.data(), static_cast<int64_t>(b.size()), 1.0);
+    const T alpha = static_cast<T>(n + 0.5);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::trsm_op<R, DEVICE_CPU>()('L', 'L', 'N', 'N', n, n, &alpha, a.data(), n, b.data(), n);
+        benchmark::ClobberMemory();
+    }
+    report_flops(state, FlopFactor<T>::value() * static_cast<double>(n) * n * n, seconds_since(start));
+}
+
+void small_gemm_sizes(benchmark::internal::Benchmark* b) {
+    for (int n : {2, 4, 8, 16, 32, 64}) {
+        b->Args({n, 1})->Args({n, 0});
+    }
+    b->ArgNames({"n", "small"})->UseRealTime();
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_scal_op, float)->Apply(vector_sizes);
+BENCHMARK_TEMPLATE(BM_scal_op, double)->Apply(vector_sizes);
+BENCHMARK_TEMPLATE(BM_scal_op, std::complex<float>)->Apply(vector_sizes);
+BENCHMARK_TEMPLATE(BM_scal_op, std::complex<double>)->Apply(vector_sizes);
+
+BENCHMARK_TEMPLATE(BM_axpy_op, float)->Apply(vector_sizes);
+BENCHMARK_TEMPLATE(BM_axpy_op, double)->Apply(vector_sizes);
+BENCHMARK_TEMPLATE(BM_axpy_op, std::complex<float>)->Apply(vector_sizes);
+BENCHMARK_TEMPLATE(BM_axpy_op, std::complex<double>)->Apply(vector_sizes);
+
+BENCHMARK_TEMPLATE(BM_gemv_op, float)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_gemv_op, double)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_gemv_op, std::complex<float>)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_gemv_op, std::complex<double>)->Apply(matrix_sizes);
+
+BENCHMARK_TEMPLATE(BM_gemm_op, float)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_gemm_op, double)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_gemm_op, std::complex<float>)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_gemm_op, std::complex<double>)->Apply(matrix_sizes);
+
+BENCHMARK_TEMPLATE(BM_gemm_op_small_vs_blas, double)->Apply(small_gemm_sizes);
+BENCHMARK_TEMPLATE(BM_gemm_op_small_vs_blas, std::complex<double>)->Apply(small_gemm_sizes);
+
+BENCHMARK_TEMPLATE(BM_trsm_op, float)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_trsm_op, double)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_trsm_op, std::complex<float>)->Apply(matrix_sizes);
+BENCHMARK_TEMPLATE(BM_trsm_op, std::complex<double>)->Apply(matrix_sizes);
+
+} // namespace bench
+} // namespace container
@@ -0,0 +1,206 @@
+#include "bench_utils.h"
+#include "../profiler.h"
+#include "../kernels/lapack_op.h"
+
+#include <chrono>
+#include <vector>
+#include <complex>
+
+namespace container {
+namespace bench {
+
+namespace {
+
+// Matrix orders from 16 to 512, subspace sizes of plane-wave calculations. LAPACK may be threaded
+// and the batched solver runs on the thread pool, so the benchmarks use the wall clock.
+void eigen_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(2)->Range(16, 512)->UseRealTime();
+}
+
+template <typename T>
+struct real_type {
+    typedef T type;
+};
+
+template <typename T>
+struct real_type<std::complex<T>> {
+    typedef T type;
+};
+
+// A generalized eigenproblem H x = lambda S x, S is diagonally dominant and so positive definite.
+template <typename T>
+struct EigenProblem {
+    explicit EigenProblem(const int& n)
+        : n(n), h(hermitian_matrix<T>(n, 1.0, 0.0)), s(hermitian_matrix<T>(n, 2.0 * n, 1.0)),
+          v(h.size()), eigenvalues(n) {}
+
+    int n;
+    std::vector<T> h;
+    std::vector<T> s;
+    std::vector<T> v;
+    std::vector<typename real_type<T>::type> eigenvalues;
+};
+
+// The eigensolvers report their rate as problems solved per second, their flop count depends on the data.
+void report_matrices(benchmark::State& state, const double& per_iteration = 1.0) {
+    state.counters["matrices/s"] = benchmark::Counter(per_iteration * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+template <typename T>
+void BM_potrf_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    double seconds = 0.0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        p.v = p.s;
+        state.ResumeTiming();
+        const auto start = std::chrono::steady_clock::now();
+        op::potrf_op<R, DEVICE_CPU>()('L', p.n, p.v.data(), p.n);
+        seconds += seconds_since(start);
+    }
+    report_flops(state, FlopFactor<T>::value() * p.n * p.n * p.n / 3.0, seconds);
+}
+
+template <typename T>
+void BM_hegst_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    std::vector<T> l = p.s;
+    op::potrf_op<R, DEVICE_CPU>()('L', p.n, l.data(), p.n);
+    double seconds = 0.0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        p.v = p.h;
+        state.ResumeTiming();
+        const auto start = std::chrono::steady_clock::now();
+        op::hegst_op<R, DEVICE_CPU>()(1, 'L', p.n, p.v.data(), p.n, l.data(), p.n);
+        seconds += seconds_since(start);
+    }
+    report_flops(state, FlopFactor<T>::value() * p.n * p.n * p.n, seconds);
+}
+
+template <typename T>
+void BM_dngvd_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    // S is overwritten by its Cholesky factor.
+    std::vector<T> s(p.s.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        s = p.s;
+        state.ResumeTiming();
+        op::dngvd_op<R, DEVICE_CPU>()(p.n, p.n, p.h.data(), s.data(), p.eigenvalues.data(), p.v.data());
+    }
+    report_matrices(state);
+}
+
+template <typename T>
+void BM_dngvd_inplace_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    std::vector<T> s(p.s.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        p.v = p.h;
+        s = p.s;
+        state.ResumeTiming();
+        op::dngvd_inplace_op<R, DEVICE_CPU>()(p.n, p.n, p.v.data(), s.data(), p.eigenvalues.data());
+    }
+    report_matrices(state);
+}
+
+template <typename T>
+void BM_dngvd_factored_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    std::vector<T> l = p.s;
+    op::potrf_op<R, DEVICE_CPU>()('L', p.n, l.data(), p.n);
+    for (auto _ : state) {
+        op::dngvd_factored_op<R, DEVICE_CPU>()(p.n, p.n, p.h.data(), l.data(), p.eigenvalues.data(), p.v.data());
+    }
+    report_matrices(state);
+}
+
+template <typename T>
+void BM_dngvd_mixed_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    std::vector<T> s(p.s.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        s = p.s;
+        state.ResumeTiming();
+        op::dngvd_mixed_op<R, DEVICE_CPU>()(p.n, p.n, p.h.data(), s.data(), p.eigenvalues.data(), p.v.data());
+    }
+    report_matrices(state);
+}
+
+// A batch of 8 independent problems of the same order.
+template <typename T>
+void BM_dngvd_batched_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    const int batch = 8;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    std::vector<T> h, s0, v(batch * p.h.size());
+    std::vector<R> eigenvalues(batch * p.n);
+    for (int ii = 0; ii < batch; ii++) {
+        h.insert(h.end(), p.h.begin(), p.h.end());
+        s0.insert(s0.end(), p.s.begin(), p.s.end());
+    }
+    std::vector<T> s(s0.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        s = s0;
+        state.ResumeTiming();
+        op::dngvd_batched_op<R, DEVICE_CPU>()(batch, p.n, p.n, h.data(), s.data(), eigenvalues.data(), v.data());
+    }
+    report_matrices(state, batch);
+}
+
+// The lowest quarter of the spectrum, as in a band structure calculation.
+template <typename T>
+void BM_dnevx_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        op::dnevx_op<R, DEVICE_CPU>()(p.n, p.n, p.h.data(), p.n / 4, p.eigenvalues.data(), p.v.data());
+    }
+    report_matrices(state);
+}
+
+template <typename T>
+void BM_dnevr_op(benchmark::State& state) {
+    typedef typename real_type<T>::type R;
+    EigenProblem<T> p(static_cast<int>(state.range(0)));
+    int found = 0;
+    for (auto _ : state) {
+        op::dnevr_op<R, DEVICE_CPU>()('V', 'I', p.n, p.n, p.h.data(), R(0), R(0), 1, p.n / 4, found,
+                                      p.eigenvalues.data(), p.v.data());
+    }
+    report_matrices(state);
+}
+
+} // namespace
+
+#define CONTAINER_EIGEN_BENCHMARK(NAME)                                      \
+    BENCHMARK_TEMPLATE(NAME, float)->Apply(eigen_sizes);                     \
+    BENCHMARK_TEMPLATE(NAME, double)->Apply(eigen_sizes);                    \
+    BENCHMARK_TEMPLATE(NAME, std::complex<float>)->Apply(eigen_sizes);       \
+    BENCHMARK_TEMPLATE(NAME, std::complex<double>)->Apply(eigen_sizes)
+
+CONTAINER_EIGEN_BENCHMARK(BM_potrf_op);
+CONTAINER_EIGEN_BENCHMARK(BM_hegst_op);
+CONTAINER_EIGEN_BENCHMARK(BM_dngvd_op);
+CONTAINER_EIGEN_BENCHMARK(BM_dngvd_inplace_op);
+CONTAINER_EIGEN_BENCHMARK(BM_dngvd_factored_op);
+CONTAINER_EIGEN_BENCHMARK(BM_dngvd_batched_op);
+CONTAINER_EIGEN_BENCHMARK(BM_dnevx_op);
+CONTAINER_EIGEN_BENCHMARK(BM_dnevr_op);
+
+// The mixed precision solver is only instantiated for double.
+BENCHMARK_TEMPLATE(BM_dngvd_mixed_op, double)->Apply(eigen_sizes);
+BENCHMARK_TEMPLATE(BM_dngvd_mixed_op, std::complex<double>)->Apply(eigen_sizes);
+
+} // namespace bench
+} // namespace container
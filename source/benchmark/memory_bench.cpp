@@ -0,0 +1,109 @@
+#include "bench_utils.h"
+#include "../tensor.h"
+#include "../kernels/memory_op.h"
+
+#include <chrono>
+#include <vector>
+#include <complex>
+
+namespace container {
+namespace bench {
+
+namespace {
+
+// Element counts from 1 Ki to 16 Mi, from the L1 cache to main memory. The ops run on the
+// thread pool, so the benchmarks are timed by the wall clock rather than the CPU time of the main thread.
+void memory_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(1 << 10, 1 << 24)->UseRealTime();
+}
+
+template <typename T>
+void BM_set_memory_op(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    std::vector<T> x(n);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::set_memory_op<T, DEVICE_CPU>()(x.data(), 0, n);
+        benchmark::ClobberMemory();
+    }
+    report_bandwidth(state, static_cast<double>(sizeof(T)) * n, seconds_since(start));
+}
+
+template <typename T>
+void BM_synchronize_memory_op(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    std::vector<T> x(n), y(n);
+    fill(x.data(), n);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::synchronize_memory_op<T, DEVICE_CPU, DEVICE_CPU>()(y.data(), x.data(), n);
+        benchmark::ClobberMemory();
+    }
+    report_bandwidth(state, 2.0 * sizeof(T) * n, seconds_since(start));
+}
+
+template <typename T_out, typename T_in>
+void BM_cast_memory_op(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    std::vector<T_in> x(n);
+    std::vector<T_out> y(n);
+    fill(x.data(), n);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        op::cast_memory_op<T_out, T_in, DEVICE_CPU, DEVICE_CPU>()(y.data(), x.data(), n);
+        benchmark::ClobberMemory();
+    }
+    report_bandwidth(state, static_cast<double>(sizeof(T_in) + sizeof(T_out)) * n, seconds_since(start));
+}
+
+template <typename T>
+void BM_tensor_copy(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    Tensor t(DataTypeToEnum<T>::value, {n});
+    fill(t.data<T>(), n);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        Tensor copy(t);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    report_bandwidth(state, 2.0 * sizeof(T) * n, seconds_since(start));
+}
+
+// The central block of a square matrix, half the rows and half the columns.
+template <typename T>
+void BM_tensor_slice(benchmark::State& state) {
+    const int64_t n = state.range(0);
+    Tensor t(DataTypeToEnum<T>::value, {n, n});
+    fill(t.data<T>(), n * n);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        Tensor block = t.slice({n / 4, n / 4}, {n / 2, n / 2});
+        benchmark::DoNotOptimize(block.data());
+    }
+    report_bandwidth(state, 2.0 * sizeof(T) * (n / 2) * (n / 2), seconds_since(start));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_set_memory_op, float)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_set_memory_op, double)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_set_memory_op, std::complex<double>)->Apply(memory_sizes);
+
+BENCHMARK_TEMPLATE(BM_synchronize_memory_op, float)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_synchronize_memory_op, double)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_synchronize_memory_op, std::complex<float>)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_synchronize_memory_op, std::complex<double>)->Apply(memory_sizes);
+
+BENCHMARK_TEMPLATE(BM_cast_memory_op, float, double)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_cast_memory_op, double, float)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_cast_memory_op, std::complex<float>, std::complex<double>)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_cast_memory_op, std::complex<double>, std::complex<float>)->Apply(memory_sizes);
+
+BENCHMARK_TEMPLATE(BM_tensor_copy, double)->Apply(memory_sizes);
+BENCHMARK_TEMPLATE(BM_tensor_copy, std::complex<double>)->Apply(memory_sizes);
+
+BENCHMARK_TEMPLATE(BM_tensor_slice, double)->RangeMultiplier(4)->Range(64, 4096)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_tensor_slice, std::complex<double>)->RangeMultiplier(4)->Range(64, 4096)->UseRealTime();
+
+} // namespace bench
+} // namespace container
@@ -0,0 +1,69 @@
+#include "cpu_stream.h"
+
+#include <chrono>
+
+namespace container {
+
+CpuEvent::CpuEvent(std::shared_future<void> done) : done_(std::move(done)) {}
+
+bool CpuEvent::query() const {
+    return !done_.valid() || done_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void CpuEvent::synchronize() const {
+    if (done_.valid()) {
+        done_.wait();
+    }
+}
+
+CpuStream::CpuStream() : thread_(&CpuStream::loop, this) {}
+
+CpuStream::~CpuStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void CpuStream::push(std::function<void()> work) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(work));
+    }
+    wake_.notify_one();
+}
+
+void CpuStream::loop() {
+    while (true) {
+        std::function<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            work = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        work();
+    }
+}
+
+CpuEvent CpuStream::record() {
+    return CpuEvent(enqueue([]() {}).share());
+}
+
+void CpuStream::wait(const CpuEvent& event) {
+    if (event.query()) {
+        return;
+    }
+    push([event]() { event.synchronize(); });
+}
+
+void CpuStream::synchronize() {
+    record().synchronize();
+}
+
+} // namespace container
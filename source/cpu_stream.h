@@ -0,0 +1,121 @@
+#ifndef CONTAINER_CPU_STREAM_H
+#define CONTAINER_CPU_STREAM_H
+
+#include <mutex>
+#include <deque>
+#include <future>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+namespace container {
+
+/**
+ * @brief A point in the work of a CpuStream, complete when all the work enqueued before it is done.
+ *
+ * Events are cheap to copy, all the copies refer to the same point.
+ */
+class CpuEvent {
+  public:
+    /**
+     * @brief Construct an event that is already complete.
+     */
+    CpuEvent() = default;
+
+    /**
+     * @brief Whether the work before the event is done, without blocking.
+     */
+    bool query() const;
+
+    /**
+     * @brief Block the calling thread until the work before the event is done.
+     */
+    void synchronize() const;
+
+  private:
+    friend class CpuStream;
+    explicit CpuEvent(std::shared_future<void> done);
+
+    std::shared_future<void> done_;
+};
+
+/**
+ * @brief An in-order queue of CPU work, run asynchronously by a thread of its own.
+ *
+ * The work of one stream runs in the order of submission, the work of different streams runs
+ * concurrently, e.g. H|psi> of one band block on a stream while another block is orthogonalized
+ * on a second one. Dependencies between streams are expressed with events:
+ *
+ *     CpuStream s1, s2;
+ *     s1.enqueue(gemm_op<double, DEVICE_CPU>(), 'N', 'N', m, n, k, &one, a, m, b, k, &zero, c, m);
+ *     s2.wait(s1.record());   // later work of s2 starts after the gemm
+ *     auto norm = s2.enqueue(compute_norm, c);
+ *     norm.get();
+ *
+ * Ops run on a stream use the shared thread pool for their loops like any other caller. The
+ * arguments are copied into the queue, the data behind pointer arguments must stay valid until
+ * the work is done.
+ */
+class CpuStream {
+  public:
+    /**
+     * @brief Start the thread of the stream.
+     */
+    CpuStream();
+
+    /**
+     * @brief Finish all the enqueued work and stop the thread.
+     */
+    ~CpuStream();
+
+    CpuStream(const CpuStream&) = delete;
+    CpuStream& operator=(const CpuStream&) = delete;
+
+    /**
+     * @brief Enqueue f(args...), e.g. an op functor and its arguments.
+     *
+     * @return A future holding the result of f, or the exception it threw. An exception does
+     *         not stop the stream, the later work still runs.
+     */
+    template <typename F, typename... Args>
+    std::future<typename std::result_of<typename std::decay<F>::type&(typename std::decay<Args>::type&...)>::type>
+    enqueue(F&& f, Args&&... args) {
+        using R = typename std::result_of<typename std::decay<F>::type&(typename std::decay<Args>::type&...)>::type;
+        auto task = std::make_shared<std::packaged_task<R()>>(
+                std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<R> result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+    /**
+     * @brief Record an event after the work enqueued so far.
+     */
+    CpuEvent record();
+
+    /**
+     * @brief Make the work enqueued from now on wait for an event, e.g. of another stream.
+     */
+    void wait(const CpuEvent& event);
+
+    /**
+     * @brief Block the calling thread until all the enqueued work is done.
+     */
+    void synchronize();
+
+  private:
+    void push(std::function<void()> work);
+    void loop();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::function<void()>> queue_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // namespace container
+
+#endif // CONTAINER_CPU_STREAM_H
@@ -0,0 +1,443 @@
+#ifndef CONTAINER_FIXED_TENSOR_H
+#define CONTAINER_FIXED_TENSOR_H
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+#include "tensor.h"
+#include "tensor_types.h"
+
+namespace container {
+
+namespace fixed {
+
+/**
+ * @brief Compile-time shape information of a FixedTensor.
+ */
+template <int... Dims>
+struct Shape;
+
+template <>
+struct Shape<> {
+    static constexpr int rank = 0;
+    static constexpr int size = 1;
+};
+
+template <int D, int... Rest>
+struct Shape<D, Rest...> {
+    static_assert(D > 0, "FixedTensor dimensions must be positive.");
+    static constexpr int rank = 1 + Shape<Rest...>::rank;
+    static constexpr int size = D * Shape<Rest...>::size;
+};
+
+/**
+ * @brief Compile-time unrolled loop, calls f(0), f(1), ..., f(N - 1).
+ */
+template <int N>
+struct Unroll {
+    template <typename F>
+    static inline void apply(F& f) {
+        Unroll<N - 1>::apply(f);
+        f(N - 1);
+    }
+};
+
+template <>
+struct Unroll<0> {
+    template <typename F>
+    static inline void apply(F&) {}
+};
+
+// Row-major offset of the given indices.
+template <int... Dims>
+struct Offset;
+
+template <>
+struct Offset<> {
+    static constexpr int get() { return 0; }
+};
+
+template <int D, int... Rest>
+struct Offset<D, Rest...> {
+    template <typename... Index>
+    static constexpr int get(const int& i, const Index&... rest) {
+        return i * Shape<Rest...>::size + Offset<Rest...>::get(rest...);
+    }
+};
+
+} // namespace fixed
+
+/**
+ * @brief A small dense tensor with a compile-time shape and stack storage.
+ *
+ * FixedTensor is meant for the many 3-vector and 3x3 quantities (lattice vectors, forces,
+ * stress) for which the heap allocation and the dynamic shape of a Tensor cost far more than
+ * the arithmetic. All element-wise operations are unrolled at compile time.
+ *
+ * The data is stored row-major, in the same layout as a Tensor of the same shape, so a
+ * FixedTensor can be viewed as a Tensor (see `view`) and a CPU Tensor of the matching
+ * data type and shape can be viewed as a FixedTensor (see `map`) without copies.
+ *
+ * @tparam T The element type, one of the types supported by Tensor.
+ * @tparam Dims The dimensions of the tensor.
+ */
+template <typename T, int... Dims>
+class FixedTensor {
+  public:
+    static_assert(sizeof...(Dims) > 0, "FixedTensor must have at least one dimension.");
+
+    /// The number of dimensions.
+    static constexpr int rank = fixed::Shape<Dims...>::rank;
+    /// The total number of elements.
+    static constexpr int size = fixed::Shape<Dims...>::size;
+
+    /**
+     * @brief Construct a FixedTensor with all the elements set to the given value.
+     */
+    explicit FixedTensor(const T& value = T(0)) {
+        auto f = [&](const int& i) { data_[i] = value; };
+        fixed::Unroll<size>::apply(f);
+    }
+
+    /**
+     * @brief Construct a FixedTensor from its elements in row-major order.
+     *
+     * @note Missing trailing elements are set to zero.
+     */
+    FixedTensor(std::initializer_list<T> values) {
+        int i = 0;
+        for (auto it = values.begin(); it != values.end() && i < size; ++it) {
+            data_[i++] = *it;
+        }
+        for (; i < size; i++) {
+            data_[i] = T(0);
+        }
+    }
+
+    /**
+     * @brief Get the shape of the tensor as a TensorShape.
+     */
+    static TensorShape shape() {
+        return TensorShape({Dims...});
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    /// @brief Access an element by its flat (row-major) index.
+    T& operator[](const int& i) { return data_[i]; }
+    const T& operator[](const int& i) const { return data_[i]; }
+
+    /// @brief Access an element by its indices, one for each dimension.
+    template <typename... Index>
+    T& operator()(const Index&... index) {
+        static_assert(sizeof...(Index) == sizeof...(Dims), "The number of indices must match the rank.");
+        return data_[fixed::Offset<Dims...>::get(index...)];
+    }
+
+    template <typename... Index>
+    const T& operator()(const Index&... index) const {
+        static_assert(sizeof...(Index) == sizeof...(Dims), "The number of indices must match the rank.");
+        return data_[fixed::Offset<Dims...>::get(index...)];
+    }
+
+    /**
+     * @brief Get a Tensor that shares the memory of this FixedTensor.
+     *
+     * @note The returned Tensor does not own memory and must not outlive this object.
+     */
+    Tensor view() {
+        return Tensor(data_, DataTypeToEnum<T>::value, DeviceType::CpuDevice, shape());
+    }
+
+    /**
+     * @brief Reinterpret the data of a Tensor as a FixedTensor, without copies.
+     *
+     * @param tensor A CPU tensor with the same data type and shape.
+     *
+     * @return A reference to the data of the tensor.
+     *
+     * @throw std::invalid_argument if the data type, device type or shape do not match.
+     */
+    static FixedTensor& map(Tensor& tensor) {
+        check_mappable(tensor);
+        return *reinterpret_cast<FixedTensor*>(tensor.data<T>());
+    }
+
+    static const FixedTensor& map(const Tensor& tensor) {
+        check_mappable(tensor);
+        return *reinterpret_cast<const FixedTensor*>(tensor.data<T>());
+    }
+
+    FixedTensor& operator+=(const FixedTensor& other) {
+        auto f = [&](const int& i) { data_[i] += other.data_[i]; };
+        fixed::Unroll<size>::apply(f);
+        return *this;
+    }
+
+    FixedTensor& operator-=(const FixedTensor& other) {
+        auto f = [&](const int& i) { data_[i] -= other.data_[i]; };
+        fixed::Unroll<size>::apply(f);
+        return *this;
+    }
+
+    FixedTensor& operator*=(const T& alpha) {
+        auto f = [&](const int& i) { data_[i] *= alpha; };
+        fixed::Unroll<size>::apply(f);
+        return *this;
+    }
+
+    FixedTensor& operator/=(const T& alpha) {
+        auto f = [&](const int& i) { data_[i] /= alpha; };
+        fixed::Unroll<size>::apply(f);
+        return *this;
+    }
+
+    FixedTensor operator-() const {
+        FixedTensor result;
+        auto f = [&](const int& i) { result.data_[i] = -data_[i]; };
+        fixed::Unroll<size>::apply(f);
+        return result;
+    }
+
+    bool operator==(const FixedTensor& other) const {
+        bool equal = true;
+        auto f = [&](const int& i) { equal = equal && data_[i] == other.data_[i]; };
+        fixed::Unroll<size>::apply(f);
+        return equal;
+    }
+
+    bool operator!=(const FixedTensor& other) const {
+        return !(*this == other);
+    }
+
+  private:
+    static void check_mappable(const Tensor& tensor) {
+        if (tensor.data_type() != DataTypeToEnum<T>::value) {
+            throw std::invalid_argument("FixedTensor::map: the data type of the tensor does not match.");
+        }
+        if (tensor.device_type() != DeviceType::CpuDevice) {
+            throw std::invalid_argument("FixedTensor::map: only CPU tensors can be mapped.");
+        }
+        if (tensor.shape() != shape()) {
+            throw std::invalid_argument("FixedTensor::map: the shape of the tensor does not match.");
+        }
+    }
+
+    T data_[size];
+};
+
+template <typename T, int... Dims>
+FixedTensor<T, Dims...> operator+(FixedTensor<T, Dims...> a, const FixedTensor<T, Dims...>& b) {
+    return a += b;
+}
+
+template <typename T, int... Dims>
+FixedTensor<T, Dims...> operator-(FixedTensor<T, Dims...> a, const FixedTensor<T, Dims...>& b) {
+    return a -= b;
+}
+
+template <typename T, int... Dims>
+FixedTensor<T, Dims...> operator*(FixedTensor<T, Dims...> a, const T& alpha) {
+    return a *= alpha;
+}
+
+template <typename T, int... Dims>
+FixedTensor<T, Dims...> operator*(const T& alpha, FixedTensor<T, Dims...> a) {
+    return a *= alpha;
+}
+
+template <typename T, int... Dims>
+FixedTensor<T, Dims...> operator/(FixedTensor<T, Dims...> a, const T& alpha) {
+    return a /= alpha;
+}
+
+/**
+ * @brief Matrix product of two fixed-size matrices, c = a * b.
+ */
+template <typename T, int M, int K, int N>
+FixedTensor<T, M, N> matmul(const FixedTensor<T, M, K>& a, const FixedTensor<T, K, N>& b) {
+    FixedTensor<T, M, N> c;
+    auto f = [&](const int& ij) {
+        const int i = ij / N, j = ij % N;
+        T sum = T(0);
+        auto g = [&](const int& l) { sum += a(i, l) * b(l, j); };
+        fixed::Unroll<K>::apply(g);
+        c[ij] = sum;
+    };
+    fixed::Unroll<M * N>::apply(f);
+    return c;
+}
+
+/**
+ * @brief Matrix-vector product of a fixed-size matrix and vector, y = a * x.
+ */
+template <typename T, int M, int K>
+FixedTensor<T, M> matmul(const FixedTensor<T, M, K>& a, const FixedTensor<T, K>& x) {
+    FixedTensor<T, M> y;
+    auto f = [&](const int& i) {
+        T sum = T(0);
+        auto g = [&](const int& l) { sum += a(i, l) * x[l]; };
+        fixed::Unroll<K>::apply(g);
+        y[i] = sum;
+    };
+    fixed::Unroll<M>::apply(f);
+    return y;
+}
+
+/**
+ * @brief Transpose of a fixed-size matrix.
+ */
+template <typename T, int M, int N>
+FixedTensor<T, N, M> transpose(const FixedTensor<T, M, N>& a) {
+    FixedTensor<T, N, M> t;
+    auto f = [&](const int& ij) { t(ij % N, ij / N) = a[ij]; };
+    fixed::Unroll<M * N>::apply(f);
+    return t;
+}
+
+/**
+ * @brief Dot product of two fixed-size vectors, without conjugation.
+ */
+template <typename T, int N>
+T dot(const FixedTensor<T, N>& a, const FixedTensor<T, N>& b) {
+    T sum = T(0);
+    auto f = [&](const int& i) { sum += a[i] * b[i]; };
+    fixed::Unroll<N>::apply(f);
+    return sum;
+}
+
+/**
+ * @brief Cross product of two 3-vectors.
+ */
+template <typename T>
+FixedTensor<T, 3> cross(const FixedTensor<T, 3>& a, const FixedTensor<T, 3>& b) {
+    return FixedTensor<T, 3>({a[1] * b[2] - a[2] * b[1],
+                              a[2] * b[0] - a[0] * b[2],
+                              a[0] * b[1] - a[1] * b[0]});
+}
+
+/**
+ * @brief Determinant of a 2x2 matrix.
+ */
+template <typename T>
+T det(const FixedTensor<T, 2, 2>& a) {
+    return a[0] * a[3] - a[1] * a[2];
+}
+
+/**
+ * @brief Determinant of a 3x3 matrix, e.g. the cell volume from the lattice vectors.
+ */
+template <typename T>
+T det(const FixedTensor<T, 3, 3>& a) {
+    return a[0] * (a[4] * a[8] - a[5] * a[7])
+         - a[1] * (a[3] * a[8] - a[5] * a[6])
+         + a[2] * (a[3] * a[7] - a[4] * a[6]);
+}
+
+/**
+ * @brief Inverse of a 2x2 matrix.
+ *
+ * @throw std::invalid_argument if the matrix is singular.
+ */
+template <typename T>
+FixedTensor<T, 2, 2> inverse(const FixedTensor<T, 2, 2>& a) {
+    const T d = det(a);
+    if (d == T(0)) {
+        throw std::invalid_argument("inverse: the matrix is singular.");
+    }
+    return FixedTensor<T, 2, 2>({a[3], -a[1], -a[2], a[0]}) / d;
+}
+
+/**
+ * @brief Inverse of a 3x3 matrix through its adjugate, e.g. the reciprocal lattice.
+ *
+ * @throw std::invalid_argument if the matrix is singular.
+ */
+template <typename T>
+FixedTensor<T, 3, 3> inverse(const FixedTensor<T, 3, 3>& a) {
+    const T d = det(a);
+    if (d == T(0)) {
+        throw std::invalid_argument("inverse: the matrix is singular.");
+    }
+    return FixedTensor<T, 3, 3>({a[4] * a[8] - a[5] * a[7], a[2] * a[7] - a[1] * a[8], a[1] * a[5] - a[2] * a[4],
+                                 a[5] * a[6] - a[3] * a[8], a[0] * a[8] - a[2] * a[6], a[2] * a[3] - a[0] * a[5],
+                                 a[3] * a[7] - a[4] * a[6], a[1] * a[6] - a[0] * a[7], a[0] * a[4] - a[1] * a[3]}) / d;
+}
+
+/**
+ * @brief Eigen decomposition of a real symmetric 3x3 matrix, e.g. the stress tensor.
+ *
+ * Uses cyclic Jacobi rotations, which stay accurate for degenerate eigenvalues.
+ * Only the upper triangle of a is referenced.
+ *
+ * @param a The symmetric matrix.
+ * @param eigenvalues The eigenvalues in ascending order.
+ * @param eigenvectors The orthonormal eigenvectors, stored as columns (eigenvectors(:, i)
+ *        belongs to eigenvalues[i]), as returned by LAPACK.
+ */
+template <typename T>
+void eigh(const FixedTensor<T, 3, 3>& a, FixedTensor<T, 3>& eigenvalues, FixedTensor<T, 3, 3>& eigenvectors) {
+    static_assert(std::is_floating_point<T>::value, "eigh: only real symmetric matrices are supported.");
+    T m[3][3] = {{a(0, 0), a(0, 1), a(0, 2)},
+                 {a(0, 1), a(1, 1), a(1, 2)},
+                 {a(0, 2), a(1, 2), a(2, 2)}};
+    T v[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    const T scale = std::abs(m[0][0]) + std::abs(m[1][1]) + std::abs(m[2][2])
+                  + std::abs(m[0][1]) + std::abs(m[0][2]) + std::abs(m[1][2]);
+    for (int sweep = 0; sweep < 50; sweep++) {
+        const T off = std::abs(m[0][1]) + std::abs(m[0][2]) + std::abs(m[1][2]);
+        if (off <= std::numeric_limits<T>::epsilon() * scale * T(1e-2)) {
+            break;
+        }
+        for (int p = 0; p < 2; p++) {
+            for (int q = p + 1; q < 3; q++) {
+                if (m[p][q] == T(0)) {
+                    continue;
+                }
+                // Rotation that annihilates m[p][q], with the smaller of the two angles.
+                const T theta = (m[q][q] - m[p][p]) / (T(2) * m[p][q]);
+                const T t = (theta >= T(0) ? T(1) : T(-1)) / (std::abs(theta) + std::sqrt(theta * theta + T(1)));
+                const T c = T(1) / std::sqrt(t * t + T(1)), s = t * c;
+                for (int k = 0; k < 3; k++) {
+                    const T mkp = m[k][p], mkq = m[k][q];
+                    m[k][p] = c * mkp - s * mkq;
+                    m[k][q] = s * mkp + c * mkq;
+                }
+                for (int k = 0; k < 3; k++) {
+                    const T mpk = m[p][k], mqk = m[q][k];
+                    m[p][k] = c * mpk - s * mqk;
+                    m[q][k] = s * mpk + c * mqk;
+                }
+                for (int k = 0; k < 3; k++) {
+                    const T vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    // Sort in ascending order.
+    int order[3] = {0, 1, 2};
+    for (int i = 0; i < 2; i++) {
+        for (int j = i + 1; j < 3; j++) {
+            if (m[order[j]][order[j]] < m[order[i]][order[i]]) {
+                std::swap(order[i], order[j]);
+            }
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        eigenvalues[i] = m[order[i]][order[i]];
+        for (int k = 0; k < 3; k++) {
+            eigenvectors(k, i) = v[k][order[i]];
+        }
+    }
+}
+
+} // namespace container
+
+#endif // CONTAINER_FIXED_TENSOR_H
@@ -1,8 +1,32 @@
 #include "blas_op.h"
+#include "small_gemm.h"
+#include "../profiler.h"
+
+#include <algorithm>
+#include <atomic>
 
 namespace container {
 namespace op {
 
+namespace {
+
+std::atomic<int> small_gemm_threshold(small_gemm::kDefaultThreshold);
+
+inline bool use_small_gemm(const int& m, const int& n, const int& k) {
+    const int threshold = small_gemm_threshold.load(std::memory_order_relaxed);
+    return m > 0 && n > 0 && k > 0 && m <= threshold && n <= threshold && k <= threshold;
+}
+
+} // namespace
+
+void set_small_gemm_threshold(const int& threshold) {
+    small_gemm_threshold.store(std::max(0, std::min(threshold, small_gemm::kMaxDim)));
+}
+
+int get_small_gemm_threshold() {
+    return small_gemm_threshold.load();
+}
+
 //// CPU specialization of actual computation.
 //template <typename T>
 //struct zdot_real_op<T, DEVICE_CPU> {
@@ -34,6 +58,17 @@ struct scal_op<T, DEVICE_CPU> {
             std::complex<T> *X,
             const int &incx)
     {
+        ProfileScope profile("scal_op", profile_type(X), 2.0 * sizeof(*X) * N, profile_flops(X, N, FlopKind::Multiply));
+        BlasConnector::scal(N, *alpha, X, incx);
+    }
+
+    void operator()(
+            const int &N,
+            const T *alpha,
+            T *X,
+            const int &incx)
+    {
+        ProfileScope profile("scal_op", profile_type(X), 2.0 * sizeof(*X) * N, profile_flops(X, N, FlopKind::Multiply));
         BlasConnector::scal(N, *alpha, X, incx);
     }
 };
@@ -41,7 +76,6 @@ struct scal_op<T, DEVICE_CPU> {
 template <typename T>
 struct gemv_op<T, DEVICE_CPU> {
     void operator()(
-            const DEVICE_CPU *d,
             const char &trans,
             const int &m,
             const int &n,
@@ -54,6 +88,26 @@ struct gemv_op<T, DEVICE_CPU> {
             std::complex<T> *Y,
             const int &incy)
     {
+        ProfileScope profile("gemv_op", profile_type(A), sizeof(*A) * (static_cast<double>(m) * n + 2.0 * (m + n)),
+                             profile_flops(A, 2.0 * m * n));
+        BlasConnector::gemv(trans, m, n, *alpha, A, lda, X, incx, *beta, Y, incy);
+    }
+
+    void operator()(
+            const char &trans,
+            const int &m,
+            const int &n,
+            const T *alpha,
+            const T *A,
+            const int &lda,
+            const T *X,
+            const int &incx,
+            const T *beta,
+            T *Y,
+            const int &incy)
+    {
+        ProfileScope profile("gemv_op", profile_type(A), sizeof(*A) * (static_cast<double>(m) * n + 2.0 * (m + n)),
+                             profile_flops(A, 2.0 * m * n));
         BlasConnector::gemv(trans, m, n, *alpha, A, lda, X, incx, *beta, Y, incy);
     }
 };
@@ -61,7 +115,6 @@ struct gemv_op<T, DEVICE_CPU> {
 template <typename T>
 struct axpy_op<T, DEVICE_CPU> {
     void operator()(
-            const DEVICE_CPU * /*ctx*/,
             const int &dim,
             const std::complex<T> *alpha,
             const std::complex<T> *X,
@@ -69,6 +122,19 @@ struct axpy_op<T, DEVICE_CPU> {
             std::complex<T> *Y,
             const int &incY)
     {
+        ProfileScope profile("axpy_op", profile_type(X), 3.0 * sizeof(*X) * dim, profile_flops(X, 2.0 * dim));
+        BlasConnector::axpy(dim, *alpha, X, incX, Y, incY);
+    }
+
+    void operator()(
+            const int &dim,
+            const T *alpha,
+            const T *X,
+            const int &incX,
+            T *Y,
+            const int &incY)
+    {
+        ProfileScope profile("axpy_op", profile_type(X), 3.0 * sizeof(*X) * dim, profile_flops(X, 2.0 * dim));
         BlasConnector::axpy(dim, *alpha, X, incX, Y, incY);
     }
 };
@@ -76,7 +142,6 @@ struct axpy_op<T, DEVICE_CPU> {
 template <typename T>
 struct gemm_op<T, DEVICE_CPU> {
     void operator()(
-            const DEVICE_CPU * /*ctx*/,
             const char &transa,
             const char &transb,
             const int &m,
@@ -91,7 +156,81 @@ struct gemm_op<T, DEVICE_CPU> {
             std::complex<T> *c,
             const int &ldc)
     {
-        BlasConnector::gemm(transb, transa, n, m, k, *alpha, b, ldb, a, lda, *beta, c, ldc);
+        ProfileScope profile("gemm_op", profile_type(a),
+                             sizeof(*a) * (static_cast<double>(m) * k + static_cast<double>(k) * n + 2.0 * m * n),
+                             profile_flops(a, 2.0 * m * n * k));
+        if (use_small_gemm(m, n, k)) {
+            small_gemm::gemm(transa, transb, m, n, k, *alpha, a, lda, b, ldb, *beta, c, ldc);
+            return;
+        }
+        // gemm_op follows the column-major convention of cuBLAS, so call the fortran routine directly.
+        BlasConnector::gemm_cm(transa, transb, m, n, k, *alpha, a, lda, b, ldb, *beta, c, ldc);
+    }
+
+    void operator()(
+            const char &transa,
+            const char &transb,
+            const int &m,
+            const int &n,
+            const int &k,
+            const T *alpha,
+            const T *a,
+            const int &lda,
+            const T *b,
+            const int &ldb,
+            const T *beta,
+            T *c,
+            const int &ldc)
+    {
+        ProfileScope profile("gemm_op", profile_type(a),
+                             sizeof(*a) * (static_cast<double>(m) * k + static_cast<double>(k) * n + 2.0 * m * n),
+                             profile_flops(a, 2.0 * m * n * k));
+        if (use_small_gemm(m, n, k)) {
+            small_gemm::gemm(transa, transb, m, n, k, *alpha, a, lda, b, ldb, *beta, c, ldc);
+            return;
+        }
+        BlasConnector::gemm_cm(transa, transb, m, n, k, *alpha, a, lda, b, ldb, *beta, c, ldc);
+    }
+};
+
+template <typename T>
+struct trsm_op<T, DEVICE_CPU> {
+    void operator()(
+            const char &side,
+            const char &uplo,
+            const char &transa,
+            const char &diag,
+            const int &m,
+            const int &n,
+            const std::complex<T> *alpha,
+            const std::complex<T> *A,
+            const int &lda,
+            std::complex<T> *B,
+            const int &ldb)
+    {
+        const double order = side == 'L' || side == 'l' ? m : n;
+        ProfileScope profile("trsm_op", profile_type(A), sizeof(*A) * (0.5 * order * order + 2.0 * m * n),
+                             profile_flops(A, order * m * n));
+        BlasConnector::trsm(side, uplo, transa, diag, m, n, *alpha, A, lda, B, ldb);
+    }
+
+    void operator()(
+            const char &side,
+            const char &uplo,
+            const char &transa,
+            const char &diag,
+            const int &m,
+            const int &n,
+            const T *alpha,
+            const T *A,
+            const int &lda,
+            T *B,
+            const int &ldb)
+    {
+        const double order = side == 'L' || side == 'l' ? m : n;
+        ProfileScope profile("trsm_op", profile_type(A), sizeof(*A) * (0.5 * order * order + 2.0 * m * n),
+                             profile_flops(A, order * m * n));
+        BlasConnector::trsm(side, uplo, transa, diag, m, n, *alpha, A, lda, B, ldb);
     }
 };
 
@@ -100,11 +239,121 @@ template struct scal_op<float, DEVICE_CPU>;
 template struct axpy_op<float, DEVICE_CPU>;
 template struct gemv_op<float, DEVICE_CPU>;
 template struct gemm_op<float, DEVICE_CPU>;
+template struct trsm_op<float, DEVICE_CPU>;
 
 template struct scal_op<double, DEVICE_CPU>;
 template struct axpy_op<double, DEVICE_CPU>;
 template struct gemv_op<double, DEVICE_CPU>;
 template struct gemm_op<double, DEVICE_CPU>;
+template struct trsm_op<double, DEVICE_CPU>;
+
+#if !(defined(__CUDA) || defined(__ROCM))
+template <typename T>
+struct scal_op<T, DEVICE_GPU> {
+    void operator()(
+            const int &N,
+            const std::complex<T> *alpha,
+            std::complex<T> *X,
+            const int &incx) {}
+
+    void operator()(
+            const int &N,
+            const T *alpha,
+            T *X,
+            const int &incx) {}
+};
+
+template <typename T>
+struct axpy_op<T, DEVICE_GPU> {
+    void operator()(
+            const int &dim,
+            const std::complex<T> *alpha,
+            const std::complex<T> *X,
+            const int &incX,
+            std::complex<T> *Y,
+            const int &incY) {}
+
+    void operator()(
+            const int &dim,
+            const T *alpha,
+            const T *X,
+            const int &incX,
+            T *Y,
+            const int &incY) {}
+};
+
+template <typename T>
+struct gemv_op<T, DEVICE_GPU> {
+    void operator()(
+            const char &trans,
+            const int &m,
+            const int &n,
+            const std::complex<T> *alpha,
+            const std::complex<T> *A,
+            const int &lda,
+            const std::complex<T> *X,
+            const int &incx,
+            const std::complex<T> *beta,
+            std::complex<T> *Y,
+            const int &incy) {}
+
+    void operator()(
+            const char &trans,
+            const int &m,
+            const int &n,
+            const T *alpha,
+            const T *A,
+            const int &lda,
+            const T *X,
+            const int &incx,
+            const T *beta,
+            T *Y,
+            const int &incy) {}
+};
+
+template <typename T>
+struct gemm_op<T, DEVICE_GPU> {
+    void operator()(
+            const char &transa,
+            const char &transb,
+            const int &m,
+            const int &n,
+            const int &k,
+            const std::complex<T> *alpha,
+            const std::complex<T> *a,
+            const int &lda,
+            const std::complex<T> *b,
+            const int &ldb,
+            const std::complex<T> *beta,
+            std::complex<T> *c,
+            const int &ldc) {}
+
+    void operator()(
+            const char &transa,
+            const char &transb,
+            const int &m,
+            const int &n,
+            const int &k,
+            const T *alpha,
+            const T *a,
+            const int &lda,
+            const T *b,
+            const int &ldb,
+            const T *beta,
+            T *c,
+            const int &ldc) {}
+};
+
+template struct scal_op<float, DEVICE_GPU>;
+template struct axpy_op<float, DEVICE_GPU>;
+template struct gemv_op<float, DEVICE_GPU>;
+template struct gemm_op<float, DEVICE_GPU>;
+
+template struct scal_op<double, DEVICE_GPU>;
+template struct axpy_op<double, DEVICE_GPU>;
+template struct gemv_op<double, DEVICE_GPU>;
+template struct gemm_op<double, DEVICE_GPU>;
+#endif
 
 } // namespace op
 } // namespace container
\ No newline at end of file
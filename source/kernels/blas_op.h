@@ -76,6 +76,23 @@ namespace op {
 //            const bool reduce = true);
 //};
 
+/**
+ * @brief Set the size threshold of the small GEMM path of gemm_op on CPU.
+ *
+ * Products with m, n and k all not larger than the threshold are computed by register-blocked
+ * kernels instead of BLAS, whose argument checking and dispatch dominate for such sizes.
+ * The threshold is clamped to [0, 32], 0 disables the small GEMM path. The default is 8.
+ *
+ * @param threshold The largest dimension handled by the small GEMM kernels.
+ */
+void set_small_gemm_threshold(const int& threshold);
+
+/// @brief Get the size threshold of the small GEMM path of gemm_op on CPU.
+int get_small_gemm_threshold();
+
+// Note: T is the real type of the data. Every op accepts both the complex data (std::complex<T>)
+// and the real data (T), so that real tensors never need to be promoted to complex.
+
 // replace vector_div_constant_op : x = alpha * x
 template <typename T, typename DEVICE>
 struct scal_op {
@@ -94,6 +111,13 @@ struct scal_op {
             const std::complex<T>* alpha,
             std::complex<T>* X,
             const int& incx);
+
+    /// @brief x = alpha * x, real version.
+    void operator()(
+            const int& N,
+            const T* alpha,
+            T* X,
+            const int& incx);
 };
 
 //  compute Y = alpha * X + Y
@@ -118,6 +142,15 @@ struct axpy_op {
             const int& incX,
             std::complex<T>* Y,
             const int& incY);
+
+    /// @brief Y = alpha * X + Y, real version.
+    void operator()(
+            const int& N,
+            const T* alpha,
+            const T* X,
+            const int& incX,
+            T* Y,
+            const int& incY);
 };
 
 // compute y = alpha * op(A) * x + beta * y
@@ -152,6 +185,20 @@ struct gemv_op {
             const std::complex<T> *beta,
             std::complex<T> *Y,
             const int &incy);
+
+    /// @brief y = alpha * op(A) * x + beta * y, real version.
+    void operator()(
+            const char &trans,
+            const int &m,
+            const int &n,
+            const T *alpha,
+            const T *A,
+            const int &lda,
+            const T *X,
+            const int &incx,
+            const T *beta,
+            T *Y,
+            const int &incy);
 };
 
 // compute C = alpha * op(A) * op(B) + beta * C
@@ -190,6 +237,70 @@ struct gemm_op {
             const std::complex<T> *beta,
             std::complex<T> *c,
             const int& ldc);
+
+    /// @brief C = alpha * op(A) * op(B) + beta * C, real version.
+    void operator()(
+            const char& transa,
+            const char& transb,
+            const int& m,
+            const int& n,
+            const int& k,
+            const T *alpha,
+            const T *a,
+            const int& lda,
+            const T *b,
+            const int& ldb,
+            const T *beta,
+            T *c,
+            const int& ldc);
+};
+
+// solve op(A) * X = alpha * B or X * op(A) = alpha * B for a triangular A
+template <typename T, typename DEVICE>
+struct trsm_op {
+    /// @brief B = alpha * op(A)^-1 * B (side = 'L') or B = alpha * B * op(A)^-1 (side = 'R')
+    ///
+    /// Input Parameters
+    /// \param side : 'L' or 'R', the side of A
+    /// \param uplo : 'U' or 'L', whether A is upper or lower triangular
+    /// \param transa : 'N', 'T' or 'C' applied to A
+    /// \param diag : 'U' if A is unit triangular, 'N' otherwise
+    /// \param m : number of rows of B
+    /// \param n : number of columns of B
+    /// \param alpha : input constant alpha
+    /// \param A : input triangular matrix A
+    /// \param lda : leading dimention of A
+    /// \param B : input matrix B
+    /// \param ldb : leading dimention of B
+    ///
+    /// Output Parameters
+    /// \param B : the solution X
+    void operator()(
+            const char& side,
+            const char& uplo,
+            const char& transa,
+            const char& diag,
+            const int& m,
+            const int& n,
+            const std::complex<T> *alpha,
+            const std::complex<T> *A,
+            const int& lda,
+            std::complex<T> *B,
+            const int& ldb);
+
+    /// @brief Triangular solve, real version.
+    void operator()(
+            const char& side,
+            const char& uplo,
+            const char& transa,
+            const char& diag,
+            const int& m,
+            const int& n,
+            const T *alpha,
+            const T *A,
+            const int& lda,
+            T *B,
+            const int& ldb);
 };
 
 #if __CUDA || __UT_USE_CUDA || __ROCM || __UT_USE_ROCM
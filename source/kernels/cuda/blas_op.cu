@@ -15,6 +15,16 @@ static cublasHandle_t cublas_handle = nullptr;
 //     cublasErrcheck(cublasDdot(cublas_handle, n, x, incx, y, incy, &result));
 // }
 
+static inline
+void xscal_wrapper(const int &n, const float * alpha, float * X, const int &incx) {
+    cublasErrcheck(cublasSscal(cublas_handle, n, alpha, X, incx));
+}
+
+static inline
+void xscal_wrapper(const int &n, const double * alpha, double * X, const int &incx) {
+    cublasErrcheck(cublasDscal(cublas_handle, n, alpha, X, incx));
+}
+
 static inline
 void xscal_wrapper(const int &n, const std::complex<float> * alpha, std::complex<float> * X, const int &incx) {
     cublasErrcheck(cublasCscal(cublas_handle, n, (float2*)alpha, (float2*)X, incx));
@@ -25,6 +35,17 @@ void xscal_wrapper(const int &n, const std::complex<double> * alpha, std::comple
     cublasErrcheck(cublasZscal(cublas_handle, n, (double2*)alpha, (double2*)X, incx));
 }
 
+static inline
+cublasOperation_t judge_trans(const char &trans) {
+    if (trans == 'T') {
+        return CUBLAS_OP_T;
+    }
+    else if (trans == 'C') {
+        return CUBLAS_OP_C;
+    }
+    return CUBLAS_OP_N;
+}
+
 void createBlasHandle() {
     if (cublas_handle == nullptr) {
         cublasErrcheck(cublasCreate(&cublas_handle));
@@ -48,6 +69,15 @@ struct scal_op<T, DEVICE_GPU> {
     {
         xscal_wrapper(N, alpha, X, incx);
     }
+
+    void operator()(
+            const int &N,
+            const T *alpha,
+            T *X,
+            const int &incx)
+    {
+        xscal_wrapper(N, alpha, X, incx);
+    }
 };
 
 template <>
@@ -62,6 +92,17 @@ struct axpy_op<float, DEVICE_GPU> {
     {
         cublasErrcheck(cublasCaxpy(cublas_handle, N, (float2 *) alpha, (float2 *) X, incX, (float2 *) Y, incY));
     }
+
+    void operator()(
+            const int &N,
+            const float *alpha,
+            const float *X,
+            const int &incX,
+            float *Y,
+            const int &incY)
+    {
+        cublasErrcheck(cublasSaxpy(cublas_handle, N, alpha, X, incX, Y, incY));
+    }
 };
 
 template <>
@@ -76,6 +117,17 @@ struct axpy_op<double, DEVICE_GPU> {
     {
         cublasErrcheck(cublasZaxpy(cublas_handle, N, (double2 *) alpha, (double2 *) X, incX, (double2 *) Y, incY));
     }
+
+    void operator()(
+            const int &N,
+            const double *alpha,
+            const double *X,
+            const int &incX,
+            double *Y,
+            const int &incY)
+    {
+        cublasErrcheck(cublasDaxpy(cublas_handle, N, alpha, X, incX, Y, incY));
+    }
 };
 
 template <>
@@ -104,6 +156,22 @@ struct gemv_op<float, DEVICE_GPU> {
                 cublasCgemv(cublas_handle, cutrans, m, n, (float2 *) alpha, (float2 *) A, lda, (float2 *) X, incx,
                             (float2 *) beta, (float2 *) Y, incy));
     }
+
+    void operator()(
+            const char &trans,
+            const int &m,
+            const int &n,
+            const float *alpha,
+            const float *A,
+            const int &lda,
+            const float *X,
+            const int &incx,
+            const float *beta,
+            float *Y,
+            const int &incy)
+    {
+        cublasErrcheck(cublasSgemv(cublas_handle, judge_trans(trans), m, n, alpha, A, lda, X, incx, beta, Y, incy));
+    }
 };
 
 template <>
@@ -133,6 +201,22 @@ struct gemv_op<double, DEVICE_GPU> {
                 cublasZgemv(cublas_handle, cutrans, m, n, (double2 *) alpha, (double2 *) A, lda, (double2 *) X, incx,
                             (double2 *) beta, (double2 *) Y, incy));
     }
+
+    void operator()(
+            const char &trans,
+            const int &m,
+            const int &n,
+            const double *alpha,
+            const double *A,
+            const int &lda,
+            const double *X,
+            const int &incx,
+            const double *beta,
+            double *Y,
+            const int &incy)
+    {
+        cublasErrcheck(cublasDgemv(cublas_handle, judge_trans(trans), m, n, alpha, A, lda, X, incx, beta, Y, incy));
+    }
 };
 
 
@@ -174,6 +258,25 @@ struct gemm_op<float, DEVICE_GPU> {
         cublasErrcheck(cublasCgemm(cublas_handle, cutransA, cutransB, m, n, k, (float2 *) alpha, (float2 *) a, lda,
                                    (float2 *) b, ldb, (float2 *) beta, (float2 *) c, ldc));
     }
+
+    void operator()(
+            const char &transa,
+            const char &transb,
+            const int &m,
+            const int &n,
+            const int &k,
+            const float *alpha,
+            const float *a,
+            const int &lda,
+            const float *b,
+            const int &ldb,
+            const float *beta,
+            float *c,
+            const int &ldc)
+    {
+        cublasErrcheck(cublasSgemm(cublas_handle, judge_trans(transa), judge_trans(transb), m, n, k,
+                                   alpha, a, lda, b, ldb, beta, c, ldc));
+    }
 };
 
 template <>
@@ -217,6 +320,86 @@ struct gemm_op<double, DEVICE_GPU> {
         }
         cublasErrcheck(cublasZgemm(cublas_handle, cutransA, cutransB, m, n ,k, (double2*)alpha, (double2*)a , lda, (double2*)b, ldb, (double2*)beta, (double2*)c, ldc));
     }
+
+    void operator()(
+            const char& transa,
+            const char& transb,
+            const int& m,
+            const int& n,
+            const int& k,
+            const double *alpha,
+            const double *a,
+            const int& lda,
+            const double *b,
+            const int& ldb,
+            const double *beta,
+            double *c,
+            const int& ldc)
+    {
+        cublasErrcheck(cublasDgemm(cublas_handle, judge_trans(transa), judge_trans(transb), m, n, k,
+                                   alpha, a, lda, b, ldb, beta, c, ldc));
+    }
+};
+
+static inline
+cublasSideMode_t judge_side(const char &side) {
+    return side == 'R' ? CUBLAS_SIDE_RIGHT : CUBLAS_SIDE_LEFT;
+}
+
+static inline
+cublasFillMode_t judge_uplo(const char &uplo) {
+    return uplo == 'U' ? CUBLAS_FILL_MODE_UPPER : CUBLAS_FILL_MODE_LOWER;
+}
+
+static inline
+cublasDiagType_t judge_diag(const char &diag) {
+    return diag == 'U' ? CUBLAS_DIAG_UNIT : CUBLAS_DIAG_NON_UNIT;
+}
+
+template <>
+struct trsm_op<float, DEVICE_GPU> {
+    void operator()(
+            const char& side, const char& uplo, const char& transa, const char& diag,
+            const int& m, const int& n,
+            const std::complex<float> *alpha, const std::complex<float> *A, const int& lda,
+            std::complex<float> *B, const int& ldb)
+    {
+        cublasErrcheck(cublasCtrsm(cublas_handle, judge_side(side), judge_uplo(uplo), judge_trans(transa), judge_diag(diag),
+                                   m, n, (float2*)alpha, (float2*)A, lda, (float2*)B, ldb));
+    }
+
+    void operator()(
+            const char& side, const char& uplo, const char& transa, const char& diag,
+            const int& m, const int& n,
+            const float *alpha, const float *A, const int& lda,
+            float *B, const int& ldb)
+    {
+        cublasErrcheck(cublasStrsm(cublas_handle, judge_side(side), judge_uplo(uplo), judge_trans(transa), judge_diag(diag),
+                                   m, n, alpha, A, lda, B, ldb));
+    }
+};
+
+template <>
+struct trsm_op<double, DEVICE_GPU> {
+    void operator()(
+            const char& side, const char& uplo, const char& transa, const char& diag,
+            const int& m, const int& n,
+            const std::complex<double> *alpha, const std::complex<double> *A, const int& lda,
+            std::complex<double> *B, const int& ldb)
+    {
+        cublasErrcheck(cublasZtrsm(cublas_handle, judge_side(side), judge_uplo(uplo), judge_trans(transa), judge_diag(diag),
+                                   m, n, (double2*)alpha, (double2*)A, lda, (double2*)B, ldb));
+    }
+
+    void operator()(
+            const char& side, const char& uplo, const char& transa, const char& diag,
+            const int& m, const int& n,
+            const double *alpha, const double *A, const int& lda,
+            double *B, const int& ldb)
+    {
+        cublasErrcheck(cublasDtrsm(cublas_handle, judge_side(side), judge_uplo(uplo), judge_trans(transa), judge_diag(diag),
+                                   m, n, alpha, A, lda, B, ldb));
+    }
 };
 
 // Explicitly instantiate functors for the types of functor registered.
@@ -152,6 +152,244 @@ void xheevd_wrapper (
     assert(0 == devInfo.data<int>()[0]);
 }
 
+static inline
+void xsygvd_wrapper (
+        const cublasFillMode_t& uplo,
+        const int& n,
+        float * A, const int& lda,
+        float * B, const int& ldb,
+        float * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnSsygvd_bufferSize(cusolver_H, CUSOLVER_EIG_TYPE_1, CUSOLVER_EIG_MODE_VECTOR, uplo, n,
+                                                 A, lda, B, ldb, W, &lwork));
+    Tensor work(DataType::DT_FLOAT, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnSsygvd(cusolver_H, CUSOLVER_EIG_TYPE_1, CUSOLVER_EIG_MODE_VECTOR, uplo, n,
+                                      A, lda, B, ldb, W, work.data<float>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xsygvd_wrapper (
+        const cublasFillMode_t& uplo,
+        const int& n,
+        double * A, const int& lda,
+        double * B, const int& ldb,
+        double * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnDsygvd_bufferSize(cusolver_H, CUSOLVER_EIG_TYPE_1, CUSOLVER_EIG_MODE_VECTOR, uplo, n,
+                                                 A, lda, B, ldb, W, &lwork));
+    Tensor work(DataType::DT_DOUBLE, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnDsygvd(cusolver_H, CUSOLVER_EIG_TYPE_1, CUSOLVER_EIG_MODE_VECTOR, uplo, n,
+                                      A, lda, B, ldb, W, work.data<double>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xsyevd_wrapper (
+        const cublasFillMode_t& uplo,
+        const int& n,
+        float * A, const int& lda,
+        float * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnSsyevd_bufferSize(cusolver_H, CUSOLVER_EIG_MODE_VECTOR, uplo, n, A, lda, W, &lwork));
+    Tensor work(DataType::DT_FLOAT, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnSsyevd(cusolver_H, CUSOLVER_EIG_MODE_VECTOR, uplo, n, A, lda, W,
+                                      work.data<float>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xsyevd_wrapper (
+        const cublasFillMode_t& uplo,
+        const int& n,
+        double * A, const int& lda,
+        double * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnDsyevd_bufferSize(cusolver_H, CUSOLVER_EIG_MODE_VECTOR, uplo, n, A, lda, W, &lwork));
+    Tensor work(DataType::DT_DOUBLE, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnDsyevd(cusolver_H, CUSOLVER_EIG_MODE_VECTOR, uplo, n, A, lda, W,
+                                      work.data<double>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline cusolverEigMode_t judge_jobz(const char& jobz) {
+    return jobz == 'N' ? CUSOLVER_EIG_MODE_NOVECTOR : CUSOLVER_EIG_MODE_VECTOR;
+}
+
+static inline cusolverEigRange_t judge_range(const char& range) {
+    return range == 'V' ? CUSOLVER_EIG_RANGE_V : range == 'I' ? CUSOLVER_EIG_RANGE_I : CUSOLVER_EIG_RANGE_ALL;
+}
+
+static inline
+void xheevdx_wrapper (
+        const char& jobz, const char& range, const int& n,
+        std::complex<float> * A, const int& lda,
+        const float& vl, const float& vu, const int& il, const int& iu, int& m, float * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnCheevdx_bufferSize(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                                  reinterpret_cast<const float2 *>(A), lda, vl, vu, il, iu, &m, W, &lwork));
+    Tensor work(DataType::DT_COMPLEX, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnCheevdx(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                       reinterpret_cast<float2 *>(A), lda, vl, vu, il, iu, &m, W,
+                                       reinterpret_cast<cuComplex *>(work.data<std::complex<float>>()), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xheevdx_wrapper (
+        const char& jobz, const char& range, const int& n,
+        std::complex<double> * A, const int& lda,
+        const double& vl, const double& vu, const int& il, const int& iu, int& m, double * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnZheevdx_bufferSize(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                                  reinterpret_cast<const double2 *>(A), lda, vl, vu, il, iu, &m, W, &lwork));
+    Tensor work(DataType::DT_COMPLEX_DOUBLE, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnZheevdx(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                       reinterpret_cast<double2 *>(A), lda, vl, vu, il, iu, &m, W,
+                                       reinterpret_cast<cuDoubleComplex *>(work.data<std::complex<double>>()), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xheevdx_wrapper (
+        const char& jobz, const char& range, const int& n,
+        float * A, const int& lda,
+        const float& vl, const float& vu, const int& il, const int& iu, int& m, float * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnSsyevdx_bufferSize(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                                  A, lda, vl, vu, il, iu, &m, W, &lwork));
+    Tensor work(DataType::DT_FLOAT, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnSsyevdx(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                       A, lda, vl, vu, il, iu, &m, W, work.data<float>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xheevdx_wrapper (
+        const char& jobz, const char& range, const int& n,
+        double * A, const int& lda,
+        const double& vl, const double& vu, const int& il, const int& iu, int& m, double * W)
+{
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnDsyevdx_bufferSize(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                                  A, lda, vl, vu, il, iu, &m, W, &lwork));
+    Tensor work(DataType::DT_DOUBLE, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnDsyevdx(cusolver_H, judge_jobz(jobz), judge_range(range), CUBLAS_FILL_MODE_LOWER, n,
+                                       A, lda, vl, vu, il, iu, &m, W, work.data<double>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+cublasFillMode_t judge_uplo(const char& uplo) {
+    return uplo == 'U' ? CUBLAS_FILL_MODE_UPPER : CUBLAS_FILL_MODE_LOWER;
+}
+
+static inline
+void xpotrf_wrapper(const char& uplo, const int& n, float * A, const int& lda) {
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnSpotrf_bufferSize(cusolver_H, judge_uplo(uplo), n, A, lda, &lwork));
+    Tensor work(DataType::DT_FLOAT, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnSpotrf(cusolver_H, judge_uplo(uplo), n, A, lda, work.data<float>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xpotrf_wrapper(const char& uplo, const int& n, double * A, const int& lda) {
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnDpotrf_bufferSize(cusolver_H, judge_uplo(uplo), n, A, lda, &lwork));
+    Tensor work(DataType::DT_DOUBLE, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnDpotrf(cusolver_H, judge_uplo(uplo), n, A, lda, work.data<double>(), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xpotrf_wrapper(const char& uplo, const int& n, std::complex<float> * A, const int& lda) {
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnCpotrf_bufferSize(cusolver_H, judge_uplo(uplo), n, reinterpret_cast<float2 *>(A), lda, &lwork));
+    Tensor work(DataType::DT_COMPLEX, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnCpotrf(cusolver_H, judge_uplo(uplo), n, reinterpret_cast<float2 *>(A), lda,
+                                      reinterpret_cast<float2 *>(work.data<std::complex<float>>()), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+static inline
+void xpotrf_wrapper(const char& uplo, const int& n, std::complex<double> * A, const int& lda) {
+    int lwork = 0;
+    Tensor devInfo(DataType::DT_INT, DeviceType::GpuDevice, {1});
+    cusolverErrcheck(cusolverDnZpotrf_bufferSize(cusolver_H, judge_uplo(uplo), n, reinterpret_cast<double2 *>(A), lda, &lwork));
+    Tensor work(DataType::DT_COMPLEX_DOUBLE, DeviceType::GpuDevice, {lwork});
+    cusolverErrcheck(cusolverDnZpotrf(cusolver_H, judge_uplo(uplo), n, reinterpret_cast<double2 *>(A), lda,
+                                      reinterpret_cast<double2 *>(work.data<std::complex<double>>()), lwork, devInfo.data<int>()));
+    devInfo.to_device<DEVICE_CPU>();
+    assert(0 == devInfo.data<int>()[0]);
+}
+
+// cuSOLVER has no hegst, C = L^-1 A L^-H (U^-H A U^-1) is computed with two triangular solves on the full A.
+template <typename T>
+static inline
+void hegst_gpu(const int& itype, const char& uplo, const int& n, T* A, const int& lda, const T* B, const int& ldb) {
+    assert(itype == 1);
+    // CUBLAS_OP_C is the plain transpose for real data.
+    const T one = static_cast<T>(1.0);
+    using Real = typename GetTypeReal<T>::type;
+    if (uplo == 'L') {
+        trsm_op<Real, DEVICE_GPU>()('L', 'L', 'N', 'N', n, n, &one, B, ldb, A, lda);
+        trsm_op<Real, DEVICE_GPU>()('R', 'L', 'C', 'N', n, n, &one, B, ldb, A, lda);
+    }
+    else {
+        trsm_op<Real, DEVICE_GPU>()('L', 'U', 'C', 'N', n, n, &one, B, ldb, A, lda);
+        trsm_op<Real, DEVICE_GPU>()('R', 'U', 'N', 'N', n, n, &one, B, ldb, A, lda);
+    }
+}
+
+// heevdx works in place, the eigenvectors overwrite the first m columns of A.
+template <typename T>
+static inline
+void dnevr_gpu(
+        const char& jobz, const char& range, const int& nstart, const int& ldh, const T* A,
+        const typename GetTypeReal<T>::type& vl, const typename GetTypeReal<T>::type& vu,
+        const int& il, const int& iu, int& m, typename GetTypeReal<T>::type* W, T* V)
+{
+    assert(nstart <= ldh);
+    if (jobz == 'V') {
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(T) * nstart * ldh, cudaMemcpyDeviceToDevice));
+        xheevdx_wrapper(jobz, range, nstart, V, ldh, vl, vu, il, iu, m, W);
+        return;
+    }
+    Tensor aux(DataTypeToEnum<T>::value, DeviceType::GpuDevice, {nstart * ldh});
+    cudaErrcheck(cudaMemcpy(aux.data<T>(), A, sizeof(T) * nstart * ldh, cudaMemcpyDeviceToDevice));
+    xheevdx_wrapper(jobz, range, nstart, aux.data<T>(), ldh, vl, vu, il, iu, m, W);
+}
+
 template <typename T>
 struct dngvd_op<T, DEVICE_GPU> {
     void operator()(
@@ -168,6 +406,19 @@ struct dngvd_op<T, DEVICE_GPU> {
         xhegvd_wrapper(CUBLAS_FILL_MODE_UPPER, nstart, V, ldh,
                        (std::complex<T> *)B, ldh, W);
     }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T *A,
+            const T *B,
+            T *W,
+            T *V)
+    {
+        assert(nstart == ldh);
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(T) * ldh * nstart, cudaMemcpyDeviceToDevice));
+        xsygvd_wrapper(CUBLAS_FILL_MODE_UPPER, nstart, V, ldh, (T *)B, ldh, W);
+    }
 };
 
 template <typename T>
@@ -185,12 +436,227 @@ struct dnevx_op<T, DEVICE_GPU> {
         cudaErrcheck(cudaMemcpy(V, A, sizeof(std::complex<T>) * nstart * ldh, cudaMemcpyDeviceToDevice));
         xheevd_wrapper(CUBLAS_FILL_MODE_LOWER, nstart, V, ldh, W);
     }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T *A,
+            const int m,
+            T *W,
+            T *V)
+    {
+        assert(nstart <= ldh);
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(T) * nstart * ldh, cudaMemcpyDeviceToDevice));
+        xsyevd_wrapper(CUBLAS_FILL_MODE_LOWER, nstart, V, ldh, W);
+    }
+};
+
+template <typename T>
+struct dnevr_op<T, DEVICE_GPU> {
+    void operator()(
+            const char jobz,
+            const char range,
+            const int nstart,
+            const int ldh,
+            const std::complex<T> *A,
+            const T vl,
+            const T vu,
+            const int il,
+            const int iu,
+            int& m,
+            T *W,
+            std::complex<T> *V)
+    {
+        dnevr_gpu(jobz, range, nstart, ldh, A, vl, vu, il, iu, m, W, V);
+    }
+
+    void operator()(
+            const char jobz,
+            const char range,
+            const int nstart,
+            const int ldh,
+            const T *A,
+            const T vl,
+            const T vu,
+            const int il,
+            const int iu,
+            int& m,
+            T *W,
+            T *V)
+    {
+        dnevr_gpu(jobz, range, nstart, ldh, A, vl, vu, il, iu, m, W, V);
+    }
+};
+
+template <typename T>
+struct potrf_op<T, DEVICE_GPU> {
+    void operator()(const char uplo, const int n, std::complex<T> *A, const int lda) {
+        xpotrf_wrapper(uplo, n, A, lda);
+    }
+
+    void operator()(const char uplo, const int n, T *A, const int lda) {
+        xpotrf_wrapper(uplo, n, A, lda);
+    }
+};
+
+template <typename T>
+struct hegst_op<T, DEVICE_GPU> {
+    void operator()(
+            const int itype, const char uplo, const int n,
+            std::complex<T> *A, const int lda, const std::complex<T> *B, const int ldb)
+    {
+        hegst_gpu(itype, uplo, n, A, lda, B, ldb);
+    }
+
+    void operator()(
+            const int itype, const char uplo, const int n,
+            T *A, const int lda, const T *B, const int ldb)
+    {
+        hegst_gpu(itype, uplo, n, A, lda, B, ldb);
+    }
+};
+
+template <typename T>
+struct dngvd_factored_op<T, DEVICE_GPU> {
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const std::complex<T> *A,
+            const std::complex<T> *L,
+            T *W,
+            std::complex<T> *V)
+    {
+        assert(nstart == ldh);
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(std::complex<T>) * ldh * nstart, cudaMemcpyDeviceToDevice));
+        hegst_gpu(1, 'L', nstart, V, ldh, L, ldh);
+        xheevd_wrapper(CUBLAS_FILL_MODE_LOWER, nstart, V, ldh, W);
+        const std::complex<T> one = 1.0;
+        trsm_op<T, DEVICE_GPU>()('L', 'L', 'C', 'N', nstart, nstart, &one, L, ldh, V, ldh);
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T *A,
+            const T *L,
+            T *W,
+            T *V)
+    {
+        assert(nstart == ldh);
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(T) * ldh * nstart, cudaMemcpyDeviceToDevice));
+        hegst_gpu(1, 'L', nstart, V, ldh, L, ldh);
+        xsyevd_wrapper(CUBLAS_FILL_MODE_LOWER, nstart, V, ldh, W);
+        const T one = 1.0;
+        trsm_op<T, DEVICE_GPU>()('L', 'L', 'T', 'N', nstart, nstart, &one, L, ldh, V, ldh);
+    }
+};
+
+template <typename T>
+struct dngvd_inplace_op<T, DEVICE_GPU> {
+    void operator()(
+            const int nstart,
+            const int ldh,
+            std::complex<T> *A, // hcc
+            std::complex<T> *B, // scc
+            T *W) // eigenvalue
+    {
+        assert(nstart == ldh);
+        xhegvd_wrapper(CUBLAS_FILL_MODE_UPPER, nstart, A, ldh, B, ldh, W);
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            T *A,
+            T *B,
+            T *W)
+    {
+        assert(nstart == ldh);
+        xsygvd_wrapper(CUBLAS_FILL_MODE_UPPER, nstart, A, ldh, B, ldh, W);
+    }
+};
+
+template <typename T>
+struct dnevx_inplace_op<T, DEVICE_GPU> {
+    void operator()(
+            const int nstart,
+            const int ldh,
+            std::complex<T> *A, // hcc
+            const int m,
+            T *W, // eigenvalue
+            std::complex<T> *V)
+    {
+        assert(nstart <= ldh);
+        // Solve in A, only the first m eigenvectors are copied to V.
+        xheevd_wrapper(CUBLAS_FILL_MODE_LOWER, nstart, A, ldh, W);
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(std::complex<T>) * m * ldh, cudaMemcpyDeviceToDevice));
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            T *A,
+            const int m,
+            T *W,
+            T *V)
+    {
+        assert(nstart <= ldh);
+        xsyevd_wrapper(CUBLAS_FILL_MODE_LOWER, nstart, A, ldh, W);
+        cudaErrcheck(cudaMemcpy(V, A, sizeof(T) * m * ldh, cudaMemcpyDeviceToDevice));
+    }
+};
+
+template <typename T>
+struct dngvd_batched_op<T, DEVICE_GPU> {
+    void operator()(
+            const int batch,
+            const int nstart,
+            const int ldh,
+            const std::complex<T> *A, // hcc
+            const std::complex<T> *B, // scc
+            T *W, // eigenvalue
+            std::complex<T> *V)
+    {
+        const int64_t size = static_cast<int64_t>(ldh) * nstart;
+        for (int ii = 0; ii < batch; ii++) {
+            dngvd_op<T, DEVICE_GPU>()(nstart, ldh, A + ii * size, B + ii * size, W + ii * nstart, V + ii * size);
+        }
+    }
+
+    void operator()(
+            const int batch,
+            const int nstart,
+            const int ldh,
+            const T *A,
+            const T *B,
+            T *W,
+            T *V)
+    {
+        const int64_t size = static_cast<int64_t>(ldh) * nstart;
+        for (int ii = 0; ii < batch; ii++) {
+            dngvd_op<T, DEVICE_GPU>()(nstart, ldh, A + ii * size, B + ii * size, W + ii * nstart, V + ii * size);
+        }
+    }
 };
 
 template struct dngvd_op<float, DEVICE_GPU>;
 template struct dnevx_op<float, DEVICE_GPU>;
 template struct dngvd_op<double, DEVICE_GPU>;
 template struct dnevx_op<double, DEVICE_GPU>;
+template struct potrf_op<float, DEVICE_GPU>;
+template struct potrf_op<double, DEVICE_GPU>;
+template struct hegst_op<float, DEVICE_GPU>;
+template struct hegst_op<double, DEVICE_GPU>;
+template struct dngvd_factored_op<float, DEVICE_GPU>;
+template struct dngvd_factored_op<double, DEVICE_GPU>;
+template struct dnevr_op<float, DEVICE_GPU>;
+template struct dnevr_op<double, DEVICE_GPU>;
+template struct dngvd_batched_op<float, DEVICE_GPU>;
+template struct dngvd_batched_op<double, DEVICE_GPU>;
+template struct dngvd_inplace_op<float, DEVICE_GPU>;
+template struct dnevx_inplace_op<float, DEVICE_GPU>;
+template struct dngvd_inplace_op<double, DEVICE_GPU>;
+template struct dnevx_inplace_op<double, DEVICE_GPU>;
 
 } // namespace op
 } // namespace container
\ No newline at end of file
@@ -14,9 +14,9 @@ template <typename T_out, typename T_in>
 __global__ void cast_memory(
         T_out* out,
         const T_in* in,
-        const int size)
+        const int64_t size)
 {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
     if(idx >= size) {return;}
     out[idx] = static_cast<T_out>(in[idx]);
 }
@@ -25,9 +25,9 @@ template <typename T_out, typename T_in>
 __global__ void cast_memory(
         std::complex<T_out>* out,
         const std::complex<T_in>* in,
-        const int size)
+        const int64_t size)
 {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
     if(idx >= size) {return;}
     auto* _out = reinterpret_cast<thrust::complex<T_out>*>(out);
     const auto* _in = reinterpret_cast<const thrust::complex<T_in>*>(in);
@@ -114,7 +114,7 @@ struct cast_memory_op<T_out, T_in, container::DEVICE_CPU, container::DEVICE_GPU>
                     const size_t size) {
         auto * arr = (T_in*) malloc(sizeof(T_in) * size);
         cudaMemcpy(arr, arr_in, sizeof(T_in) * size, cudaMemcpyDeviceToHost);
-        for (int ii = 0; ii < size; ii++) {
+        for (int64_t ii = 0; ii < size; ii++) {
             arr_out[ii] = static_cast<T_out>(arr[ii]);
         }
         free(arr);
@@ -0,0 +1,474 @@
+#include "eigensolver_op.h"
+#include "blas_op.h"
+#include "lapack_op.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+namespace container {
+
+namespace {
+
+// The vector blocks are column-major dim x cols matrices, i.e. the row-major [cols, dim] tensors
+// of the callbacks, so that a single vector is contiguous.
+
+template <typename T>
+void gemm(
+        const char& transa, const char& transb,
+        const int& m, const int& n, const int& k,
+        const T& alpha, const T* a, const int& lda, const T* b, const int& ldb,
+        const T& beta, T* c, const int& ldc)
+{
+    op::gemm_op<typename GetTypeReal<T>::type, DEVICE_CPU>()(
+            transa, transb, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+}
+
+template <typename T>
+T* column(T* block, const int& dim, const int& col) {
+    return block + static_cast<int64_t>(dim) * col;
+}
+
+template <typename T>
+void copy_columns(const int& dim, const int& cols, const T* from, T* to) {
+    std::memcpy(to, from, sizeof(T) * dim * cols);
+}
+
+// out = op * in for `cols` vectors, the identity when op is empty.
+template <typename T>
+void apply(const BlockOperator& op, const int& dim, const int& cols, const T* in, T* out) {
+    if (cols == 0) {
+        return;
+    }
+    if (!op) {
+        copy_columns(dim, cols, in, out);
+        return;
+    }
+    const Tensor in_view(const_cast<T*>(in), DataTypeToEnum<T>::value, DeviceType::CpuDevice, {cols, dim});
+    Tensor out_view(out, DataTypeToEnum<T>::value, DeviceType::CpuDevice, {cols, dim});
+    op(in_view, out_view);
+}
+
+// S-orthonormalize the `cols` vectors of w against the nb S-orthonormal vectors of v (two passes of
+// block Gram-Schmidt), then among themselves through the eigendecomposition of their Gram matrix.
+// sw (and hw when given) are updated with the same linear combinations. Directions whose norm is
+// negligible after the projection are dropped, the number of remaining vectors is returned.
+template <typename T>
+int orthonormalize(
+        const int& dim, const int& nb, const T* v, const T* sv, const T* hv,
+        const int& cols, T* w, T* sw, T* hw)
+{
+    using Real = typename GetTypeReal<T>::type;
+    if (cols == 0) {
+        return 0;
+    }
+    // Unit 2-norm first, so that the drop tolerance is relative.
+    for (int jj = 0; jj < cols; jj++) {
+        Real norm = 0;
+        for (int ii = 0; ii < dim; ii++) {
+            norm += std::norm(column(w, dim, jj)[ii]);
+        }
+        const T scale = norm > 0 ? T(1 / std::sqrt(norm)) : T(0);
+        for (int ii = 0; ii < dim; ii++) {
+            column(w, dim, jj)[ii] *= scale;
+            column(sw, dim, jj)[ii] *= scale;
+            if (hw != nullptr) {
+                column(hw, dim, jj)[ii] *= scale;
+            }
+        }
+    }
+    if (nb > 0) {
+        std::vector<T> coef(static_cast<size_t>(nb) * cols);
+        for (int pass = 0; pass < 2; pass++) {
+            gemm<T>('C', 'N', nb, cols, dim, T(1), sv, dim, w, dim, T(0), coef.data(), nb);
+            gemm<T>('N', 'N', dim, cols, nb, T(-1), v, dim, coef.data(), nb, T(1), w, dim);
+            gemm<T>('N', 'N', dim, cols, nb, T(-1), sv, dim, coef.data(), nb, T(1), sw, dim);
+            if (hw != nullptr) {
+                gemm<T>('N', 'N', dim, cols, nb, T(-1), hv, dim, coef.data(), nb, T(1), hw, dim);
+            }
+        }
+    }
+    std::vector<T> gram(static_cast<size_t>(cols) * cols), u(static_cast<size_t>(cols) * cols);
+    std::vector<Real> g(cols);
+    gemm<T>('C', 'N', cols, cols, dim, T(1), w, dim, sw, dim, T(0), gram.data(), cols);
+    int found = 0;
+    op::dnevr_op<Real, DEVICE_CPU>()('V', 'A', cols, cols, gram.data(), 0, 0, 0, 0, found, g.data(), u.data());
+
+    // Keep the directions with a non-negligible norm, scaled to unit S-norm, largest first.
+    const Real drop = std::sqrt(std::numeric_limits<Real>::epsilon());
+    std::vector<T> trans(static_cast<size_t>(cols) * cols);
+    int rank = 0;
+    for (int jj = cols - 1; jj >= 0; jj--) {
+        if (g[jj] > drop) {
+            const Real scale = 1 / std::sqrt(g[jj]);
+            for (int ii = 0; ii < cols; ii++) {
+                trans[ii + rank * cols] = u[ii + jj * cols] * scale;
+            }
+            rank++;
+        }
+    }
+    if (rank == 0) {
+        return 0;
+    }
+    std::vector<T> tmp(static_cast<size_t>(dim) * rank);
+    T* blocks[3] = {w, sw, hw};
+    for (T* block : blocks) {
+        if (block != nullptr) {
+            gemm<T>('N', 'N', dim, rank, cols, T(1), block, dim, trans.data(), cols, T(0), tmp.data(), dim);
+            copy_columns(dim, rank, tmp.data(), block);
+        }
+    }
+    return rank;
+}
+
+// Solve the dense subspace problem, single precision data has no mixed precision mode.
+template <typename T>
+void solve_subspace(
+        const int& nz, T* hs, T* ss, typename GetTypeReal<T>::type* w, T* c, const double&)
+{
+    op::dngvd_op<typename GetTypeReal<T>::type, DEVICE_CPU>()(nz, nz, hs, ss, w, c);
+}
+
+template <typename T>
+void solve_subspace_mixed(const int& nz, T* hs, T* ss, double* w, T* c, const double& mixed_tol)
+{
+    if (mixed_tol > 0) {
+        op::dngvd_mixed_op<double, DEVICE_CPU>()(nz, nz, hs, ss, w, c, mixed_tol);
+    }
+    else {
+        op::dngvd_op<double, DEVICE_CPU>()(nz, nz, hs, ss, w, c);
+    }
+}
+
+void solve_subspace(const int& nz, double* hs, double* ss, double* w, double* c, const double& mixed_tol) {
+    solve_subspace_mixed(nz, hs, ss, w, c, mixed_tol);
+}
+
+void solve_subspace(
+        const int& nz, std::complex<double>* hs, std::complex<double>* ss, double* w, std::complex<double>* c,
+        const double& mixed_tol)
+{
+    solve_subspace_mixed(nz, hs, ss, w, c, mixed_tol);
+}
+
+// Solve the projected problem (Z^H H Z) c = lambda (Z^H S Z) c on the nz columns of z.
+template <typename T>
+void rayleigh_ritz(
+        const int& dim, const int& nz, const T* z, const T* hz, const T* sz,
+        typename GetTypeReal<T>::type* w, T* c, const double& mixed_tol)
+{
+    std::vector<T> hs(static_cast<size_t>(nz) * nz), ss(static_cast<size_t>(nz) * nz);
+    gemm<T>('C', 'N', nz, nz, dim, T(1), z, dim, hz, dim, T(0), hs.data(), nz);
+    gemm<T>('C', 'N', nz, nz, dim, T(1), z, dim, sz, dim, T(0), ss.data(), nz);
+    solve_subspace(nz, hs.data(), ss.data(), w, c, mixed_tol);
+}
+
+// The Ritz vectors x = z c(:, 0:nband), together with h x and s x.
+template <typename T>
+void ritz_vectors(
+        const int& dim, const int& nz, const int& nband, const T* c,
+        const T* z, const T* hz, const T* sz, T* x, T* hx, T* sx)
+{
+    gemm<T>('N', 'N', dim, nband, nz, T(1), z, dim, c, nz, T(0), x, dim);
+    gemm<T>('N', 'N', dim, nband, nz, T(1), hz, dim, c, nz, T(0), hx, dim);
+    gemm<T>('N', 'N', dim, nband, nz, T(1), sz, dim, c, nz, T(0), sx, dim);
+}
+
+// r = h x - lambda s x for every band, returns the number of converged bands.
+template <typename T>
+int residuals(
+        const int& dim, const int& nband, const T* hx, const T* sx,
+        const typename GetTypeReal<T>::type* w, const double& tol,
+        T* r, std::vector<double>& norms)
+{
+    int converged = 0;
+    for (int jj = 0; jj < nband; jj++) {
+        double norm = 0;
+        for (int ii = 0; ii < dim; ii++) {
+            T& value = column(r, dim, jj)[ii];
+            value = column(hx, dim, jj)[ii] - w[jj] * column(sx, dim, jj)[ii];
+            norm += std::norm(value);
+        }
+        norms[jj] = std::sqrt(norm);
+        if (norms[jj] < tol) {
+            converged++;
+        }
+    }
+    return converged;
+}
+
+// Gather at most `limit` unconverged residuals into block, precondition them and return their number.
+template <typename T>
+int correction_vectors(
+        const int& dim, const int& nband, const int& limit, const T* r,
+        const typename GetTypeReal<T>::type* w, const std::vector<double>& norms, const double& tol,
+        const BlockPreconditioner& precondition, T* block)
+{
+    using Real = typename GetTypeReal<T>::type;
+    std::vector<Real> values;
+    for (int jj = 0; jj < nband && static_cast<int>(values.size()) < limit; jj++) {
+        if (norms[jj] >= tol) {
+            copy_columns(dim, 1, column(r, dim, jj), column(block, dim, static_cast<int>(values.size())));
+            values.push_back(w[jj]);
+        }
+    }
+    const int cols = static_cast<int>(values.size());
+    if (precondition && cols > 0) {
+        Tensor block_view(block, DataTypeToEnum<T>::value, DeviceType::CpuDevice, {cols, dim});
+        const Tensor values_view(values.data(), DataTypeToEnum<Real>::value, DeviceType::CpuDevice, {cols});
+        precondition(block_view, values_view);
+    }
+    return cols;
+}
+
+template <typename T>
+EigensolverInfo davidson_impl(
+        const BlockOperator& apply_h,
+        const BlockOperator& apply_s,
+        const BlockPreconditioner& precondition,
+        Tensor& psi,
+        Tensor& eigenvalues,
+        const EigensolverOptions& options)
+{
+    using Real = typename GetTypeReal<T>::type;
+    const int nband = psi.shape().dim_size(0), dim = psi.shape().dim_size(1);
+    const int max_basis = std::min(
+            dim, std::max(2 * nband, options.max_subspace > 0 ? options.max_subspace : 4 * nband));
+
+    Tensor v(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {max_basis, dim});
+    Tensor hv(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {max_basis, dim});
+    Tensor sv(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {max_basis, dim});
+    Tensor hx(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor sx(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor r(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    T* x = psi.data<T>();
+    std::vector<T> c(static_cast<size_t>(max_basis) * max_basis);
+    std::vector<Real> w(max_basis);
+    std::vector<double> norms(nband);
+
+    copy_columns(dim, nband, x, v.data<T>());
+    apply(apply_s, dim, nband, v.data<T>(), sv.data<T>());
+    int nbase = orthonormalize<T>(dim, 0, nullptr, nullptr, nullptr, nband, v.data<T>(), sv.data<T>(), nullptr);
+    if (nbase < nband) {
+        throw std::invalid_argument("davidson: the initial guess is rank deficient.");
+    }
+    apply(apply_h, dim, nbase, v.data<T>(), hv.data<T>());
+
+    EigensolverInfo info;
+    for (int iter = 0; ; iter++) {
+        rayleigh_ritz(dim, nbase, v.data<T>(), hv.data<T>(), sv.data<T>(), w.data(), c.data(), options.mixed_precision_tol);
+        ritz_vectors(dim, nbase, nband, c.data(), v.data<T>(), hv.data<T>(), sv.data<T>(),
+                     x, hx.data<T>(), sx.data<T>());
+        info.iterations = iter;
+        info.converged = residuals(dim, nband, hx.data<T>(), sx.data<T>(), w.data(), options.tol, r.data<T>(), norms);
+        if (info.converged == nband || iter == options.max_iter) {
+            break;
+        }
+        // Restart from the Ritz vectors when the new directions do not fit, they are S-orthonormal.
+        if (nbase + std::min(nband - info.converged, max_basis - nband) > max_basis) {
+            copy_columns(dim, nband, x, v.data<T>());
+            copy_columns(dim, nband, hx.data<T>(), hv.data<T>());
+            copy_columns(dim, nband, sx.data<T>(), sv.data<T>());
+            nbase = nband;
+        }
+        T* new_v = column(v.data<T>(), dim, nbase);
+        T* new_sv = column(sv.data<T>(), dim, nbase);
+        const int cols = correction_vectors(dim, nband, max_basis - nbase, r.data<T>(), w.data(), norms,
+                                            options.tol, precondition, new_v);
+        apply(apply_s, dim, cols, new_v, new_sv);
+        const int added = orthonormalize<T>(dim, nbase, v.data<T>(), sv.data<T>(), nullptr, cols, new_v, new_sv, nullptr);
+        if (added == 0) {
+            // The search space can not be extended any more.
+            break;
+        }
+        apply(apply_h, dim, added, new_v, column(hv.data<T>(), dim, nbase));
+        nbase += added;
+    }
+    info.max_residual = *std::max_element(norms.begin(), norms.end());
+    std::copy(w.begin(), w.begin() + nband, eigenvalues.data<Real>());
+    return info;
+}
+
+template <typename T>
+EigensolverInfo lobpcg_impl(
+        const BlockOperator& apply_h,
+        const BlockOperator& apply_s,
+        const BlockPreconditioner& precondition,
+        Tensor& psi,
+        Tensor& eigenvalues,
+        const EigensolverOptions& options)
+{
+    using Real = typename GetTypeReal<T>::type;
+    const int nband = psi.shape().dim_size(0), dim = psi.shape().dim_size(1);
+    const int max_basis = std::min(dim, 3 * nband);
+
+    // The subspace [X, W, P] and its images under H and S.
+    Tensor z(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {max_basis, dim});
+    Tensor hz(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {max_basis, dim});
+    Tensor sz(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {max_basis, dim});
+    Tensor p(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor hp(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor sp(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor hx(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor sx(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    Tensor r(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {nband, dim});
+    T* x = psi.data<T>();
+    std::vector<T> c(static_cast<size_t>(max_basis) * max_basis);
+    std::vector<Real> w(max_basis);
+    std::vector<double> norms(nband);
+
+    copy_columns(dim, nband, x, z.data<T>());
+    apply(apply_s, dim, nband, z.data<T>(), sz.data<T>());
+    if (orthonormalize<T>(dim, 0, nullptr, nullptr, nullptr, nband, z.data<T>(), sz.data<T>(), nullptr) < nband) {
+        throw std::invalid_argument("lobpcg: the initial guess is rank deficient.");
+    }
+    apply(apply_h, dim, nband, z.data<T>(), hz.data<T>());
+    rayleigh_ritz(dim, nband, z.data<T>(), hz.data<T>(), sz.data<T>(), w.data(), c.data(), options.mixed_precision_tol);
+    ritz_vectors(dim, nband, nband, c.data(), z.data<T>(), hz.data<T>(), sz.data<T>(),
+                 x, hx.data<T>(), sx.data<T>());
+
+    EigensolverInfo info;
+    int np = 0;
+    for (int iter = 0; ; iter++) {
+        info.iterations = iter;
+        info.converged = residuals(dim, nband, hx.data<T>(), sx.data<T>(), w.data(), options.tol, r.data<T>(), norms);
+        if (info.converged == nband || iter == options.max_iter) {
+            break;
+        }
+        copy_columns(dim, nband, x, z.data<T>());
+        copy_columns(dim, nband, hx.data<T>(), hz.data<T>());
+        copy_columns(dim, nband, sx.data<T>(), sz.data<T>());
+        int nz = nband;
+
+        // W: the preconditioned residuals of the unconverged bands.
+        const int cols = correction_vectors(dim, nband, max_basis - nz, r.data<T>(), w.data(), norms,
+                                            options.tol, precondition, column(z.data<T>(), dim, nz));
+        apply(apply_s, dim, cols, column(z.data<T>(), dim, nz), column(sz.data<T>(), dim, nz));
+        const int nw = orthonormalize<T>(dim, nz, z.data<T>(), sz.data<T>(), nullptr, cols,
+                                         column(z.data<T>(), dim, nz), column(sz.data<T>(), dim, nz), nullptr);
+        apply(apply_h, dim, nw, column(z.data<T>(), dim, nz), column(hz.data<T>(), dim, nz));
+        nz += nw;
+
+        // P: the previous search directions, H P and S P are updated without applying H and S.
+        const int npp = std::min(np, max_basis - nz);
+        copy_columns(dim, npp, p.data<T>(), column(z.data<T>(), dim, nz));
+        copy_columns(dim, npp, hp.data<T>(), column(hz.data<T>(), dim, nz));
+        copy_columns(dim, npp, sp.data<T>(), column(sz.data<T>(), dim, nz));
+        nz += orthonormalize<T>(dim, nz, z.data<T>(), sz.data<T>(), hz.data<T>(), npp,
+                                column(z.data<T>(), dim, nz), column(sz.data<T>(), dim, nz),
+                                column(hz.data<T>(), dim, nz));
+        if (nz == nband) {
+            // No new directions, the search has stagnated.
+            break;
+        }
+
+        rayleigh_ritz(dim, nz, z.data<T>(), hz.data<T>(), sz.data<T>(), w.data(), c.data(), options.mixed_precision_tol);
+        ritz_vectors(dim, nz, nband, c.data(), z.data<T>(), hz.data<T>(), sz.data<T>(),
+                     x, hx.data<T>(), sx.data<T>());
+        // P = [W, P] c([W, P], :), the part of the update outside of the span of X.
+        const int nwp = nz - nband;
+        gemm<T>('N', 'N', dim, nband, nwp, T(1), column(z.data<T>(), dim, nband), dim,
+                c.data() + nband, nz, T(0), p.data<T>(), dim);
+        gemm<T>('N', 'N', dim, nband, nwp, T(1), column(hz.data<T>(), dim, nband), dim,
+                c.data() + nband, nz, T(0), hp.data<T>(), dim);
+        gemm<T>('N', 'N', dim, nband, nwp, T(1), column(sz.data<T>(), dim, nband), dim,
+                c.data() + nband, nz, T(0), sp.data<T>(), dim);
+        np = nband;
+    }
+    info.max_residual = *std::max_element(norms.begin(), norms.end());
+    std::copy(w.begin(), w.begin() + nband, eigenvalues.data<Real>());
+    return info;
+}
+
+DataType real_type(const DataType& data_type) {
+    if (data_type == DataType::DT_COMPLEX) {
+        return DataType::DT_FLOAT;
+    }
+    if (data_type == DataType::DT_COMPLEX_DOUBLE) {
+        return DataType::DT_DOUBLE;
+    }
+    return data_type;
+}
+
+void check_arguments(
+        const std::string& name,
+        const BlockOperator& apply_h,
+        const Tensor& psi,
+        const Tensor& eigenvalues)
+{
+    if (!apply_h) {
+        throw std::invalid_argument(name + ": apply_h must be given.");
+    }
+    if (psi.device_type() != DeviceType::CpuDevice || eigenvalues.device_type() != DeviceType::CpuDevice) {
+        throw std::invalid_argument(name + ": only CPU tensors are supported.");
+    }
+    const DataType data_type = psi.data_type();
+    if (data_type != DataType::DT_FLOAT && data_type != DataType::DT_DOUBLE &&
+        data_type != DataType::DT_COMPLEX && data_type != DataType::DT_COMPLEX_DOUBLE) {
+        throw std::invalid_argument(name + ": only floating point wave functions are supported.");
+    }
+    if (psi.shape().ndim() != 2 || psi.shape().dim_size(0) < 1 ||
+        psi.shape().dim_size(0) > psi.shape().dim_size(1)) {
+        throw std::invalid_argument(name + ": psi must have the shape [nband, dim] with 0 < nband <= dim.");
+    }
+    if (eigenvalues.data_type() != real_type(data_type) || eigenvalues.NumElements() != psi.shape().dim_size(0)) {
+        throw std::invalid_argument(name + ": eigenvalues must have nband elements of the real type of psi.");
+    }
+}
+
+} // namespace
+
+EigensolverInfo davidson(
+        const BlockOperator& apply_h,
+        const BlockOperator& apply_s,
+        const BlockPreconditioner& precondition,
+        Tensor& psi,
+        Tensor& eigenvalues,
+        const EigensolverOptions& options)
+{
+    check_arguments("davidson", apply_h, psi, eigenvalues);
+    // All the tensors are on the CPU, so only the data type is dispatched.
+    switch (psi.data_type()) {
+        case DataType::DT_FLOAT:
+            return davidson_impl<float>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        case DataType::DT_DOUBLE:
+            return davidson_impl<double>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        case DataType::DT_COMPLEX:
+            return davidson_impl<std::complex<float>>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        case DataType::DT_COMPLEX_DOUBLE:
+            return davidson_impl<std::complex<double>>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        default:
+            // Rejected by check_arguments.
+            return EigensolverInfo();
+    }
+}
+
+EigensolverInfo lobpcg(
+        const BlockOperator& apply_h,
+        const BlockOperator& apply_s,
+        const BlockPreconditioner& precondition,
+        Tensor& psi,
+        Tensor& eigenvalues,
+        const EigensolverOptions& options)
+{
+    check_arguments("lobpcg", apply_h, psi, eigenvalues);
+    // All the tensors are on the CPU, so only the data type is dispatched.
+    switch (psi.data_type()) {
+        case DataType::DT_FLOAT:
+            return lobpcg_impl<float>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        case DataType::DT_DOUBLE:
+            return lobpcg_impl<double>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        case DataType::DT_COMPLEX:
+            return lobpcg_impl<std::complex<float>>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        case DataType::DT_COMPLEX_DOUBLE:
+            return lobpcg_impl<std::complex<double>>(apply_h, apply_s, precondition, psi, eigenvalues, options);
+        default:
+            // Rejected by check_arguments.
+            return EigensolverInfo();
+    }
+}
+
+} // namespace container
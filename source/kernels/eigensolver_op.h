@@ -0,0 +1,97 @@
+#ifndef CONTAINER_KERNELS_EIGENSOLVER_OP_H
+#define CONTAINER_KERNELS_EIGENSOLVER_OP_H
+
+#include <functional>
+
+#include "../tensor.h"
+
+namespace container {
+
+/**
+ * @brief A matrix-free operator applied to a block of vectors, out = Op * in.
+ *
+ * Both blocks have the shape [nvec, dim] (one vector per row) and the data type of the
+ * wave functions, `out` is preallocated and must not alias `in`.
+ */
+using BlockOperator = std::function<void(const Tensor& in, Tensor& out)>;
+
+/**
+ * @brief A preconditioner applied in place to a block of residual vectors.
+ *
+ * The block has the shape [nvec, dim], eigenvalues holds the current eigenvalue estimates
+ * ([nvec], real type) of the bands of the residuals, e.g. for a kinetic energy preconditioner.
+ */
+using BlockPreconditioner = std::function<void(Tensor& block, const Tensor& eigenvalues)>;
+
+/**
+ * @brief Parameters of the iterative eigensolvers.
+ */
+struct EigensolverOptions {
+    int max_iter = 100;    ///< Maximum number of iterations.
+    double tol = 1e-8;     ///< A band is converged when the 2-norm of its residual H x - lambda S x is below tol.
+    int max_subspace = 0;  ///< Davidson only: the basis size that triggers a restart, 0 for 4 * nband.
+    /// Double precision only: if positive, the subspace problems are solved in single precision and
+    /// refined to this tolerance in double precision (`dngvd_mixed_op`), 0 for `dngvd_op`.
+    double mixed_precision_tol = 0;
+};
+
+/**
+ * @brief Convergence information of the iterative eigensolvers.
+ */
+struct EigensolverInfo {
+    int iterations = 0;    ///< Number of iterations done.
+    int converged = 0;     ///< Number of converged bands.
+    double max_residual = 0; ///< Largest residual norm of the returned eigenpairs.
+};
+
+/**
+ * @brief Block Davidson solver for the lowest eigenpairs of H x = lambda S x.
+ *
+ * The search space grows with the preconditioned residuals of the unconverged bands, which are
+ * S-orthonormalized against the basis. The projections are done with `gemm_op`, and the subspace
+ * problem is solved with `dngvd_op`. The basis is restarted from the current Ritz vectors when
+ * it would exceed max_subspace.
+ *
+ * @param apply_h The Hamiltonian, applied to blocks of vectors.
+ * @param apply_s The overlap, an empty function for S = I.
+ * @param precondition The preconditioner, an empty function for none.
+ * @param psi The initial guess with shape [nband, dim], e.g. the eigenvectors of the previous
+ *            SCF step (warm start). On exit, the S-orthonormal eigenvectors.
+ * @param eigenvalues The output eigenvalues with shape [nband], in ascending order.
+ * @param options The convergence parameters.
+ *
+ * @return The number of iterations and converged bands.
+ *
+ * @note psi must reside on the CPU, float, double, complex<float> and complex<double> are supported.
+ *       eigenvalues has the real type of psi.
+ * @throw std::invalid_argument if the tensors do not match or the initial guess is rank deficient.
+ */
+EigensolverInfo davidson(
+        const BlockOperator& apply_h,
+        const BlockOperator& apply_s,
+        const BlockPreconditioner& precondition,
+        Tensor& psi,
+        Tensor& eigenvalues,
+        const EigensolverOptions& options = EigensolverOptions());
+
+/**
+ * @brief LOBPCG solver for the lowest eigenpairs of H x = lambda S x.
+ *
+ * Every iteration does a Rayleigh-Ritz step (`dngvd_op`) on the span of the current vectors X,
+ * the preconditioned residuals W of the unconverged bands and the previous search directions P.
+ * W and P are S-orthonormalized against the preceding blocks first, and linearly dependent
+ * directions are dropped, which keeps the subspace problem well conditioned.
+ *
+ * The parameters are the same as for `davidson`, max_subspace is not used.
+ */
+EigensolverInfo lobpcg(
+        const BlockOperator& apply_h,
+        const BlockOperator& apply_s,
+        const BlockPreconditioner& precondition,
+        Tensor& psi,
+        Tensor& eigenvalues,
+        const EigensolverOptions& options = EigensolverOptions());
+
+} // namespace container
+
+#endif // CONTAINER_KERNELS_EIGENSOLVER_OP_H
@@ -0,0 +1,697 @@
+#include "einsum_op.h"
+#include "linalg_op.h"
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <limits>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace container {
+
+namespace {
+
+// Indices of the equation are kept as strings of letters, in storage order.
+using Labels = std::string;
+
+// Maximum number of operands for the exhaustive search of the contraction order.
+constexpr int kMaxOptimalOperands = 12;
+
+// Maximum number of cached contraction plans.
+constexpr size_t kMaxCachedPlans = 256;
+
+/**
+ * @brief One pairwise contraction, result = op(left) * op(right) as a batched GEMM.
+ *
+ * Operand ids below the number of inputs refer to the inputs, the others to the results
+ * of previous steps.
+ */
+struct EinsumStep {
+    int left = 0;            ///< Id of the left operand.
+    int right = 0;           ///< Id of the right operand.
+    Labels left_source;      ///< Labels of the left operand as stored.
+    Labels left_target;      ///< Labels of the left operand passed to the GEMM.
+    Labels right_source;     ///< Labels of the right operand as stored.
+    Labels right_target;     ///< Labels of the right operand passed to the GEMM.
+    char trans_left = 'N';   ///< BLAS flag of the left operand.
+    char trans_right = 'N';  ///< BLAS flag of the right operand.
+    int64_t batch = 1;       ///< Product of the batch dims.
+    int64_t m = 1;           ///< Product of the free dims of the left operand.
+    int64_t n = 1;           ///< Product of the free dims of the right operand.
+    int64_t k = 1;           ///< Product of the contracted dims.
+    Labels result;           ///< Labels of the result, [batch, m, n].
+    bool to_output = false;  ///< Whether the result is written into the output directly.
+};
+
+/**
+ * @brief The contraction plan of an equation for a given set of operand shapes.
+ */
+struct EinsumPlan {
+    std::vector<Labels> inputs;        ///< Labels of each input.
+    Labels output;                     ///< Labels of the output.
+    std::vector<int64_t> sizes;        ///< Dim size of each label, indexed by the label.
+    std::vector<EinsumStep> steps;     ///< Pairwise contractions in execution order.
+    int final_id = 0;                  ///< Id of the operand holding the final result.
+    Labels final_labels;               ///< Labels of the final result as stored.
+};
+
+bool is_label(const char& c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+uint64_t label_bit(const char& c) {
+    return c >= 'a' ? uint64_t(1) << (c - 'a') : uint64_t(1) << (26 + c - 'A');
+}
+
+uint64_t label_mask(const Labels& labels) {
+    uint64_t mask = 0;
+    for (char c : labels) {
+        mask |= label_bit(c);
+    }
+    return mask;
+}
+
+// Keep the labels of the given mask, in the order of the given labels.
+Labels filter(const Labels& labels, const uint64_t& mask) {
+    Labels out;
+    for (char c : labels) {
+        if (label_bit(c) & mask) {
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+double mask_volume(const uint64_t& mask, const std::vector<int64_t>& sizes) {
+    double volume = 1.0;
+    for (int c = 0; c < 128; c++) {
+        if (is_label(static_cast<char>(c)) && (label_bit(static_cast<char>(c)) & mask)) {
+            volume *= static_cast<double>(sizes[c]);
+        }
+    }
+    return volume;
+}
+
+int64_t labels_volume(const Labels& labels, const std::vector<int64_t>& sizes) {
+    int64_t volume = 1;
+    for (char c : labels) {
+        volume *= sizes[c];
+    }
+    return volume;
+}
+
+// Parse the equation and check it against the shapes of the operands.
+void parse_equation(
+        const std::string& equation,
+        const std::vector<TensorShape>& shapes,
+        EinsumPlan& plan)
+{
+    std::string lhs = equation, rhs;
+    const size_t arrow = equation.find("->");
+    const bool explicit_output = arrow != std::string::npos;
+    if (explicit_output) {
+        lhs = equation.substr(0, arrow);
+        rhs = equation.substr(arrow + 2);
+    }
+    Labels term;
+    for (char c : lhs + ",") {
+        if (c == ',') {
+            plan.inputs.push_back(term);
+            term.clear();
+        }
+        else if (is_label(c)) {
+            term.push_back(c);
+        }
+        else if (c != ' ') {
+            throw std::invalid_argument("einsum: invalid character in equation " + equation);
+        }
+    }
+    if (plan.inputs.size() != shapes.size()) {
+        throw std::invalid_argument("einsum: the number of operands does not match the equation " + equation);
+    }
+
+    plan.sizes.assign(128, 0);
+    std::vector<int> counts(128, 0);
+    for (size_t ii = 0; ii < plan.inputs.size(); ii++) {
+        const Labels& labels = plan.inputs[ii];
+        if (labels.size() != shapes[ii].ndim()) {
+            throw std::invalid_argument("einsum: the rank of operand " + std::to_string(ii) +
+                                        " does not match the equation " + equation);
+        }
+        for (size_t jj = 0; jj < labels.size(); jj++) {
+            const char c = labels[jj];
+            if (labels.find(c) != jj) {
+                throw std::invalid_argument("einsum: repeated indices within one operand are not supported.");
+            }
+            if (counts[c] > 0 && plan.sizes[c] != shapes[ii].dim_size(jj)) {
+                throw std::invalid_argument(std::string("einsum: inconsistent dim size for index ") + c);
+            }
+            plan.sizes[c] = shapes[ii].dim_size(jj);
+            counts[c]++;
+        }
+    }
+
+    if (explicit_output) {
+        for (char c : rhs) {
+            if (c == ' ') {
+                continue;
+            }
+            if (!is_label(c) || counts[c] == 0 || plan.output.find(c) != std::string::npos) {
+                throw std::invalid_argument("einsum: invalid output indices in equation " + equation);
+            }
+            plan.output.push_back(c);
+        }
+    }
+    else {
+        // The same ordering as numpy, upper case letters come first.
+        for (int c = 0; c < 128; c++) {
+            if (counts[c] == 1) {
+                plan.output.push_back(static_cast<char>(c));
+            }
+        }
+    }
+}
+
+/**
+ * @brief The contraction tree, every node is a subset of the operands.
+ */
+struct ContractionTree {
+    std::map<uint32_t, uint64_t> masks;  ///< Labels of each subset still needed after contracting it.
+    std::map<uint32_t, std::pair<uint32_t, uint32_t>> splits; ///< Children of each internal node.
+};
+
+// Labels of a subset of operands that are still needed after contracting the subset.
+uint64_t subset_labels(
+        const uint32_t& subset,
+        const std::vector<uint64_t>& operand_masks,
+        const uint64_t& output_mask)
+{
+    uint64_t inside = 0, outside = output_mask;
+    for (size_t ii = 0; ii < operand_masks.size(); ii++) {
+        if (subset & (1u << ii)) {
+            inside |= operand_masks[ii];
+        }
+        else {
+            outside |= operand_masks[ii];
+        }
+    }
+    return inside & outside;
+}
+
+// Find the pairwise contraction order with the minimal flops, and minimal intermediate size for ties.
+ContractionTree find_contraction_order(
+        const std::vector<uint64_t>& operand_masks,
+        const uint64_t& output_mask,
+        const std::vector<int64_t>& sizes)
+{
+    const int num = static_cast<int>(operand_masks.size());
+    const uint32_t full = (num == 32) ? ~0u : (1u << num) - 1;
+    ContractionTree tree;
+
+    if (num <= kMaxOptimalOperands) {
+        // Exhaustive dynamic programming over all the subsets of operands.
+        const double inf = std::numeric_limits<double>::infinity();
+        std::vector<double> flops(full + 1, inf), memory(full + 1, inf);
+        std::vector<uint64_t> needed(full + 1, 0);
+        for (uint32_t subset = 1; subset <= full; subset++) {
+            needed[subset] = subset_labels(subset, operand_masks, output_mask);
+            tree.masks[subset] = needed[subset];
+            if ((subset & (subset - 1)) == 0) {
+                flops[subset] = 0;
+                memory[subset] = 0;
+            }
+        }
+        std::vector<uint32_t> order;
+        for (uint32_t subset = 1; subset <= full; subset++) {
+            order.push_back(subset);
+        }
+        std::stable_sort(order.begin(), order.end(), [](const uint32_t& x, const uint32_t& y) {
+            return __builtin_popcount(x) < __builtin_popcount(y);
+        });
+        for (uint32_t subset : order) {
+            if ((subset & (subset - 1)) == 0) {
+                continue;
+            }
+            const uint32_t lowest = subset & (~subset + 1);
+            const double size = mask_volume(needed[subset], sizes);
+            // Enumerate the splits whose first part contains the lowest operand.
+            for (uint32_t part = (subset - 1) & subset; part > 0; part = (part - 1) & subset) {
+                if (!(part & lowest)) {
+                    continue;
+                }
+                const uint32_t rest = subset ^ part;
+                const double cost = flops[part] + flops[rest] +
+                        mask_volume(needed[part] | needed[rest], sizes);
+                const double peak = std::max(size, std::max(memory[part], memory[rest]));
+                if (cost < flops[subset] || (cost == flops[subset] && peak < memory[subset])) {
+                    flops[subset] = cost;
+                    memory[subset] = peak;
+                    tree.splits[subset] = std::make_pair(part, rest);
+                }
+            }
+        }
+        return tree;
+    }
+
+    // Greedy search for a large number of operands.
+    std::vector<uint32_t> nodes;
+    for (int ii = 0; ii < num; ii++) {
+        nodes.push_back(1u << ii);
+        tree.masks[1u << ii] = subset_labels(1u << ii, operand_masks, output_mask);
+    }
+    while (nodes.size() > 1) {
+        size_t best_x = 0, best_y = 1;
+        double best_cost = std::numeric_limits<double>::infinity(), best_size = best_cost;
+        for (size_t x = 0; x < nodes.size(); x++) {
+            for (size_t y = x + 1; y < nodes.size(); y++) {
+                const double cost = mask_volume(tree.masks[nodes[x]] | tree.masks[nodes[y]], sizes);
+                const double size = mask_volume(
+                        subset_labels(nodes[x] | nodes[y], operand_masks, output_mask), sizes);
+                if (cost < best_cost || (cost == best_cost && size < best_size)) {
+                    best_cost = cost;
+                    best_size = size;
+                    best_x = x;
+                    best_y = y;
+                }
+            }
+        }
+        const uint32_t merged = nodes[best_x] | nodes[best_y];
+        tree.masks[merged] = subset_labels(merged, operand_masks, output_mask);
+        tree.splits[merged] = std::make_pair(nodes[best_x], nodes[best_y]);
+        nodes.erase(nodes.begin() + best_y);
+        nodes[best_x] = merged;
+    }
+    return tree;
+}
+
+/**
+ * @brief A candidate memory layout of a pairwise contraction.
+ */
+struct StepLayout {
+    Labels left_target, right_target, result;
+    char trans_left = 'N', trans_right = 'N';
+    int64_t cost = 0;  ///< Number of elements to be copied.
+};
+
+// Decide the layout of a pairwise contraction, given the order of the batch and contracted labels.
+StepLayout make_layout(
+        const Labels& left_source,
+        const Labels& right_source,
+        const Labels& left,
+        const Labels& right,
+        const Labels& batch,
+        const Labels& contracted,
+        const Labels& free_left,
+        const Labels& free_right,
+        const std::vector<int64_t>& sizes)
+{
+    StepLayout layout;
+    // The left operand is used as [batch, m, k] ('N') or [batch, k, m] ('T').
+    if (left == batch + free_left + contracted) {
+        layout.left_target = left;
+    }
+    else if (left == batch + contracted + free_left) {
+        layout.left_target = left;
+        layout.trans_left = 'T';
+    }
+    else {
+        layout.left_target = batch + free_left + contracted;
+    }
+    // The right operand is used as [batch, k, n] ('N') or [batch, n, k] ('T').
+    if (right == batch + contracted + free_right) {
+        layout.right_target = right;
+    }
+    else if (right == batch + free_right + contracted) {
+        layout.right_target = right;
+        layout.trans_right = 'T';
+    }
+    else {
+        layout.right_target = batch + contracted + free_right;
+    }
+    if (layout.left_target != left_source) {
+        layout.cost += labels_volume(left_source, sizes);
+    }
+    if (layout.right_target != right_source) {
+        layout.cost += labels_volume(right_source, sizes);
+    }
+    layout.result = batch + free_left + free_right;
+    return layout;
+}
+
+// Choose the cheapest layout and orientation of a pairwise contraction.
+EinsumStep make_step(
+        const int& x_id,
+        const Labels& x_source,
+        const uint64_t& x_mask,
+        const int& y_id,
+        const Labels& y_source,
+        const uint64_t& y_mask,
+        const uint64_t& result_mask,
+        const Labels& output,
+        const bool& is_final,
+        const std::vector<int64_t>& sizes)
+{
+    EinsumStep best;
+    int64_t best_cost = std::numeric_limits<int64_t>::max();
+    for (int orientation = 0; orientation < 2; orientation++) {
+        const bool swap = orientation == 1;
+        const Labels& left_source = swap ? y_source : x_source;
+        const Labels& right_source = swap ? x_source : y_source;
+        const uint64_t left_mask = swap ? y_mask : x_mask;
+        const uint64_t right_mask = swap ? x_mask : y_mask;
+        // Labels private to one operand and not needed later are summed over before the GEMM.
+        const Labels left = filter(left_source, left_mask);
+        const Labels right = filter(right_source, right_mask);
+        const uint64_t shared = left_mask & right_mask;
+        const Labels free_left = filter(left, left_mask & ~shared);
+        const Labels free_right = filter(right, right_mask & ~shared);
+        // Try the order of the batch and contracted labels from either operand.
+        for (int reference = 0; reference < 2; reference++) {
+            const Labels& ref = reference == 0 ? left : right;
+            const Labels batch = filter(ref, shared & result_mask);
+            const Labels contracted = filter(ref, shared & ~result_mask);
+            StepLayout layout = make_layout(left_source, right_source, left, right,
+                                            batch, contracted, free_left, free_right, sizes);
+            if (is_final && layout.result != output) {
+                layout.cost += labels_volume(layout.result, sizes);
+            }
+            if (layout.cost < best_cost) {
+                best_cost = layout.cost;
+                best.left = swap ? y_id : x_id;
+                best.right = swap ? x_id : y_id;
+                best.left_source = left_source;
+                best.right_source = right_source;
+                best.left_target = layout.left_target;
+                best.right_target = layout.right_target;
+                best.trans_left = layout.trans_left;
+                best.trans_right = layout.trans_right;
+                best.result = layout.result;
+                best.batch = labels_volume(batch, sizes);
+                best.m = labels_volume(free_left, sizes);
+                best.n = labels_volume(free_right, sizes);
+                best.k = labels_volume(contracted, sizes);
+                best.to_output = is_final && layout.result == output;
+            }
+        }
+    }
+    return best;
+}
+
+// Flatten the contraction tree into steps, returns the operand id of the given subset.
+int build_steps(
+        const uint32_t& subset,
+        const uint32_t& full,
+        const ContractionTree& tree,
+        EinsumPlan& plan,
+        std::vector<Labels>& stored)
+{
+    if ((subset & (subset - 1)) == 0) {
+        return __builtin_ctz(subset);
+    }
+    const std::pair<uint32_t, uint32_t>& split = tree.splits.at(subset);
+    const int x = build_steps(split.first, full, tree, plan, stored);
+    const int y = build_steps(split.second, full, tree, plan, stored);
+    EinsumStep step = make_step(
+            x, stored[x], tree.masks.at(split.first),
+            y, stored[y], tree.masks.at(split.second),
+            tree.masks.at(subset), plan.output, subset == full, plan.sizes);
+    stored.push_back(step.result);
+    plan.steps.push_back(step);
+    return static_cast<int>(stored.size()) - 1;
+}
+
+std::shared_ptr<const EinsumPlan> make_plan(
+        const std::string& equation,
+        const std::vector<TensorShape>& shapes)
+{
+    std::shared_ptr<EinsumPlan> plan = std::make_shared<EinsumPlan>();
+    parse_equation(equation, shapes, *plan);
+
+    const int num = static_cast<int>(plan->inputs.size());
+    if (num == 0 || num > 32) {
+        throw std::invalid_argument("einsum: the number of operands must be between 1 and 32.");
+    }
+    std::vector<uint64_t> operand_masks;
+    for (const Labels& labels : plan->inputs) {
+        operand_masks.push_back(label_mask(labels));
+    }
+    std::vector<Labels> stored = plan->inputs;
+    const uint32_t full = (num == 32) ? ~0u : (1u << num) - 1;
+    if (num == 1) {
+        plan->final_id = 0;
+    }
+    else {
+        const ContractionTree tree = find_contraction_order(operand_masks, label_mask(plan->output), plan->sizes);
+        plan->final_id = build_steps(full, full, tree, *plan, stored);
+    }
+    plan->final_labels = stored[plan->final_id];
+    return plan;
+}
+
+// The contraction plans by equation and shapes, with the counters of einsum_cache_stats.
+struct PlanCache {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const EinsumPlan>> plans;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+PlanCache& plan_cache() {
+    static PlanCache cache;
+    return cache;
+}
+
+// Return the cached plan of the equation for the given shapes, make a new one if needed.
+std::shared_ptr<const EinsumPlan> get_plan(
+        const std::string& equation,
+        const std::vector<TensorShape>& shapes)
+{
+    PlanCache& cache = plan_cache();
+    std::ostringstream key;
+    key << equation;
+    for (const TensorShape& shape : shapes) {
+        key << ";" << shape;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.plans.find(key.str());
+        if (it != cache.plans.end()) {
+            cache.hits++;
+            return it->second;
+        }
+    }
+    std::shared_ptr<const EinsumPlan> plan = make_plan(equation, shapes);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.misses++;
+    if (cache.plans.size() >= kMaxCachedPlans) {
+        cache.plans.clear();
+    }
+    cache.plans[key.str()] = plan;
+    return plan;
+}
+
+TensorShape make_shape(const std::vector<int64_t>& dims) {
+    std::vector<int> shape;
+    for (const int64_t& dim : dims) {
+        if (dim > std::numeric_limits<int>::max()) {
+            throw std::invalid_argument("einsum: the dim size exceeds the range of TensorShape.");
+        }
+        shape.push_back(static_cast<int>(dim));
+    }
+    return TensorShape(shape);
+}
+
+TensorShape labels_shape(const Labels& labels, const std::vector<int64_t>& sizes) {
+    std::vector<int64_t> dims;
+    for (char c : labels) {
+        dims.push_back(sizes[c]);
+    }
+    return make_shape(dims);
+}
+
+/**
+ * @brief dst[dst_labels] += sum(src[src_labels]) over the labels missing in dst_labels.
+ *
+ * This covers both the transpose and the summation over private labels of an operand.
+ */
+template <typename T>
+void permute_reduce(
+        const T* src,
+        const Labels& src_labels,
+        T* dst,
+        const Labels& dst_labels,
+        const std::vector<int64_t>& sizes)
+{
+    const int ndim = static_cast<int>(src_labels.size());
+    const int64_t total = labels_volume(src_labels, sizes);
+    if (ndim == 0) {
+        dst[0] += src[0];
+        return;
+    }
+    // stride of each source axis in the destination, 0 for the reduced axes.
+    std::vector<int64_t> dims(ndim), strides(ndim, 0);
+    for (int ii = 0; ii < ndim; ii++) {
+        dims[ii] = sizes[src_labels[ii]];
+        int64_t stride = 1;
+        for (int jj = static_cast<int>(dst_labels.size()) - 1; jj >= 0; jj--) {
+            if (dst_labels[jj] == src_labels[ii]) {
+                strides[ii] = stride;
+                break;
+            }
+            stride *= sizes[dst_labels[jj]];
+        }
+    }
+    const int64_t inner = dims[ndim - 1], inner_stride = strides[ndim - 1];
+    std::vector<int64_t> index(ndim, 0);
+    int64_t offset = 0;
+    for (int64_t ii = 0; ii < total; ii += inner) {
+        T* out = dst + offset;
+        const T* in = src + ii;
+        for (int64_t jj = 0; jj < inner; jj++) {
+            out[jj * inner_stride] += in[jj];
+        }
+        // advance the outer axes.
+        for (int axis = ndim - 2; axis >= 0; axis--) {
+            offset += strides[axis];
+            if (++index[axis] < dims[axis]) {
+                break;
+            }
+            offset -= strides[axis] * dims[axis];
+            index[axis] = 0;
+        }
+    }
+}
+
+// Bring an operand into the layout required by the GEMM, returns the data pointer to be used.
+template <typename T>
+const T* prepare_operand(
+        const T* data,
+        const Labels& source,
+        const Labels& target,
+        const DataType& data_type,
+        const std::vector<int64_t>& sizes,
+        std::vector<std::unique_ptr<Tensor>>& buffers)
+{
+    if (source == target) {
+        return data;
+    }
+    buffers.emplace_back(new Tensor(data_type, labels_shape(target, sizes)));
+    Tensor& buffer = *buffers.back();
+    buffer.zero();
+    permute_reduce(data, source, buffer.data<T>(), target, sizes);
+    return buffer.data<T>();
+}
+
+template <typename T>
+void einsum_impl(
+        const EinsumPlan& plan,
+        const std::vector<const Tensor*>& operands,
+        Tensor& out)
+{
+    const DataType data_type = out.data_type();
+    const size_t num = operands.size();
+    std::vector<const T*> data(num + plan.steps.size(), nullptr);
+    std::vector<std::unique_ptr<Tensor>> results(num + plan.steps.size());
+    for (size_t ii = 0; ii < num; ii++) {
+        data[ii] = operands[ii]->data<T>();
+    }
+
+    for (size_t ii = 0; ii < plan.steps.size(); ii++) {
+        const EinsumStep& step = plan.steps[ii];
+        std::vector<std::unique_ptr<Tensor>> buffers;
+        const T* left = prepare_operand(data[step.left], step.left_source, step.left_target,
+                                        data_type, plan.sizes, buffers);
+        const T* right = prepare_operand(data[step.right], step.right_source, step.right_target,
+                                         data_type, plan.sizes, buffers);
+        T* result = nullptr;
+        if (step.to_output) {
+            result = out.data<T>();
+        }
+        else {
+            results[num + ii].reset(new Tensor(data_type, labels_shape(step.result, plan.sizes)));
+            result = results[num + ii]->data<T>();
+        }
+
+        // Batched GEMM on views of the prepared operands.
+        std::vector<int64_t> left_dims = {step.batch, step.m, step.k};
+        std::vector<int64_t> right_dims = {step.batch, step.k, step.n};
+        std::vector<int64_t> result_dims = {step.batch, step.m, step.n};
+        if (step.trans_left != 'N') std::swap(left_dims[1], left_dims[2]);
+        if (step.trans_right != 'N') std::swap(right_dims[1], right_dims[2]);
+        if (step.batch == 1) {
+            left_dims.erase(left_dims.begin());
+            right_dims.erase(right_dims.begin());
+            result_dims.erase(result_dims.begin());
+        }
+        const Tensor left_view(const_cast<T*>(left), data_type, DeviceType::CpuDevice, make_shape(left_dims));
+        const Tensor right_view(const_cast<T*>(right), data_type, DeviceType::CpuDevice, make_shape(right_dims));
+        Tensor result_view(result, data_type, DeviceType::CpuDevice, make_shape(result_dims));
+        matmul(left_view, right_view, result_view, step.trans_left, step.trans_right);
+
+        data[num + ii] = result;
+        // Intermediates are released as soon as they are consumed.
+        results[step.left].reset();
+        results[step.right].reset();
+    }
+
+    const bool written = !plan.steps.empty() && plan.steps.back().to_output;
+    if (!written) {
+        out.zero();
+        permute_reduce(data[plan.final_id], plan.final_labels, out.data<T>(), plan.output, plan.sizes);
+    }
+}
+
+} // namespace
+
+// Evaluate a tensor contraction written in Einstein summation notation.
+EinsumCacheStats einsum_cache_stats() {
+    PlanCache& cache = plan_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    EinsumCacheStats stats;
+    stats.plans = cache.plans.size();
+    stats.hits = cache.hits;
+    stats.misses = cache.misses;
+    return stats;
+}
+
+void einsum(
+        const std::string& equation,
+        const std::vector<const Tensor*>& operands,
+        Tensor& out)
+{
+    std::vector<TensorShape> shapes;
+    for (const Tensor* operand : operands) {
+        if (operand->data_type() != out.data_type()) {
+            throw std::invalid_argument("einsum: the data types of all the tensors must be the same.");
+        }
+        if (operand->device_type() != DeviceType::CpuDevice || out.device_type() != DeviceType::CpuDevice) {
+            throw std::invalid_argument("einsum: only CPU tensors are supported.");
+        }
+        shapes.push_back(operand->shape());
+    }
+    std::shared_ptr<const EinsumPlan> plan = get_plan(equation, shapes);
+    if (out.shape() != labels_shape(plan->output, plan->sizes)) {
+        throw std::invalid_argument("einsum: the shape of out does not match the output indices.");
+    }
+    // All the tensors are on the CPU, so only the data type is dispatched.
+    switch (out.data_type()) {
+        case DataType::DT_FLOAT:
+            einsum_impl<float>(*plan, operands, out);
+            break;
+        case DataType::DT_DOUBLE:
+            einsum_impl<double>(*plan, operands, out);
+            break;
+        case DataType::DT_COMPLEX:
+            einsum_impl<std::complex<float>>(*plan, operands, out);
+            break;
+        case DataType::DT_COMPLEX_DOUBLE:
+            einsum_impl<std::complex<double>>(*plan, operands, out);
+            break;
+        default:
+            throw std::invalid_argument("einsum: only floating point tensors are supported.");
+    }
+}
+
+} // namespace container
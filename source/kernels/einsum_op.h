@@ -0,0 +1,53 @@
+#ifndef CONTAINER_KERNELS_EINSUM_OP_H
+#define CONTAINER_KERNELS_EINSUM_OP_H
+
+#include <string>
+#include <vector>
+
+#include "../tensor.h"
+
+namespace container {
+
+/**
+ * @brief Evaluate a tensor contraction written in Einstein summation notation.
+ *
+ * Each index is a single letter, e.g. "ij,jk->ik", "bij,bjk->bik" or "ai,aj,jk->ik".
+ * Indices that do not appear in the output are summed over. Without "->", the output
+ * consists of the indices that appear exactly once, in alphabetical order.
+ *
+ * Operands are contracted pairwise, in the order that minimizes the number of flops
+ * (ties are broken by the size of the largest intermediate). Every pairwise step is
+ * mapped onto one (batched) `gemm_op` call through `matmul`, an operand is only transposed
+ * when its index layout can not be expressed through the BLAS transpose flags.
+ * The contraction plan is cached for repeated calls with the same equation and shapes.
+ *
+ * @param equation The contraction in Einstein summation notation.
+ * @param operands The input tensors, one for each comma separated term of the equation.
+ * @param out The preallocated output tensor, with the shape given by the output indices.
+ *
+ * @note All the tensors must have the same data type and reside on the CPU.
+ * @note Repeated indices within a single operand (traces and diagonals) are not supported.
+ * @throw std::invalid_argument if the equation and the operands do not match.
+ */
+void einsum(
+        const std::string& equation,
+        const std::vector<const Tensor*>& operands,
+        Tensor& out);
+
+/**
+ * @brief The counters of the contraction plan cache of einsum.
+ */
+struct EinsumCacheStats {
+    size_t plans = 0;   ///< Number of cached plans.
+    size_t hits = 0;    ///< Calls that reused a cached plan.
+    size_t misses = 0;  ///< Calls that made a new plan.
+};
+
+/**
+ * @brief Get the counters of the contraction plan cache, e.g. to check that a loop reuses its plans.
+ */
+EinsumCacheStats einsum_cache_stats();
+
+} // namespace container
+
+#endif // CONTAINER_KERNELS_EINSUM_OP_H
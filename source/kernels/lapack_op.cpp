@@ -1,11 +1,358 @@
 #include "lapack_op.h"
+#include "lapack_workspace.h"
+#include "blas_op.h"
+#include "memory_op.h"
+#include "../thread_pool.h"
+#include "../profiler.h"
 
+#include <cmath>
 #include <cassert>
+#include <atomic>
+#include <vector>
 #include <algorithm>
 
+#if defined(__MKL)
+#include <mkl_service.h>
+#endif
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+// The thread control of OpenBLAS, resolved at link time. Both are null with other BLAS libraries.
+extern "C" {
+int openblas_get_num_threads(void) __attribute__((weak));
+void openblas_set_num_threads(int num_threads) __attribute__((weak));
+}
+
 namespace container {
 namespace op {
 
+namespace {
+
+// Solve the generalized eigenproblem in place, A is overwritten by the eigenvectors
+// and B by its Cholesky factor.
+template <typename T>
+void hegvd_inplace(const int& nstart, const int& ldh, std::complex<T>* A, std::complex<T>* B, T* W)
+{
+    int info = 0;
+    // The workspace query is done once for every size, the buffers are kept across calls.
+    LapackWorkspace& ws = get_lapack_workspace("hegvd", DataTypeToEnum<std::complex<T>>::value, nstart);
+    if (!ws.initialized()) {
+        std::complex<T> lwork_opt = 0;
+        T lrwork_opt = 0;
+        int liwork_opt = 0;
+        LapackConnector::xhegvd(1, 'V', 'U', nstart, A, ldh, B, ldh, W,
+                                &lwork_opt, -1, &lrwork_opt, -1, &liwork_opt, -1, info);
+        assert(0 == info);
+        ws.lwork = std::max(static_cast<int>(lwork_opt.real()), 2 * nstart + nstart * nstart);
+        ws.lrwork = std::max(static_cast<int>(lrwork_opt), 1 + 5 * nstart + 2 * nstart * nstart);
+        ws.liwork = std::max(liwork_opt, 3 + 5 * nstart);
+        ws.allocate(DataTypeToEnum<std::complex<T>>::value, nstart);
+    }
+    //===========================
+    // calculate all eigenvalues
+    //===========================
+    LapackConnector::xhegvd(1, 'V', 'U', nstart, A, ldh, B, ldh, W,
+                            ws.work->data<std::complex<T>>(), ws.lwork,
+                            ws.rwork->data<T>(), ws.lrwork,
+                            ws.iwork->data<int>(), ws.liwork, info);
+
+    assert(0 == info);
+}
+
+// Compute the first nbands eigenpairs, A is destroyed.
+template <typename T>
+void heevx_inplace(const int& nstart, const int& ldh, std::complex<T>* A, const int& nbands, T* W, std::complex<T>* V)
+{
+    int info = 0;
+    int found = 0;
+    // The workspace query replaces the ilaenv based estimate of lwork, it is done once for every size.
+    LapackWorkspace& ws = get_lapack_workspace("heevx", DataTypeToEnum<std::complex<T>>::value, nstart);
+    if (!ws.initialized()) {
+        std::complex<T> lwork_opt = 0;
+        LapackConnector::xheevx(1, 'V', 'I', 'L', nstart, A, ldh, 0.0, 0.0, 1, nbands, 0.0,
+                                found, W, V, ldh, &lwork_opt, -1, nullptr, nullptr, nullptr, info);
+        assert(0 == info);
+        ws.lwork = std::max(static_cast<int>(lwork_opt.real()), 2 * nstart);
+        ws.lrwork = 7 * nstart;
+        ws.liwork = 5 * nstart;
+        ws.allocate(DataTypeToEnum<std::complex<T>>::value, nstart);
+    }
+    LapackConnector::xheevx(
+            1, // ITYPE = 1:  A*x = (lambda)*B*x
+            'V', // JOBZ = 'V':  Compute eigenvalues and eigenvectors.
+            'I', // RANGE = 'I': the IL-th through IU-th eigenvalues will be found.
+            'L', // UPLO = 'L':  Lower triangles of A and B are stored.
+            nstart, // N = base
+            A, // A is COMPLEX*16 array  dimension (LDA, N)
+            ldh, // LDA = base
+            0.0, // Not referenced if RANGE = 'A' or 'I'.
+            0.0, // Not referenced if RANGE = 'A' or 'I'.
+            1, // IL: If RANGE='I', the index of the smallest eigenvalue to be returned. 1 <= IL <= IU <= N,
+            nbands, // IU: If RANGE='I', the index of the largest eigenvalue to be returned. 1 <= IL <= IU <= N,
+            0.0, // ABSTOL
+            found, // M: The total number of eigenvalues found.  0 <= M <= N. if RANGE = 'I', M = IU-IL+1.
+            W, // W store eigenvalues
+            V, // store eigenvector
+            ldh, // LDZ: The leading dimension of the array Z.
+            ws.work->data<std::complex<T>>(),
+            ws.lwork,
+            ws.rwork->data<T>(),
+            ws.iwork->data<int>(),
+            ws.ifail->data<int>(),
+            info);
+
+    assert(0 == info);
+}
+
+// Real symmetric version of hegvd_inplace.
+template <typename T>
+void sygvd_inplace(const int& nstart, const int& ldh, T* A, T* B, T* W)
+{
+    int info = 0;
+    LapackWorkspace& ws = get_lapack_workspace("sygvd", DataTypeToEnum<T>::value, nstart);
+    if (!ws.initialized()) {
+        T lwork_opt = 0;
+        int liwork_opt = 0;
+        LapackConnector::xsygvd(1, 'V', 'U', nstart, A, ldh, B, ldh, W,
+                                &lwork_opt, -1, &liwork_opt, -1, info);
+        assert(0 == info);
+        ws.lwork = std::max(static_cast<int>(lwork_opt), 1 + 6 * nstart + 2 * nstart * nstart);
+        ws.liwork = std::max(liwork_opt, 3 + 5 * nstart);
+        ws.allocate(DataTypeToEnum<T>::value, nstart);
+    }
+    LapackConnector::xsygvd(1, 'V', 'U', nstart, A, ldh, B, ldh, W,
+                            ws.work->data<T>(), ws.lwork,
+                            ws.iwork->data<int>(), ws.liwork, info);
+
+    assert(0 == info);
+}
+
+// Compute the selected eigenpairs of a real symmetric matrix with syevr (MRRR), A is destroyed.
+// The workspace query is done with JOBZ = 'V' and RANGE = 'A', an upper bound for any other call.
+template <typename T>
+void syevr_inplace(
+        const char& jobz, const char& range, const int& nstart, const int& ldh, T* A,
+        const T& vl, const T& vu, const int& il, const int& iu, int& found, T* W, T* V)
+{
+    int info = 0;
+    LapackWorkspace& ws = get_lapack_workspace("syevr", DataTypeToEnum<T>::value, nstart);
+    if (!ws.initialized()) {
+        T lwork_opt = 0;
+        int liwork_opt = 0;
+        LapackConnector::xsyevr('V', 'A', 'L', nstart, A, ldh, 0.0, 0.0, 1, nstart, 0.0,
+                                found, W, V, ldh, nullptr, &lwork_opt, -1, &liwork_opt, -1, info);
+        assert(0 == info);
+        ws.lwork = std::max(static_cast<int>(lwork_opt), 26 * nstart);
+        ws.liwork = std::max(liwork_opt, 10 * nstart);
+        ws.allocate(DataTypeToEnum<T>::value, nstart);
+    }
+    LapackConnector::xsyevr(jobz, range, 'L', nstart, A, ldh, vl, vu, il, iu, 0.0,
+                            found, W, V, ldh, ws.ifail->data<int>(),
+                            ws.work->data<T>(), ws.lwork,
+                            ws.iwork->data<int>(), ws.liwork, info);
+
+    assert(0 == info);
+}
+
+// Complex version of syevr_inplace through heevr.
+template <typename T>
+void heevr_inplace(
+        const char& jobz, const char& range, const int& nstart, const int& ldh, std::complex<T>* A,
+        const T& vl, const T& vu, const int& il, const int& iu, int& found, T* W, std::complex<T>* V)
+{
+    int info = 0;
+    LapackWorkspace& ws = get_lapack_workspace("heevr", DataTypeToEnum<std::complex<T>>::value, nstart);
+    if (!ws.initialized()) {
+        std::complex<T> lwork_opt = 0;
+        T lrwork_opt = 0;
+        int liwork_opt = 0;
+        LapackConnector::xheevr('V', 'A', 'L', nstart, A, ldh, 0.0, 0.0, 1, nstart, 0.0,
+                                found, W, V, ldh, nullptr, &lwork_opt, -1, &lrwork_opt, -1, &liwork_opt, -1, info);
+        assert(0 == info);
+        ws.lwork = std::max(static_cast<int>(lwork_opt.real()), 2 * nstart);
+        ws.lrwork = std::max(static_cast<int>(lrwork_opt), 24 * nstart);
+        ws.liwork = std::max(liwork_opt, 10 * nstart);
+        ws.allocate(DataTypeToEnum<std::complex<T>>::value, nstart);
+    }
+    LapackConnector::xheevr(jobz, range, 'L', nstart, A, ldh, vl, vu, il, iu, 0.0,
+                            found, W, V, ldh, ws.ifail->data<int>(),
+                            ws.work->data<std::complex<T>>(), ws.lwork,
+                            ws.rwork->data<T>(), ws.lrwork,
+                            ws.iwork->data<int>(), ws.liwork, info);
+
+    assert(0 == info);
+}
+
+// Refine the approximate eigenpairs (W, V) of A x = lambda B x in the precision of T, see dngvd_mixed_op.
+// Returns the number of correction steps applied.
+template <typename T>
+int refine_eigenpairs(
+        const int& n, const int& ldh, const T* A, const T* B,
+        typename GetTypeReal<T>::type* W, T* V,
+        const typename GetTypeReal<T>::type& tol, const int& max_iter)
+{
+    using Real = typename GetTypeReal<T>::type;
+    const T one = 1.0, zero = 0.0;
+    // Five n * n buffers carved out of one cached scratch block.
+    const size_t size = static_cast<size_t>(n) * n;
+    LapackWorkspace& ws = get_lapack_workspace("refine", DataTypeToEnum<T>::value, n);
+    T* ax = ws.scratch<T>(static_cast<int64_t>(5 * size));
+    T* bx = ax + size;
+    T* s = bx + size;
+    T* g = s + size;
+    T* e = g + size;
+    for (int iter = 0; ; iter++) {
+        gemm_op<Real, DEVICE_CPU>()('N', 'N', n, n, n, &one, A, ldh, V, ldh, &zero, ax, n);
+        gemm_op<Real, DEVICE_CPU>()('N', 'N', n, n, n, &one, B, ldh, V, ldh, &zero, bx, n);
+        gemm_op<Real, DEVICE_CPU>()('C', 'N', n, n, n, &one, V, ldh, ax, n, &zero, s, n);
+        gemm_op<Real, DEVICE_CPU>()('C', 'N', n, n, n, &one, V, ldh, bx, n, &zero, g, n);
+        Real scale = 0;
+        for (int ii = 0; ii < n; ii++) {
+            W[ii] = std::real(s[ii + ii * n]) / std::real(g[ii + ii * n]);
+            scale = std::max(scale, std::abs(W[ii]));
+        }
+        if (iter == max_iter) {
+            return iter;
+        }
+        // Eigenvalues closer than delta can not be separated at the current accuracy.
+        Real residual = 0, orthogonality = 0;
+        for (int jj = 0; jj < n; jj++) {
+            for (int ii = 0; ii < n; ii++) {
+                const size_t ij = ii + static_cast<size_t>(jj) * n;
+                if (ii != jj) {
+                    residual += std::norm(s[ij] - W[jj] * g[ij]);
+                }
+                orthogonality += std::norm((ii == jj ? one : zero) - g[ij]);
+            }
+        }
+        const Real delta = 2 * (std::sqrt(residual) + scale * std::sqrt(orthogonality));
+        Real correction = 0;
+        for (int jj = 0; jj < n; jj++) {
+            for (int ii = 0; ii < n; ii++) {
+                const size_t ij = ii + static_cast<size_t>(jj) * n;
+                if (ii == jj) {
+                    e[ij] = (one - g[ij]) / Real(2);
+                }
+                else if (std::abs(W[jj] - W[ii]) > delta) {
+                    e[ij] = (s[ij] - W[jj] * g[ij]) / (W[jj] - W[ii]);
+                }
+                else {
+                    e[ij] = -g[ij] / Real(2);
+                }
+                correction = std::max(correction, std::abs(e[ij]));
+            }
+        }
+        if (correction < tol) {
+            return iter;
+        }
+        // V = V (I + E)
+        gemm_op<Real, DEVICE_CPU>()('N', 'N', n, n, n, &one, V, ldh, e, n, &zero, ax, n);
+        for (int jj = 0; jj < n; jj++) {
+            for (int ii = 0; ii < n; ii++) {
+                V[ii + static_cast<size_t>(jj) * ldh] += ax[ii + static_cast<size_t>(jj) * n];
+            }
+        }
+    }
+}
+
+// Solve in the single precision of Low, then refine in the precision of T.
+template <typename Low, typename T>
+int mixed_precision_solve(
+        const int& nstart, const int& ldh, const T* A, const T* B,
+        typename GetTypeReal<T>::type* W, T* V,
+        const typename GetTypeReal<T>::type& tol, const int& max_iter)
+{
+    using LowReal = typename GetTypeReal<Low>::type;
+    const size_t size = static_cast<size_t>(nstart) * ldh;
+    std::vector<Low> a(size), b(size), v(size);
+    std::vector<LowReal> w(nstart);
+    cast_memory_op<Low, T, DEVICE_CPU, DEVICE_CPU>()(a.data(), A, size);
+    cast_memory_op<Low, T, DEVICE_CPU, DEVICE_CPU>()(b.data(), B, size);
+    dngvd_op<LowReal, DEVICE_CPU>()(nstart, ldh, a.data(), b.data(), w.data(), v.data());
+    cast_memory_op<T, Low, DEVICE_CPU, DEVICE_CPU>()(V, v.data(), size);
+    return refine_eigenpairs(nstart, ldh, A, B, W, V, tol, max_iter);
+}
+
+std::atomic<int> batched_eigen_threads(0);
+std::atomic<int> batched_eigen_crossover(256);
+
+// Limits OpenBLAS to one thread for the lifetime of the guard, its thread count is global.
+class OpenblasSingleThread {
+  public:
+    OpenblasSingleThread()
+        : saved_(openblas_get_num_threads && openblas_set_num_threads ? openblas_get_num_threads() : 0) {
+        if (saved_ > 1) {
+            openblas_set_num_threads(1);
+        }
+    }
+    ~OpenblasSingleThread() {
+        if (saved_ > 1) {
+            openblas_set_num_threads(saved_);
+        }
+    }
+    OpenblasSingleThread(const OpenblasSingleThread&) = delete;
+    OpenblasSingleThread& operator=(const OpenblasSingleThread&) = delete;
+
+  private:
+    const int saved_;
+};
+
+// Call solve(ii) for every problem of a batch, see dngvd_batched_op for the choice of parallelism.
+template <typename Solve>
+void run_batched(const int& batch, const int& nstart, const Solve& solve)
+{
+    int num_threads = batched_eigen_threads.load();
+    if (num_threads == 0 || num_threads > get_num_threads()) {
+        num_threads = get_num_threads();
+    }
+    num_threads = std::min(num_threads, batch);
+    if (num_threads <= 1 || nstart > batched_eigen_crossover.load()) {
+        // Large problems keep all the cores busy inside LAPACK.
+        for (int ii = 0; ii < batch; ii++) {
+            solve(ii);
+        }
+        return;
+    }
+    // Small problems: one problem per thread at a time on the shared pool, the workspaces are thread-local.
+    // Each of the num_threads chunks pulls the next problem, which balances problems of uneven cost.
+    // The LAPACK calls are single-threaded so that the cores are not oversubscribed: MKL and OpenMP
+    // take a per-thread setting in every chunk, OpenBLAS a global one for the whole batch. Reference
+    // BLAS has no threads of its own.
+    const OpenblasSingleThread openblas_guard;
+    std::atomic<int> next(0);
+    parallel_for(0, num_threads, 1, [&](int64_t begin, int64_t end) {
+#if defined(__MKL)
+        const int saved = mkl_set_num_threads_local(1);
+#endif
+#if defined(_OPENMP)
+        const int saved_omp = omp_get_max_threads();
+        omp_set_num_threads(1);
+#endif
+        for (int64_t tt = begin; tt < end; tt++) {
+            for (int ii = next++; ii < batch; ii = next++) {
+                solve(ii);
+            }
+        }
+#if defined(_OPENMP)
+        omp_set_num_threads(saved_omp);
+#endif
+#if defined(__MKL)
+        mkl_set_num_threads_local(saved);
+#endif
+    });
+}
+
+} // namespace
+
+void set_batched_eigen_threads(const int& num_threads) {
+    batched_eigen_threads.store(std::max(0, num_threads));
+}
+
+void set_batched_eigen_crossover(const int& n) {
+    batched_eigen_crossover.store(n);
+}
+
 template <typename T>
 struct dngvd_op<T, DEVICE_CPU> {
     void operator()(
@@ -16,37 +363,126 @@ struct dngvd_op<T, DEVICE_CPU> {
             T *eigenvalue,
             std::complex<T> *vcc)
     {
-        for (int i = 0; i < nstart * ldh; i++) {
-            vcc[i] = hcc[i];
-        }
-        int info = 0;
-        int lwork = 2 * nstart + nstart * nstart;
-        // std::complex<T> *work = new std::complex<T>[lwork];
-        // ModuleBase::GlobalFunc::ZEROS(work, lwork);
-        Tensor work(DataTypeToEnum<std::complex<T>>::value, DeviceType::CpuDevice, {lwork});
-        work.zero();
-
-        int lrwork = 1 + 5 * nstart + 2 * nstart * nstart;
-        // T *rwork = new T[lrwork];
-        // ModuleBase::GlobalFunc::ZEROS(rwork, lrwork);
-        Tensor rwork(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {lrwork});
-        rwork.zero();
-
-        int liwork = 3 + 5 * nstart;
-        // int *iwork = new int[liwork];
-        // ModuleBase::GlobalFunc::ZEROS(iwork, liwork);
-        Tensor iwork(DataType::DT_INT, DeviceType::CpuDevice, {liwork});
-        iwork.zero();
-        //===========================
-        // calculate all eigenvalues
-        //===========================
-        LapackConnector::xhegvd(1, 'V', 'U', nstart, vcc, ldh, scc, ldh, eigenvalue, work.data<std::complex<T>>(), lwork, rwork.data<T>(), lrwork, iwork.data<int>(), liwork, info);
+        ProfileScope profile("dngvd_op", profile_type(hcc), 3.0 * sizeof(*hcc) * nstart * ldh, 0);
+        synchronize_memory_op<std::complex<T>, DEVICE_CPU, DEVICE_CPU>()(
+                vcc, hcc, static_cast<size_t>(nstart) * ldh);
+        hegvd_inplace(nstart, ldh, vcc, const_cast<std::complex<T>*>(scc), eigenvalue);
+    }
 
-        assert(0 == info);
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T *hcc,
+            const T *scc,
+            T *eigenvalue,
+            T *vcc)
+    {
+        ProfileScope profile("dngvd_op", profile_type(hcc), 3.0 * sizeof(*hcc) * nstart * ldh, 0);
+        synchronize_memory_op<T, DEVICE_CPU, DEVICE_CPU>()(
+                vcc, hcc, static_cast<size_t>(nstart) * ldh);
+        sygvd_inplace(nstart, ldh, vcc, const_cast<T*>(scc), eigenvalue);
+    }
+};
+
+template <typename T>
+struct dngvd_inplace_op<T, DEVICE_CPU> {
+    void operator()(
+            const int nstart,
+            const int ldh,
+            std::complex<T> *hcc,
+            std::complex<T> *scc,
+            T *eigenvalue)
+    {
+        ProfileScope profile("dngvd_inplace_op", profile_type(hcc), 4.0 * sizeof(*hcc) * nstart * ldh, 0);
+        hegvd_inplace(nstart, ldh, hcc, scc, eigenvalue);
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            T *hcc,
+            T *scc,
+            T *eigenvalue)
+    {
+        ProfileScope profile("dngvd_inplace_op", profile_type(hcc), 4.0 * sizeof(*hcc) * nstart * ldh, 0);
+        sygvd_inplace(nstart, ldh, hcc, scc, eigenvalue);
+    }
+};
+
+
+template <typename T>
+struct dngvd_batched_op<T, DEVICE_CPU> {
+    void operator()(
+            const int batch,
+            const int nstart,
+            const int ldh,
+            const std::complex<T> *hcc,
+            const std::complex<T> *scc,
+            T *eigenvalue,
+            std::complex<T> *vcc)
+    {
+        const int64_t size = static_cast<int64_t>(ldh) * nstart;
+        ProfileScope profile("dngvd_batched_op", profile_type(hcc), 3.0 * sizeof(*hcc) * size * batch, 0);
+        run_batched(batch, nstart, [&](const int& ii) {
+            dngvd_op<T, DEVICE_CPU>()(nstart, ldh, hcc + ii * size, scc + ii * size,
+                                      eigenvalue + ii * nstart, vcc + ii * size);
+        });
+    }
+
+    void operator()(
+            const int batch,
+            const int nstart,
+            const int ldh,
+            const T *hcc,
+            const T *scc,
+            T *eigenvalue,
+            T *vcc)
+    {
+        const int64_t size = static_cast<int64_t>(ldh) * nstart;
+        ProfileScope profile("dngvd_batched_op", profile_type(hcc), 3.0 * sizeof(*hcc) * size * batch, 0);
+        run_batched(batch, nstart, [&](const int& ii) {
+            dngvd_op<T, DEVICE_CPU>()(nstart, ldh, hcc + ii * size, scc + ii * size,
+                                      eigenvalue + ii * nstart, vcc + ii * size);
+        });
     }
 };
 
 
+template <typename T>
+struct dnevx_inplace_op<T, DEVICE_CPU> {
+    void operator()(
+            const int nstart,
+            const int ldh,
+            std::complex<T>* hcc,
+            const int nbands,
+            T* eigenvalue,
+            std::complex<T>* vcc)
+    {
+        ProfileScope profile("dnevx_inplace_op", profile_type(hcc), 2.0 * sizeof(*hcc) * nstart * ldh, 0);
+        if (vcc == nullptr) {
+            // Eigenvalues only, MRRR skips the eigenvector computation entirely.
+            int found = 0;
+            heevr_inplace<T>('N', 'I', nstart, ldh, hcc, 0.0, 0.0, 1, nbands, found, eigenvalue, nullptr);
+            return;
+        }
+        heevx_inplace(nstart, ldh, hcc, nbands, eigenvalue, vcc);
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            T* hcc,
+            const int nbands,
+            T* eigenvalue,
+            T* vcc)
+    {
+        ProfileScope profile("dnevx_inplace_op", profile_type(hcc), 2.0 * sizeof(*hcc) * nstart * ldh, 0);
+        int found = 0;
+        syevr_inplace<T>(vcc == nullptr ? 'N' : 'V', 'I', nstart, ldh, hcc, 0.0, 0.0, 1, nbands,
+                         found, eigenvalue, vcc);
+    }
+};
+
 template <typename T>
 struct dnevx_op<T, DEVICE_CPU> {
     void operator()(
@@ -57,81 +493,247 @@ struct dnevx_op<T, DEVICE_CPU> {
             T* eigenvalue, // eigenvalue
             std::complex<T>* vcc) // vcc
     {
-        std::complex<T>* aux = new std::complex<T>[nstart * ldh];
-        for (int ii = 0; ii < nstart * ldh; ii++) {
-            aux[ii] = hcc[ii];
-        }
+        // The A and B storage space is (nstart * ldh), and the data that really participates in the zhegvx
+        // operation is (nstart * nstart). zheevx destroys A, so A is copied into a scratch buffer
+        // kept with the workspace. V is the output of the function, the storage space is also (nstart * ldh).
+        ProfileScope profile("dnevx_op", profile_type(hcc), 2.0 * sizeof(*hcc) * nstart * ldh, 0);
+        LapackWorkspace& ws = get_lapack_workspace("heevx", DataTypeToEnum<std::complex<T>>::value, nstart);
+        std::complex<T>* aux = ws.scratch<std::complex<T>>(static_cast<int64_t>(nstart) * ldh);
+        synchronize_memory_op<std::complex<T>, DEVICE_CPU, DEVICE_CPU>()(
+                aux, hcc, static_cast<size_t>(nstart) * ldh);
+        dnevx_inplace_op<T, DEVICE_CPU>()(nstart, ldh, aux, nbands, eigenvalue, vcc);
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T* hcc,
+            const int nbands,
+            T* eigenvalue,
+            T* vcc)
+    {
+        ProfileScope profile("dnevx_op", profile_type(hcc), 2.0 * sizeof(*hcc) * nstart * ldh, 0);
+        LapackWorkspace& ws = get_lapack_workspace("syevr", DataTypeToEnum<T>::value, nstart);
+        T* aux = ws.scratch<T>(static_cast<int64_t>(nstart) * ldh);
+        synchronize_memory_op<T, DEVICE_CPU, DEVICE_CPU>()(
+                aux, hcc, static_cast<size_t>(nstart) * ldh);
+        dnevx_inplace_op<T, DEVICE_CPU>()(nstart, ldh, aux, nbands, eigenvalue, vcc);
+    }
+};
 
+template <typename T>
+struct dnevr_op<T, DEVICE_CPU> {
+    void operator()(
+            const char jobz,
+            const char range,
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* hcc,
+            const T vl,
+            const T vu,
+            const int il,
+            const int iu,
+            int& m,
+            T* eigenvalue,
+            std::complex<T>* vcc)
+    {
+        ProfileScope profile("dnevr_op", profile_type(hcc), 2.0 * sizeof(*hcc) * nstart * ldh, 0);
+        LapackWorkspace& ws = get_lapack_workspace("heevr", DataTypeToEnum<std::complex<T>>::value, nstart);
+        std::complex<T>* aux = ws.scratch<std::complex<T>>(static_cast<int64_t>(nstart) * ldh);
+        synchronize_memory_op<std::complex<T>, DEVICE_CPU, DEVICE_CPU>()(
+                aux, hcc, static_cast<size_t>(nstart) * ldh);
+        heevr_inplace<T>(jobz, range, nstart, ldh, aux, vl, vu, il, iu, m, eigenvalue, vcc);
+    }
+
+    void operator()(
+            const char jobz,
+            const char range,
+            const int nstart,
+            const int ldh,
+            const T* hcc,
+            const T vl,
+            const T vu,
+            const int il,
+            const int iu,
+            int& m,
+            T* eigenvalue,
+            T* vcc)
+    {
+        ProfileScope profile("dnevr_op", profile_type(hcc), 2.0 * sizeof(*hcc) * nstart * ldh, 0);
+        LapackWorkspace& ws = get_lapack_workspace("syevr", DataTypeToEnum<T>::value, nstart);
+        T* aux = ws.scratch<T>(static_cast<int64_t>(nstart) * ldh);
+        synchronize_memory_op<T, DEVICE_CPU, DEVICE_CPU>()(
+                aux, hcc, static_cast<size_t>(nstart) * ldh);
+        syevr_inplace<T>(jobz, range, nstart, ldh, aux, vl, vu, il, iu, m, eigenvalue, vcc);
+    }
+};
+
+template <typename T>
+struct potrf_op<T, DEVICE_CPU> {
+    void operator()(
+            const char uplo,
+            const int n,
+            std::complex<T>* A,
+            const int lda)
+    {
+        ProfileScope profile("potrf_op", profile_type(A), sizeof(*A) * static_cast<double>(n) * n,
+                             profile_flops(A, static_cast<double>(n) * n * n / 3.0));
         int info = 0;
-        int lwork = 0;
-        int nb = LapackConnector::ilaenv(1, "ZHETRD", "L", nstart, -1, -1, -1);
-        if (nb < 1) {
-            nb = std::max(1, nstart);
-        }
+        LapackConnector::xpotrf(uplo, n, A, lda, info);
+        assert(0 == info);
+    }
 
-        if (nb == 1 || nb >= nstart) {
-            lwork = 2 * nstart; // qianrui fix a bug 2021-7-25 : lwork should be at least max(1,2*n)
-        } else {
-            lwork = (nb + 1) * nstart;
-        }
-        // T *rwork = new T[7 * nstart];
-        // int *iwork = new int[5 * nstart];
-        // int *ifail = new int[nstart];
-        // ModuleBase::GlobalFunc::ZEROS(rwork, 7 * nstart);
-        // ModuleBase::GlobalFunc::ZEROS(iwork, 5 * nstart);
-        // ModuleBase::GlobalFunc::ZEROS(ifail, nstart);
-        // important part:
-        // In davidson, the size of work is different from dnevx_op in diagH_subspace.
-        // std::complex<T> *work = new std::complex<T>[2 * lwork];
-        Tensor rwork(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {7 * nstart});
-        Tensor iwork(DataType::DT_INT, DeviceType::CpuDevice, {5 * nstart});
-        Tensor ifail(DataType::DT_INT, DeviceType::CpuDevice, {nstart});
-        Tensor work(DataTypeToEnum<std::complex<T>>::value, DeviceType::CpuDevice, {2 * lwork});
-        // ModuleBase::GlobalFunc::ZEROS(work, lwork); // qianrui change it, only first lwork numbers are used in zhegvx
-        rwork.zero();
-        iwork.zero();
-        ifail.zero();
-        work.zero();
-        // The A and B storage space is (nstart * ldh), and the data that really participates in the zhegvx
-        // operation is (nstart * nstart). In this function, the data that A and B participate in the operation will
-        // be extracted into the new local variables aux and bux (the internal of the function).
-        // V is the output of the function, the storage space is also (nstart * ldh), and the data size of valid V
-        // obtained by the zhegvx operation is (nstart * nstart) and stored in zux (internal to the function). When
-        // the function is output, the data of zux will be mapped to the corresponding position of V.
-        LapackConnector::xheevx(
-                1, // ITYPE = 1:  A*x = (lambda)*B*x
-                'V', // JOBZ = 'V':  Compute eigenvalues and eigenvectors.
-                'I', // RANGE = 'I': the IL-th through IU-th eigenvalues will be found.
-                'L', // UPLO = 'L':  Lower triangles of A and B are stored.
-                nstart, // N = base
-                aux, // A is COMPLEX*16 array  dimension (LDA, N)
-                ldh, // LDA = base
-                0.0, // Not referenced if RANGE = 'A' or 'I'.
-                0.0, // Not referenced if RANGE = 'A' or 'I'.
-                1, // IL: If RANGE='I', the index of the smallest eigenvalue to be returned. 1 <= IL <= IU <= N,
-                nbands, // IU: If RANGE='I', the index of the largest eigenvalue to be returned. 1 <= IL <= IU <= N,
-                0.0, // ABSTOL
-                nbands, // M: The total number of eigenvalues found.  0 <= M <= N. if RANGE = 'I', M = IU-IL+1.
-                eigenvalue, // W store eigenvalues
-                vcc, // store eigenvector
-                ldh, // LDZ: The leading dimension of the array Z.
-                work.data<std::complex<T>>(),
-                lwork,
-                rwork.data<T>(),
-                iwork.data<int>(),
-                ifail.data<int>(),
-                info);
-
-        delete[] aux;
+    void operator()(
+            const char uplo,
+            const int n,
+            T* A,
+            const int lda)
+    {
+        ProfileScope profile("potrf_op", profile_type(A), sizeof(*A) * static_cast<double>(n) * n,
+                             profile_flops(A, static_cast<double>(n) * n * n / 3.0));
+        int info = 0;
+        LapackConnector::xpotrf(uplo, n, A, lda, info);
+        assert(0 == info);
+    }
+};
+
+template <typename T>
+struct hegst_op<T, DEVICE_CPU> {
+    void operator()(
+            const int itype,
+            const char uplo,
+            const int n,
+            std::complex<T>* A,
+            const int lda,
+            const std::complex<T>* B,
+            const int ldb)
+    {
+        ProfileScope profile("hegst_op", profile_type(A), 1.5 * sizeof(*A) * n * n,
+                             profile_flops(A, static_cast<double>(n) * n * n));
+        int info = 0;
+        LapackConnector::xhegst(itype, uplo, n, A, lda, B, ldb, info);
+        assert(0 == info);
+    }
 
+    void operator()(
+            const int itype,
+            const char uplo,
+            const int n,
+            T* A,
+            const int lda,
+            const T* B,
+            const int ldb)
+    {
+        ProfileScope profile("hegst_op", profile_type(A), 1.5 * sizeof(*A) * n * n,
+                             profile_flops(A, static_cast<double>(n) * n * n));
+        int info = 0;
+        LapackConnector::xhegst(itype, uplo, n, A, lda, B, ldb, info);
         assert(0 == info);
     }
 };
 
+template <typename T>
+struct dngvd_factored_op<T, DEVICE_CPU> {
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* hcc,
+            const std::complex<T>* lcc,
+            T* eigenvalue,
+            std::complex<T>* vcc)
+    {
+        ProfileScope profile("dngvd_factored_op", profile_type(hcc), 3.0 * sizeof(*hcc) * nstart * ldh, 0);
+        // C = L^-1 A L^-H in the lower triangle of a scratch copy of A, C y = lambda y, x = L^-H y.
+        LapackWorkspace& ws = get_lapack_workspace("heevr", DataTypeToEnum<std::complex<T>>::value, nstart);
+        std::complex<T>* aux = ws.scratch<std::complex<T>>(static_cast<int64_t>(nstart) * ldh);
+        synchronize_memory_op<std::complex<T>, DEVICE_CPU, DEVICE_CPU>()(
+                aux, hcc, static_cast<size_t>(nstart) * ldh);
+        hegst_op<T, DEVICE_CPU>()(1, 'L', nstart, aux, ldh, lcc, ldh);
+        int found = 0;
+        heevr_inplace<T>('V', 'A', nstart, ldh, aux, 0.0, 0.0, 1, nstart, found, eigenvalue, vcc);
+        const std::complex<T> one = 1.0;
+        trsm_op<T, DEVICE_CPU>()('L', 'L', 'C', 'N', nstart, nstart, &one, lcc, ldh, vcc, ldh);
+    }
+
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T* hcc,
+            const T* lcc,
+            T* eigenvalue,
+            T* vcc)
+    {
+        ProfileScope profile("dngvd_factored_op", profile_type(hcc), 3.0 * sizeof(*hcc) * nstart * ldh, 0);
+        LapackWorkspace& ws = get_lapack_workspace("syevr", DataTypeToEnum<T>::value, nstart);
+        T* aux = ws.scratch<T>(static_cast<int64_t>(nstart) * ldh);
+        synchronize_memory_op<T, DEVICE_CPU, DEVICE_CPU>()(
+                aux, hcc, static_cast<size_t>(nstart) * ldh);
+        hegst_op<T, DEVICE_CPU>()(1, 'L', nstart, aux, ldh, lcc, ldh);
+        int found = 0;
+        syevr_inplace<T>('V', 'A', nstart, ldh, aux, 0.0, 0.0, 1, nstart, found, eigenvalue, vcc);
+        const T one = 1.0;
+        trsm_op<T, DEVICE_CPU>()('L', 'L', 'T', 'N', nstart, nstart, &one, lcc, ldh, vcc, ldh);
+    }
+};
+
+template <typename T>
+struct dngvd_mixed_op<T, DEVICE_CPU> {
+    int operator()(
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* hcc,
+            const std::complex<T>* scc,
+            T* eigenvalue,
+            std::complex<T>* vcc,
+            const T tol,
+            const int max_iter)
+    {
+        ProfileScope profile("dngvd_mixed_op", profile_type(hcc), 3.0 * sizeof(*hcc) * nstart * ldh, 0);
+        return mixed_precision_solve<std::complex<float>>(nstart, ldh, hcc, scc, eigenvalue, vcc, tol, max_iter);
+    }
+
+    int operator()(
+            const int nstart,
+            const int ldh,
+            const T* hcc,
+            const T* scc,
+            T* eigenvalue,
+            T* vcc,
+            const T tol,
+            const int max_iter)
+    {
+        ProfileScope profile("dngvd_mixed_op", profile_type(hcc), 3.0 * sizeof(*hcc) * nstart * ldh, 0);
+        return mixed_precision_solve<float>(nstart, ldh, hcc, scc, eigenvalue, vcc, tol, max_iter);
+    }
+};
+
 template struct dngvd_op<float, DEVICE_CPU>;
 template struct dngvd_op<double, DEVICE_CPU>;
 
 template struct dnevx_op<float, DEVICE_CPU>;
 template struct dnevx_op<double, DEVICE_CPU>;
+
+template struct dnevr_op<float, DEVICE_CPU>;
+template struct dnevr_op<double, DEVICE_CPU>;
+
+template struct potrf_op<float, DEVICE_CPU>;
+template struct potrf_op<double, DEVICE_CPU>;
+
+template struct hegst_op<float, DEVICE_CPU>;
+template struct hegst_op<double, DEVICE_CPU>;
+
+template struct dngvd_factored_op<float, DEVICE_CPU>;
+template struct dngvd_factored_op<double, DEVICE_CPU>;
+
+template struct dngvd_mixed_op<double, DEVICE_CPU>;
+
+template struct dngvd_batched_op<float, DEVICE_CPU>;
+template struct dngvd_batched_op<double, DEVICE_CPU>;
+
+template struct dngvd_inplace_op<float, DEVICE_CPU>;
+template struct dngvd_inplace_op<double, DEVICE_CPU>;
+
+template struct dnevx_inplace_op<float, DEVICE_CPU>;
+template struct dnevx_inplace_op<double, DEVICE_CPU>;
 } // namespace container
 } // namespace op
\ No newline at end of file
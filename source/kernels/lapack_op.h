@@ -62,6 +62,9 @@ struct dngvd_op {
     /// @brief DNGVD computes all the eigenvalues and eigenvectors of a complex generalized
     /// Hermitian-definite eigenproblem. If eigenvectors are desired, it uses a divide and conquer algorithm.
     ///
+    /// Real symmetric problems (e.g. gamma-only calculations) are dispatched to the real overload,
+    /// which works on real storage and arithmetic.
+    ///
     /// In this op, the CPU version is implemented through the `gvd` interface, and the CUDA version
     /// is implemented through the `gvd` interface.
     /// API doc:
@@ -73,7 +76,7 @@ struct dngvd_op {
     ///     @param nstart : the number of cols of the matrix
     ///     @param ldh : the number of rows of the matrix
     ///     @param A : the hermitian matrix A in A x=lambda B x (col major)
-    ///     @param B : the overlap matrix B in A x=lambda B x (col major)
+    ///     @param B : the overlap matrix B in A x=lambda B x (col major), overwritten by its Cholesky factor
     /// Output Parameter
     ///     @param W : calculated eigenvalues
     ///     @param V : calculated eigenvectors (col major)
@@ -84,6 +87,15 @@ struct dngvd_op {
             const std::complex<T>* B,
             T* W,
             std::complex<T>* V);
+
+    /// @brief The real symmetric-definite version, implemented through `sygvd` (cusolverDnDsygvd).
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T* A,
+            const T* B,
+            T* W,
+            T* V);
 };
 
 
@@ -92,6 +104,8 @@ struct dnevx_op {
     /// @brief DNEVX computes the first m eigenvalues ​​and their corresponding eigenvectors of
     /// a complex generalized Hermitian-definite eigenproblem
     ///
+    /// Real symmetric matrices are dispatched to the real overload.
+    ///
     /// In this op, the CPU version is implemented through the `evx` interface, and the CUDA version
     /// is implemented through the `evd` interface and acquires the first m eigenpairs.
     /// API doc:
@@ -105,7 +119,8 @@ struct dnevx_op {
     ///     @param A : the hermitian matrix A in A x=lambda B x (row major)
     /// Output Parameter
     ///     @param W : calculated eigenvalues
-    ///     @param V : calculated eigenvectors (row major)
+    ///     @param V : calculated eigenvectors (row major), nullptr to compute the eigenvalues only
+    ///                through the MRRR path of dnevr_op (CPU)
     void operator()(
             const int nstart,
             const int ldh,
@@ -113,8 +128,348 @@ struct dnevx_op {
             const int m,
             T* W,
             std::complex<T>* V);
+
+    /// @brief The real symmetric version, implemented through `syevr` (cusolverDnDsyevd).
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T* A,
+            const int m,
+            T* W,
+            T* V);
+};
+
+
+template <typename T, typename Device>
+struct dnevr_op {
+    /// @brief DNEVR computes selected eigenvalues and, optionally, eigenvectors of a Hermitian
+    /// (real symmetric) matrix with the MRRR algorithm.
+    ///
+    /// MRRR is usually much faster than `evx` when the lowest nbands eigenpairs of a large matrix are wanted,
+    /// and with jobz = 'N' no eigenvectors are computed at all (band-structure previews, convergence checks).
+    /// The CPU version is implemented through `heevr` (`syevr`), the CUDA version through `heevdx` (`syevdx`).
+    /// API doc:
+    /// 1. zheevr: https://netlib.org/lapack/explore-html/d9/dd2/zheevr_8f.html
+    /// 2. cusolverDnZheevdx: https://docs.nvidia.com/cuda/cusolver/index.html#cusolverdn-t-syevdx
+    ///
+    /// Input Parameters
+    ///     @param jobz : 'V' to compute the eigenvectors, 'N' for eigenvalues only (V is not referenced)
+    ///     @param range : 'A' all the eigenvalues, 'V' the ones in (vl, vu], 'I' the il-th to the iu-th
+    ///     @param nstart : the number of cols of the matrix
+    ///     @param ldh : the number of rows of the matrix
+    ///     @param A : the hermitian matrix A (col major), the lower triangle is referenced
+    ///     @param vl, vu : the interval of eigenvalues if range = 'V'
+    ///     @param il, iu : the 1-based indices of the first and last eigenvalues if range = 'I'
+    /// Output Parameter
+    ///     @param m : the number of eigenvalues found
+    ///     @param W : calculated eigenvalues in ascending order, at least nstart elements
+    ///     @param V : calculated eigenvectors (col major), ldh x m
+    void operator()(
+            const char jobz,
+            const char range,
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* A,
+            const T vl,
+            const T vu,
+            const int il,
+            const int iu,
+            int& m,
+            T* W,
+            std::complex<T>* V);
+
+    /// @brief The real symmetric version, implemented through `syevr` (cusolverDnDsyevdx).
+    void operator()(
+            const char jobz,
+            const char range,
+            const int nstart,
+            const int ldh,
+            const T* A,
+            const T vl,
+            const T vu,
+            const int il,
+            const int iu,
+            int& m,
+            T* W,
+            T* V);
+};
+
+
+template <typename T, typename Device>
+struct dngvd_inplace_op {
+    /// @brief The overwrite-input mode of dngvd_op, LAPACK works directly on the caller's buffers.
+    ///
+    /// Use it when the Hamiltonian is not needed after the call, it saves the copy of A into V.
+    ///
+    /// Input Parameters
+    ///     @param nstart : the number of cols of the matrix
+    ///     @param ldh : the number of rows of the matrix
+    ///     @param A : the hermitian matrix A in A x=lambda B x (col major)
+    ///     @param B : the overlap matrix B in A x=lambda B x (col major)
+    /// Output Parameter
+    ///     @param A : calculated eigenvectors (col major)
+    ///     @param B : the Cholesky factor of B
+    ///     @param W : calculated eigenvalues
+    void operator()(
+            const int nstart,
+            const int ldh,
+            std::complex<T>* A,
+            std::complex<T>* B,
+            T* W);
+
+    /// @brief The real symmetric-definite version.
+    void operator()(
+            const int nstart,
+            const int ldh,
+            T* A,
+            T* B,
+            T* W);
+};
+
+
+template <typename T, typename Device>
+struct dnevx_inplace_op {
+    /// @brief The overwrite-input mode of dnevx_op, LAPACK works directly on the caller's A.
+    ///
+    /// Use it when the Hamiltonian is not needed after the call, it saves the scratch copy of A.
+    ///
+    /// Input Parameters
+    ///     @param nstart : the number of cols of the matrix
+    ///     @param ldh : the number of rows of the matrix
+    ///     @param A : the hermitian matrix A (row major), destroyed on exit
+    ///     @param m : the number of eigenpairs to calculate
+    /// Output Parameter
+    ///     @param W : calculated eigenvalues
+    ///     @param V : calculated eigenvectors (row major), nullptr to compute the eigenvalues only
+    void operator()(
+            const int nstart,
+            const int ldh,
+            std::complex<T>* A,
+            const int m,
+            T* W,
+            std::complex<T>* V);
+
+    /// @brief The real symmetric version.
+    void operator()(
+            const int nstart,
+            const int ldh,
+            T* A,
+            const int m,
+            T* W,
+            T* V);
+};
+
+
+template <typename T, typename Device>
+struct potrf_op {
+    /// @brief POTRF computes the Cholesky factorization of a Hermitian (real symmetric) positive definite
+    /// matrix, B = L L^H (uplo = 'L') or B = U^H U (uplo = 'U').
+    ///
+    /// Factorize the overlap matrix once per geometry and pass the factor to dngvd_factored_op,
+    /// which saves the factorization that dngvd_op repeats on every call.
+    ///
+    /// Input Parameters
+    ///     @param uplo : 'L' or 'U', the triangle of A that is referenced and overwritten
+    ///     @param n : the order of the matrix
+    ///     @param A : the positive definite matrix (col major)
+    ///     @param lda : the leading dimension of A
+    /// Output Parameter
+    ///     @param A : the Cholesky factor in the uplo triangle, the other triangle is not referenced
+    void operator()(
+            const char uplo,
+            const int n,
+            std::complex<T>* A,
+            const int lda);
+
+    /// @brief The real symmetric version.
+    void operator()(
+            const char uplo,
+            const int n,
+            T* A,
+            const int lda);
+};
+
+
+template <typename T, typename Device>
+struct hegst_op {
+    /// @brief HEGST reduces the generalized eigenproblem A x = lambda B x (itype = 1) to the standard form
+    /// C y = lambda y, with C = L^-1 A L^-H (uplo = 'L') or C = U^-H A U^-1 (uplo = 'U') and x = L^-H y
+    /// (x = U^-1 y), where B has been factorized by potrf_op with the same uplo.
+    ///
+    /// The CPU version is implemented through `hegst` (`sygst`) and overwrites the uplo triangle of A.
+    /// The CUDA version is implemented through two triangular solves and needs the full matrix A,
+    /// only itype = 1 is supported.
+    ///
+    /// Input Parameters
+    ///     @param itype : 1 for A x = lambda B x
+    ///     @param uplo : 'L' or 'U', the triangle of the factor
+    ///     @param n : the order of the matrices
+    ///     @param A : the hermitian matrix A (col major)
+    ///     @param lda : the leading dimension of A
+    ///     @param B : the Cholesky factor of B from potrf_op (col major)
+    ///     @param ldb : the leading dimension of B
+    /// Output Parameter
+    ///     @param A : the matrix C of the standard problem
+    void operator()(
+            const int itype,
+            const char uplo,
+            const int n,
+            std::complex<T>* A,
+            const int lda,
+            const std::complex<T>* B,
+            const int ldb);
+
+    /// @brief The real symmetric version.
+    void operator()(
+            const int itype,
+            const char uplo,
+            const int n,
+            T* A,
+            const int lda,
+            const T* B,
+            const int ldb);
+};
+
+
+template <typename T, typename Device>
+struct dngvd_factored_op {
+    /// @brief Solve A x = lambda B x with the prefactored overlap B = L L^H, see dngvd_op.
+    ///
+    /// The problem is reduced to the standard form by hegst_op, solved by `heevr` (cusolverDnZheevd on GPU)
+    /// and the eigenvectors are transformed back with trsm_op. Compared with dngvd_op, the O(n^3)
+    /// Cholesky factorization of B is done once by potrf_op (uplo = 'L') and reused across the calls,
+    /// e.g. the SCF iterations at a fixed geometry.
+    ///
+    /// Input Parameters
+    ///     @param nstart : the number of cols of the matrix
+    ///     @param ldh : the number of rows of the matrix
+    ///     @param A : the hermitian matrix A in A x=lambda B x (col major), all elements are referenced
+    ///     @param L : the lower Cholesky factor of B from potrf_op (col major), not modified
+    /// Output Parameter
+    ///     @param W : calculated eigenvalues
+    ///     @param V : calculated eigenvectors (col major)
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* A,
+            const std::complex<T>* L,
+            T* W,
+            std::complex<T>* V);
+
+    /// @brief The real symmetric-definite version.
+    void operator()(
+            const int nstart,
+            const int ldh,
+            const T* A,
+            const T* L,
+            T* W,
+            T* V);
+};
+
+
+template <typename T, typename Device>
+struct dngvd_mixed_op {
+    /// @brief Solve A x = lambda B x in single precision with dngvd_op<float>, then refine the eigenpairs
+    /// to double accuracy, see dngvd_op.
+    ///
+    /// The refinement is the iteration of Ogita and Aishima generalized to B != I: with S = X^H A X and
+    /// G = X^H B X, the eigenvalues are lambda_i = S_ii / G_ii and the eigenvectors are updated as X (I + E),
+    /// E_ij = (S_ij - lambda_j G_ij) / (lambda_j - lambda_i) and E_ii = (1 - G_ii) / 2. Eigenvalues closer
+    /// than the current error estimate are treated as a cluster, E_ij = -G_ij / 2. Each step costs five
+    /// double precision gemm_op calls and converges quadratically, A and B are not modified.
+    ///
+    /// Only T = double is instantiated, on CPU.
+    ///
+    /// Input Parameters
+    ///     @param nstart : the number of cols of the matrix
+    ///     @param ldh : the number of rows of the matrix
+    ///     @param A : the hermitian matrix A in A x=lambda B x (col major), all elements are referenced
+    ///     @param B : the overlap matrix B in A x=lambda B x (col major), all elements are referenced
+    ///     @param tol : stop when the largest element of the correction E is below tol
+    ///     @param max_iter : the maximum number of refinement steps
+    /// Output Parameter
+    ///     @param W : calculated eigenvalues
+    ///     @param V : calculated eigenvectors (col major)
+    /// @return the number of refinement steps done
+    int operator()(
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* A,
+            const std::complex<T>* B,
+            T* W,
+            std::complex<T>* V,
+            const T tol = 1e-12,
+            const int max_iter = 5);
+
+    /// @brief The real symmetric-definite version.
+    int operator()(
+            const int nstart,
+            const int ldh,
+            const T* A,
+            const T* B,
+            T* W,
+            T* V,
+            const T tol = 1e-12,
+            const int max_iter = 5);
+};
+
+
+template <typename T, typename Device>
+struct dngvd_batched_op {
+    /// @brief Solve a batch of independent generalized Hermitian-definite eigenproblems, see dngvd_op.
+    ///
+    /// The problems are stacked, the i-th problem uses A + i * ldh * nstart, B + i * ldh * nstart,
+    /// W + i * nstart and V + i * ldh * nstart.
+    ///
+    /// On CPU, problems not larger than the crossover size are spread over threads, each solving
+    /// whole problems with a single-threaded LAPACK call (MKL, OpenBLAS or an OpenMP-threaded BLAS)
+    /// and its own workspace. Larger problems are solved one after another, leaving the parallelism
+    /// to the LAPACK library.
+    ///
+    /// Input Parameters
+    ///     @param batch : the number of problems
+    ///     @param nstart : the number of cols of each matrix
+    ///     @param ldh : the number of rows of each matrix
+    ///     @param A : the hermitian matrices A (col major)
+    ///     @param B : the overlap matrices B (col major), overwritten by their Cholesky factors
+    /// Output Parameter
+    ///     @param W : calculated eigenvalues
+    ///     @param V : calculated eigenvectors (col major)
+    void operator()(
+            const int batch,
+            const int nstart,
+            const int ldh,
+            const std::complex<T>* A,
+            const std::complex<T>* B,
+            T* W,
+            std::complex<T>* V);
+
+    /// @brief The real symmetric-definite version.
+    void operator()(
+            const int batch,
+            const int nstart,
+            const int ldh,
+            const T* A,
+            const T* B,
+            T* W,
+            T* V);
 };
 
+/**
+ * @brief Set the number of threads of the batched eigensolvers on CPU.
+ *
+ * @param num_threads The number of threads, 0 (default) uses all the threads of the shared pool
+ *                    (see set_num_threads), larger values are capped to the size of the pool.
+ */
+void set_batched_eigen_threads(const int& num_threads);
+
+/**
+ * @brief Set the largest problem size solved with batch-level parallelism.
+ *
+ * @param n The crossover size, larger problems use the LAPACK-internal parallelism. The default is 256.
+ */
+void set_batched_eigen_crossover(const int& n);
+
 
 #if __CUDA || __UT_USE_CUDA || __ROCM || __UT_USE_ROCM
 void createCusolverHandle();
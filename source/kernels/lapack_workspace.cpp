@@ -0,0 +1,47 @@
+#include "lapack_workspace.h"
+
+#include <map>
+#include <tuple>
+#include <algorithm>
+
+namespace container {
+namespace op {
+
+namespace {
+
+typedef std::tuple<std::string, DataType, int> WorkspaceKey;
+
+std::map<WorkspaceKey, LapackWorkspace>& workspaces() {
+    static thread_local std::map<WorkspaceKey, LapackWorkspace> cache;
+    return cache;
+}
+
+DataType real_type(const DataType& data_type) {
+    if (data_type == DataType::DT_COMPLEX) {
+        return DataType::DT_FLOAT;
+    }
+    if (data_type == DataType::DT_COMPLEX_DOUBLE) {
+        return DataType::DT_DOUBLE;
+    }
+    return data_type;
+}
+
+} // namespace
+
+void LapackWorkspace::allocate(const DataType& data_type, const int& n) {
+    work.reset(new Tensor(data_type, DeviceType::CpuDevice, {std::max(1, lwork)}));
+    rwork.reset(new Tensor(real_type(data_type), DeviceType::CpuDevice, {std::max(1, lrwork)}));
+    iwork.reset(new Tensor(DataType::DT_INT, DeviceType::CpuDevice, {std::max(1, liwork)}));
+    ifail.reset(new Tensor(DataType::DT_INT, DeviceType::CpuDevice, {2 * std::max(1, n)}));
+}
+
+LapackWorkspace& get_lapack_workspace(const std::string& routine, const DataType& data_type, const int& n) {
+    return workspaces()[WorkspaceKey(routine, data_type, n)];
+}
+
+void clear_lapack_workspace() {
+    workspaces().clear();
+}
+
+} // namespace op
+} // namespace container
@@ -0,0 +1,68 @@
+#ifndef CONTAINER_KERNELS_LAPACK_WORKSPACE_H
+#define CONTAINER_KERNELS_LAPACK_WORKSPACE_H
+
+#include <memory>
+#include <string>
+
+#include "../tensor.h"
+#include "../tensor_types.h"
+
+namespace container {
+namespace op {
+
+/**
+ * @brief The workspace buffers of a LAPACK routine for a given problem size.
+ *
+ * The sizes are filled in by the workspace query (lwork = -1) of the routine on the first use,
+ * the buffers are kept across calls and are never zeroed, LAPACK does not read their content.
+ */
+struct LapackWorkspace {
+    int lwork = 0;  ///< Size of work, in elements of the data type of the routine.
+    int lrwork = 0; ///< Size of rwork, in elements of the real type of the routine.
+    int liwork = 0; ///< Size of iwork.
+    std::unique_ptr<Tensor> work;  ///< Main workspace, complex for the complex routines.
+    std::unique_ptr<Tensor> rwork; ///< Real workspace of the complex routines.
+    std::unique_ptr<Tensor> iwork; ///< Integer workspace.
+    std::unique_ptr<Tensor> ifail; ///< Indices of the unconverged eigenvectors (xxxevx), or the support of the eigenvectors (xxxevr).
+    std::unique_ptr<Tensor> a;     ///< Scratch copy of the input matrix, grown on demand.
+
+    /// @brief Whether the workspace query has been done.
+    bool initialized() const { return work != nullptr; }
+
+    /// @brief Allocate the buffers after the sizes have been set, without zeroing them.
+    void allocate(const DataType& data_type, const int& n);
+
+    /// @brief Get a scratch matrix with at least the given number of elements.
+    template <typename T>
+    T* scratch(const int64_t& size) {
+        if (a == nullptr || a->NumElements() < size) {
+            a.reset(new Tensor(DataTypeToEnum<T>::value, DeviceType::CpuDevice, {size}));
+        }
+        return a->data<T>();
+    }
+};
+
+/**
+ * @brief Get the workspace of a LAPACK routine, keyed by (routine, data type, n).
+ *
+ * The workspaces are thread-local, so that concurrent solves never share buffers and no
+ * locking is needed. The same-size eigensolves of an SCF loop only pay for the workspace
+ * query and the allocation once.
+ *
+ * @param routine The name of the routine, e.g. "hegvd".
+ * @param data_type The data type of the matrix.
+ * @param n The order of the matrix.
+ *
+ * @return The workspace, check `initialized()` before use.
+ */
+LapackWorkspace& get_lapack_workspace(const std::string& routine, const DataType& data_type, const int& n);
+
+/**
+ * @brief Release all the LAPACK workspaces of the calling thread.
+ */
+void clear_lapack_workspace();
+
+} // namespace op
+} // namespace container
+
+#endif // CONTAINER_KERNELS_LAPACK_WORKSPACE_H
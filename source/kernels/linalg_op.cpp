@@ -0,0 +1,198 @@
+#include "linalg_op.h"
+#include "blas_op.h"
+
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace container {
+
+namespace {
+
+/**
+ * @brief The BLAS parameters of a row-major (batched) matrix multiplication.
+ */
+struct MatmulShape {
+    int batch = 1;  ///< Number of independent products.
+    int m = 0;      ///< Rows of op(a) and out.
+    int n = 0;      ///< Columns of op(b) and out.
+    int k = 0;      ///< Columns of op(a) and rows of op(b).
+    int lda = 0;    ///< Row length of a.
+    int ldb = 0;    ///< Row length of b.
+    int64_t stride_a = 0; ///< Element stride between the batches of a, 0 if a is broadcast.
+    int64_t stride_b = 0; ///< Element stride between the batches of b, 0 if b is broadcast.
+    int64_t stride_c = 0; ///< Element stride between the batches of out.
+};
+
+// Convert the user given scalar to the data type of the tensor.
+template <typename T>
+struct scalar_cast {
+    static T value(const std::complex<double>& x) { return static_cast<T>(x.real()); }
+};
+template <typename T>
+struct scalar_cast<std::complex<T>> {
+    static std::complex<T> value(const std::complex<double>& x) { return std::complex<T>(x); }
+};
+
+// Narrow a dimension to the int of the BLAS interface.
+int blas_dim(const int64_t& dim) {
+    if (dim > std::numeric_limits<int>::max()) {
+        throw std::invalid_argument("matmul: a dimension exceeds the range of the BLAS integer type.");
+    }
+    return static_cast<int>(dim);
+}
+
+// Check the operands of matmul and derive the BLAS parameters.
+MatmulShape get_matmul_shape(
+        const Tensor& a,
+        const Tensor& b,
+        const Tensor& out,
+        const char& trans_a,
+        const char& trans_b)
+{
+    if ((trans_a != 'N' && trans_a != 'T' && trans_a != 'C') ||
+        (trans_b != 'N' && trans_b != 'T' && trans_b != 'C')) {
+        throw std::invalid_argument("matmul: transpose flags must be one of 'N', 'T' or 'C'.");
+    }
+    if (a.data_type() != b.data_type() || a.data_type() != out.data_type()) {
+        throw std::invalid_argument("matmul: the data types of a, b and out must be the same.");
+    }
+    if (a.device_type() != b.device_type() || a.device_type() != out.device_type()) {
+        throw std::invalid_argument("matmul: the device types of a, b and out must be the same.");
+    }
+    const int rank_a = static_cast<int>(a.shape().ndim());
+    const int rank_b = static_cast<int>(b.shape().ndim());
+    if (rank_a < 2 || rank_a > 3 || rank_b < 2 || rank_b > 3) {
+        throw std::invalid_argument("matmul: only rank-2 and rank-3 operands are supported.");
+    }
+    const int rank_c = std::max(rank_a, rank_b);
+    if (static_cast<int>(out.shape().ndim()) != rank_c) {
+        throw std::invalid_argument("matmul: the rank of out does not match the operands.");
+    }
+
+    MatmulShape s;
+    const int a_rows = blas_dim(a.shape().dim_size(rank_a - 2)), a_cols = blas_dim(a.shape().dim_size(rank_a - 1));
+    const int b_rows = blas_dim(b.shape().dim_size(rank_b - 2)), b_cols = blas_dim(b.shape().dim_size(rank_b - 1));
+    s.m = trans_a == 'N' ? a_rows : a_cols;
+    s.k = trans_a == 'N' ? a_cols : a_rows;
+    s.n = trans_b == 'N' ? b_cols : b_rows;
+    if ((trans_b == 'N' ? b_rows : b_cols) != s.k) {
+        throw std::invalid_argument("matmul: the inner dimensions of op(a) and op(b) do not match.");
+    }
+    s.lda = std::max(1, a_cols);
+    s.ldb = std::max(1, b_cols);
+
+    if (rank_c == 3) {
+        s.batch = blas_dim(rank_a == 3 ? a.shape().dim_size(0) : b.shape().dim_size(0));
+        if (rank_a == 3 && rank_b == 3 && a.shape().dim_size(0) != b.shape().dim_size(0)) {
+            throw std::invalid_argument("matmul: the batch sizes of a and b do not match.");
+        }
+        if (out.shape().dim_size(0) != s.batch) {
+            throw std::invalid_argument("matmul: the batch size of out does not match the operands.");
+        }
+        s.stride_a = rank_a == 3 ? static_cast<int64_t>(a_rows) * a_cols : 0;
+        s.stride_b = rank_b == 3 ? static_cast<int64_t>(b_rows) * b_cols : 0;
+    }
+    if (out.shape().dim_size(rank_c - 2) != s.m || out.shape().dim_size(rank_c - 1) != s.n) {
+        throw std::invalid_argument("matmul: the shape of out does not match op(a) * op(b).");
+    }
+    s.stride_c = static_cast<int64_t>(s.m) * s.n;
+
+    // A stacked a multiplied by a shared b is a single product with batch * m rows.
+    if (s.batch > 1 && rank_a == 3 && rank_b == 2 && trans_a == 'N') {
+        s.m = blas_dim(static_cast<int64_t>(s.m) * s.batch);
+        s.batch = 1;
+    }
+    return s;
+}
+
+// Compute a row-major product c = alpha * op(a) * op(b) + beta * c through the column-major
+// blas ops, i.e. c^T = alpha * op(b)^T * op(a)^T + beta * c^T, the transpose flags pass through unchanged.
+template <typename T, typename Device>
+void matmul_2d(
+        const char& trans_a,
+        const char& trans_b,
+        const int& m,
+        const int& n,
+        const int& k,
+        const T& alpha,
+        const T* a,
+        const int& lda,
+        const T* b,
+        const int& ldb,
+        const T& beta,
+        T* c)
+{
+    using Real = typename GetTypeReal<T>::type;
+    // gemv returns early for k == 0 without applying beta, gemm scales c by beta.
+    if (k > 0 && m == 1 && trans_a != 'C') {
+        // c^T = op(b)^T * a^T, a is a contiguous vector.
+        const int rows = trans_b == 'N' ? n : k;
+        const int cols = trans_b == 'N' ? k : n;
+        op::gemv_op<Real, Device>()(trans_b, rows, cols, &alpha, b, ldb, a, 1, &beta, c, 1);
+    }
+    else if (k > 0 && n == 1 && trans_a != 'C' && trans_b != 'C') {
+        // c = op(a) * b, the column-major view of a row-major a is a^T.
+        const char trans = trans_a == 'N' ? 'T' : 'N';
+        const int rows = trans_a == 'N' ? k : m;
+        const int cols = trans_a == 'N' ? m : k;
+        op::gemv_op<Real, Device>()(trans, rows, cols, &alpha, a, lda, b, 1, &beta, c, 1);
+    }
+    else {
+        op::gemm_op<Real, Device>()(trans_b, trans_a, n, m, k, &alpha, b, ldb, a, lda, &beta, c, n);
+    }
+}
+
+template <typename T, typename Device>
+void matmul_impl(
+        const Tensor& a,
+        const Tensor& b,
+        Tensor& out,
+        const MatmulShape& s,
+        const char& trans_a,
+        const char& trans_b,
+        const std::complex<double>& alpha,
+        const std::complex<double>& beta)
+{
+    const T alpha_ = scalar_cast<T>::value(alpha);
+    const T beta_ = scalar_cast<T>::value(beta);
+    const T* a_ = a.data<T>();
+    const T* b_ = b.data<T>();
+    T* c_ = out.data<T>();
+    for (int ii = 0; ii < s.batch; ii++) {
+        matmul_2d<T, Device>(
+                trans_a, trans_b, s.m, s.n, s.k,
+                alpha_, a_ + ii * s.stride_a, s.lda,
+                b_ + ii * s.stride_b, s.ldb,
+                beta_, c_ + ii * s.stride_c);
+    }
+}
+
+} // namespace
+
+// Tensor-level matrix multiplication, out = alpha * op(a) * op(b) + beta * out.
+void matmul(
+        const Tensor& a,
+        const Tensor& b,
+        Tensor& out,
+        const char& trans_a,
+        const char& trans_b,
+        const std::complex<double>& alpha,
+        const std::complex<double>& beta)
+{
+    const MatmulShape s = get_matmul_shape(a, b, out, trans_a, trans_b);
+    if (a.data_type() == DataType::DT_INT || a.data_type() == DataType::DT_INT64) {
+        throw std::invalid_argument("matmul: only floating point tensors are supported.");
+    }
+    // The conjugate transpose of real data is a plain transpose.
+    const bool is_real = a.data_type() == DataType::DT_FLOAT || a.data_type() == DataType::DT_DOUBLE;
+    const char op_a = is_real && trans_a == 'C' ? 'T' : trans_a;
+    const char op_b = is_real && trans_b == 'C' ? 'T' : trans_b;
+    if (s.m == 0 || s.n == 0) {
+        return;
+    }
+    TEMPLATE_SDCZ_2(a.data_type(), a.device_type(),
+            matmul_impl<T_, DEVICE_>(a, b, out, s, op_a, op_b, alpha, beta))
+}
+
+} // namespace container
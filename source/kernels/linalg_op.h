@@ -0,0 +1,44 @@
+#ifndef CONTAINER_KERNELS_LINALG_OP_H
+#define CONTAINER_KERNELS_LINALG_OP_H
+
+#include <complex>
+
+#include "../tensor.h"
+#include "../tensor_types.h"
+
+namespace container {
+
+/**
+ * @brief Tensor-level matrix multiplication, out = alpha * op(a) * op(b) + beta * out.
+ *
+ * All tensors are row-major. The operands are mapped onto the column-major `gemm_op`
+ * without any temporary copies, and the cheapest BLAS call is chosen for the given
+ * operand shapes and transpose flags:
+ *  - rank-2 x rank-2: a single `gemv_op` when the output is a vector, otherwise `gemm_op`;
+ *  - rank-3 x rank-2 with trans_a == 'N': the batch is folded into the rows of a single `gemm_op`;
+ *  - other rank-3 inputs: one `gemm_op` per batch (batched GEMM), a rank-2 operand is broadcast.
+ *
+ * @param a The left operand, with shape [M, K] ([K, M] if transposed) or [batch, M, K].
+ * @param b The right operand, with shape [K, N] ([N, K] if transposed) or [batch, K, N].
+ * @param out The preallocated output tensor with shape [M, N] or [batch, M, N].
+ * @param trans_a 'N', 'T' or 'C' (conjugate transpose) applied to a, 'C' is the same as 'T' for real data.
+ * @param trans_b 'N', 'T' or 'C' (conjugate transpose) applied to b.
+ * @param alpha The scale factor of op(a) * op(b), only the real part is used for real data.
+ * @param beta The scale factor of the original out.
+ *
+ * @note The data type and device type of a, b and out must be the same, float, double,
+ *       complex<float> and complex<double> are supported.
+ * @throw std::invalid_argument if the shapes, types or transpose flags are not compatible.
+ */
+void matmul(
+        const Tensor& a,
+        const Tensor& b,
+        Tensor& out,
+        const char& trans_a = 'N',
+        const char& trans_b = 'N',
+        const std::complex<double>& alpha = 1.0,
+        const std::complex<double>& beta = 0.0);
+
+} // namespace container
+
+#endif // CONTAINER_KERNELS_LINALG_OP_H
@@ -1,7 +1,10 @@
 #include <iostream>
+#include <algorithm>
 #include <complex>
 #include <string.h>
 #include "memory_op.h"
+#include "../thread_pool.h"
+#include "../profiler.h"
 
 namespace container {
 namespace op {
@@ -19,7 +22,10 @@ struct resize_memory_op<T, container::DEVICE_CPU> {
 template <typename T>
 struct set_memory_op<T, container::DEVICE_CPU> {
   void operator()(T* arr, const int var, const size_t size) {
-    memset(arr, var, sizeof(T) * size);
+    ProfileScope profile("set_memory_op", DataTypeToEnum<T>::value, sizeof(T) * size, 0);
+    parallel_for(0, size, parallel_grain_size<T>(), [&](int64_t begin, int64_t end) {
+        memset(arr + begin, var, sizeof(T) * (end - begin));
+    });
   }
 };
 
@@ -28,7 +34,10 @@ struct synchronize_memory_op<T, container::DEVICE_CPU, container::DEVICE_CPU> {
   void operator()(T* arr_out,
                   const T* arr_in,
                   const size_t size) {
-    memcpy(arr_out, arr_in, sizeof(T) * size);
+    ProfileScope profile("synchronize_memory_op", DataTypeToEnum<T>::value, 2.0 * sizeof(T) * size, 0);
+    parallel_for(0, size, parallel_grain_size<T>(), [&](int64_t begin, int64_t end) {
+        memcpy(arr_out + begin, arr_in + begin, sizeof(T) * (end - begin));
+    });
   }
 };
 
@@ -37,9 +46,13 @@ struct cast_memory_op<FPTYPE_out, FPTYPE_in, container::DEVICE_CPU, container::D
     void operator()(FPTYPE_out* arr_out,
                     const FPTYPE_in* arr_in,
                     const size_t size) {
-        for (int ii = 0; ii < size; ii++) {
-            arr_out[ii] = static_cast<FPTYPE_out>(arr_in[ii]);
-        }
+        ProfileScope profile("cast_memory_op", DataTypeToEnum<FPTYPE_out>::value,
+                             (sizeof(FPTYPE_in) + sizeof(FPTYPE_out)) * static_cast<double>(size), 0);
+        parallel_for(0, size, parallel_grain_size<FPTYPE_out>(), [&](int64_t begin, int64_t end) {
+            for (int64_t ii = begin; ii < end; ii++) {
+                arr_out[ii] = static_cast<FPTYPE_out>(arr_in[ii]);
+            }
+        });
     }
 };
 
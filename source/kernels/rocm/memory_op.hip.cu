@@ -14,9 +14,9 @@ template <typename FPTYPE_out, typename FPTYPE_in>
 __global__ void cast_memory(
         FPTYPE_out* out,
         const FPTYPE_in* in,
-        const int size)
+        const int64_t size)
 {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
     if(idx >= size) {return;}
     out[idx] = static_cast<FPTYPE_out>(in[idx]);
 }
@@ -25,9 +25,9 @@ template <typename FPTYPE_out, typename FPTYPE_in>
 __global__ void cast_memory(
         std::complex<FPTYPE_out>* out,
         const std::complex<FPTYPE_in>* in,
-        const int size)
+        const int64_t size)
 {
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
     if(idx >= size) {return;}
     auto* _out = reinterpret_cast<thrust::complex<FPTYPE_out>*>(out);
     const auto* _in = reinterpret_cast<const thrust::complex<FPTYPE_in>*>(in);
@@ -118,7 +118,7 @@ struct cast_memory_op<FPTYPE_out, FPTYPE_in, container::DEVICE_CPU, container::D
                     const size_t size) {
         auto * arr = (FPTYPE_in*) malloc(sizeof(FPTYPE_in) * size);
         hipMemcpy(arr, arr_in, sizeof(FPTYPE_in) * size, hipMemcpyDeviceToHost);
-        for (int ii = 0; ii < size; ii++) {
+        for (int64_t ii = 0; ii < size; ii++) {
             arr_out[ii] = static_cast<FPTYPE_out>(arr[ii]);
         }
         free(arr);
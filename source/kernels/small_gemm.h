@@ -0,0 +1,237 @@
+#ifndef CONTAINER_KERNELS_SMALL_GEMM_H
+#define CONTAINER_KERNELS_SMALL_GEMM_H
+
+#include <complex>
+
+#include "../tensor_types.h"
+
+namespace container {
+namespace op {
+namespace small_gemm {
+
+// Largest m, n and k handled by the small GEMM kernels, sizes the packing buffers.
+static const int kMaxDim = 32;
+
+// Default size threshold, around the measured crossover with an optimized BLAS (OpenBLAS),
+// whose call overhead is only amortized beyond about 8 x 8 blocks. With a heavier BLAS
+// dispatch (e.g. MKL with small sizes) the threshold may be raised up to kMaxDim.
+static const int kDefaultThreshold = 8;
+
+// Load op(X)(row, col) from a column-major matrix, conjugation is left to the caller.
+template <typename T>
+inline const T& op_value(const char& trans, const T* x, const int& ldx, const int& row, const int& col) {
+    return trans == 'N' ? x[row + col * ldx] : x[col + row * ldx];
+}
+
+// Pack op(A) (m x k) column by column into ap with leading dimension mp, and op(B) (k x n)
+// row by row into bp with leading dimension np, so that the micro-kernel reads MR (NR)
+// contiguous values for every k. The padding is zero so that no remainder loop is needed.
+template <typename T>
+inline void pack(
+        const char& trans, const int& rows, const int& cols, const int& padded,
+        const T* x, const int& ldx, const bool& row_major, T* xp)
+{
+    for (int l = 0; l < cols; l++) {
+        int i = 0;
+        for (; i < rows; i++) {
+            xp[l * padded + i] = row_major ? op_value(trans, x, ldx, l, i) : op_value(trans, x, ldx, i, l);
+        }
+        for (; i < padded; i++) {
+            xp[l * padded + i] = T(0);
+        }
+    }
+}
+
+// Complex data is packed into separate real and imaginary planes, so that the micro-kernel
+// vectorizes over contiguous values and avoids the NaN-checking std::complex multiplication.
+template <typename T>
+inline void pack(
+        const char& trans, const int& rows, const int& cols, const int& padded,
+        const std::complex<T>* x, const int& ldx, const bool& row_major, T* xp_re, T* xp_im)
+{
+    const T sign = trans == 'C' ? T(-1) : T(1);
+    for (int l = 0; l < cols; l++) {
+        int i = 0;
+        for (; i < rows; i++) {
+            const std::complex<T>& v = row_major ? op_value(trans, x, ldx, l, i) : op_value(trans, x, ldx, i, l);
+            xp_re[l * padded + i] = v.real();
+            xp_im[l * padded + i] = sign * v.imag();
+        }
+        for (; i < padded; i++) {
+            xp_re[l * padded + i] = T(0);
+            xp_im[l * padded + i] = T(0);
+        }
+    }
+}
+
+// Register-blocked MR x NR micro-kernel, acc = sum_l ap(:, l) * bp(l, :).
+// For every l the MR contiguous values of ap are loaded once and multiplied with NR broadcast
+// values of bp, the whole MR x NR block of accumulators stays in registers across the k loop.
+template <typename T, int MR, int NR>
+inline void micro_kernel(const int& k, const T* ap, const int& mp, const T* bp, const int& np, T (&acc)[NR][MR]) {
+    for (int j = 0; j < NR; j++) {
+        for (int i = 0; i < MR; i++) {
+            acc[j][i] = T(0);
+        }
+    }
+    for (int l = 0; l < k; l++) {
+        const T* a_l = ap + l * mp;
+        const T* b_l = bp + l * np;
+        for (int j = 0; j < NR; j++) {
+            const T b_lj = b_l[j];
+            for (int i = 0; i < MR; i++) {
+                acc[j][i] += a_l[i] * b_lj;
+            }
+        }
+    }
+}
+
+template <typename T, int MR, int NR>
+inline void micro_kernel(
+        const int& k,
+        const T* ap_re, const T* ap_im, const int& mp,
+        const T* bp_re, const T* bp_im, const int& np,
+        T (&re)[NR][MR], T (&im)[NR][MR])
+{
+    for (int j = 0; j < NR; j++) {
+        for (int i = 0; i < MR; i++) {
+            re[j][i] = T(0);
+            im[j][i] = T(0);
+        }
+    }
+    for (int l = 0; l < k; l++) {
+        const T* ar = ap_re + l * mp;
+        const T* ai = ap_im + l * mp;
+        for (int j = 0; j < NR; j++) {
+            const T br = bp_re[l * np + j], bi = bp_im[l * np + j];
+            for (int i = 0; i < MR; i++) {
+                re[j][i] += ar[i] * br - ai[i] * bi;
+                im[j][i] += ar[i] * bi + ai[i] * br;
+            }
+        }
+    }
+}
+
+// C = alpha * op(A) * op(B) + beta * C with MR x NR register blocks, column-major like gemm_op.
+// As in BLAS, C is not read when beta is zero.
+template <typename T, int MR, int NR>
+void gemm_blocked(
+        const char& transa, const char& transb,
+        const int& m, const int& n, const int& k,
+        const T& alpha, const T* a, const int& lda, const T* b, const int& ldb,
+        const T& beta, T* c, const int& ldc)
+{
+    const int mp = (m + MR - 1) / MR * MR;
+    const int np = (n + NR - 1) / NR * NR;
+    T ap[kMaxDim * kMaxDim], bp[kMaxDim * kMaxDim];
+    pack(transa, m, k, mp, a, lda, false, ap);
+    pack(transb, n, k, np, b, ldb, true, bp);
+
+    T acc[NR][MR];
+    for (int jj = 0; jj < n; jj += NR) {
+        for (int ii = 0; ii < m; ii += MR) {
+            micro_kernel<T, MR, NR>(k, ap + ii, mp, bp + jj, np, acc);
+            const int rows = m - ii < MR ? m - ii : MR;
+            const int cols = n - jj < NR ? n - jj : NR;
+            for (int j = 0; j < cols; j++) {
+                T* c_j = c + (jj + j) * ldc + ii;
+                for (int i = 0; i < rows; i++) {
+                    c_j[i] = beta == T(0) ? alpha * acc[j][i] : alpha * acc[j][i] + beta * c_j[i];
+                }
+            }
+        }
+    }
+}
+
+template <typename T, int MR, int NR>
+void gemm_blocked(
+        const char& transa, const char& transb,
+        const int& m, const int& n, const int& k,
+        const std::complex<T>& alpha, const std::complex<T>* a, const int& lda,
+        const std::complex<T>* b, const int& ldb,
+        const std::complex<T>& beta, std::complex<T>* c, const int& ldc)
+{
+    const int mp = (m + MR - 1) / MR * MR;
+    const int np = (n + NR - 1) / NR * NR;
+    T ap_re[kMaxDim * kMaxDim], ap_im[kMaxDim * kMaxDim];
+    T bp_re[kMaxDim * kMaxDim], bp_im[kMaxDim * kMaxDim];
+    pack(transa, m, k, mp, a, lda, false, ap_re, ap_im);
+    pack(transb, n, k, np, b, ldb, true, bp_re, bp_im);
+
+    const bool zero_beta = beta == std::complex<T>(0);
+    T re[NR][MR], im[NR][MR];
+    for (int jj = 0; jj < n; jj += NR) {
+        for (int ii = 0; ii < m; ii += MR) {
+            micro_kernel<T, MR, NR>(k, ap_re + ii, ap_im + ii, mp, bp_re + jj, bp_im + jj, np, re, im);
+            const int rows = m - ii < MR ? m - ii : MR;
+            const int cols = n - jj < NR ? n - jj : NR;
+            for (int j = 0; j < cols; j++) {
+                std::complex<T>* c_j = c + (jj + j) * ldc + ii;
+                for (int i = 0; i < rows; i++) {
+                    T r = alpha.real() * re[j][i] - alpha.imag() * im[j][i];
+                    T s = alpha.real() * im[j][i] + alpha.imag() * re[j][i];
+                    if (!zero_beta) {
+                        r += beta.real() * c_j[i].real() - beta.imag() * c_j[i].imag();
+                        s += beta.real() * c_j[i].imag() + beta.imag() * c_j[i].real();
+                    }
+                    c_j[i] = std::complex<T>(r, s);
+                }
+            }
+        }
+    }
+}
+
+// Block sizes for each data type, chosen so that the MR x NR accumulators take half of the
+// 16 SSE2 vector registers (8 registers of 2 doubles or 4 floats, complex blocks keep a real
+// and an imaginary plane), the rest holds the loaded column of ap and the broadcast values of bp.
+template <typename T>
+struct BlockSize {
+    static const int MR = 4;
+    static const int NR = 4;
+};
+template <>
+struct BlockSize<float> {
+    static const int MR = 8;
+    static const int NR = 4;
+};
+template <>
+struct BlockSize<std::complex<double>> {
+    static const int MR = 4;
+    static const int NR = 2;
+};
+template <>
+struct BlockSize<std::complex<float>> {
+    static const int MR = 8;
+    static const int NR = 2;
+};
+
+/**
+ * @brief Small GEMM without BLAS, see gemm_op.
+ *
+ * Tiny products (m, n <= 4) use a 4 x 4 block so that the padding does not dominate,
+ * larger ones use the BlockSize of the data type.
+ *
+ * @note m, n and k must not exceed kMaxDim.
+ */
+template <typename T>
+void gemm(
+        const char& transa, const char& transb,
+        const int& m, const int& n, const int& k,
+        const T& alpha, const T* a, const int& lda, const T* b, const int& ldb,
+        const T& beta, T* c, const int& ldc)
+{
+    if (m <= 4 && n <= 4) {
+        gemm_blocked<typename GetTypeReal<T>::type, 4, 4>(
+                transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+    else {
+        gemm_blocked<typename GetTypeReal<T>::type, BlockSize<T>::MR, BlockSize<T>::NR>(
+                transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+}
+
+} // namespace small_gemm
+} // namespace op
+} // namespace container
+
+#endif // CONTAINER_KERNELS_SMALL_GEMM_H
@@ -0,0 +1,231 @@
+#include "stats_op.h"
+#include "../thread_pool.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace container {
+
+namespace {
+
+/**
+ * @brief The statistics of a chunk, combined by merge().
+ */
+struct PartialStats {
+    int64_t num_nan = 0;
+    int64_t num_inf = 0;
+    double min = std::numeric_limits<double>::infinity();   ///< Of the keys, see StatsTraits.
+    double max = -std::numeric_limits<double>::infinity();
+    double sum_real = 0.0;
+    double sum_imag = 0.0;
+    double sum_squares = 0.0;
+};
+
+PartialStats merge(const PartialStats& a, const PartialStats& b) {
+    PartialStats result;
+    result.num_nan = a.num_nan + b.num_nan;
+    result.num_inf = a.num_inf + b.num_inf;
+    result.min = std::min(a.min, b.min);
+    result.max = std::max(a.max, b.max);
+    result.sum_real = a.sum_real + b.sum_real;
+    result.sum_imag = a.sum_imag + b.sum_imag;
+    result.sum_squares = a.sum_squares + b.sum_squares;
+    return result;
+}
+
+// The per-element quantities. Real values are ordered by value, complex values by the squared
+// absolute value, which avoids a square root per element.
+template <typename T>
+struct StatsTraits {
+    static double key(const T& x) { return static_cast<double>(x); }
+    static double value(const double& key) { return key; }
+    static double real(const T& x) { return static_cast<double>(x); }
+    static double imag(const T&) { return 0.0; }
+    static double abs2(const T& x) { return static_cast<double>(x) * static_cast<double>(x); }
+    // 0 if finite, NaN otherwise.
+    static T finite_check(const T& x) { return x - x; }
+    static bool is_nan(const T& x) { return x != x; }
+};
+
+template <typename T>
+struct StatsTraits<std::complex<T>> {
+    static double key(const std::complex<T>& x) { return abs2(x); }
+    static double value(const double& key) { return std::sqrt(key); }
+    static double real(const std::complex<T>& x) { return x.real(); }
+    static double imag(const std::complex<T>& x) { return x.imag(); }
+    static double abs2(const std::complex<T>& x) {
+        return static_cast<double>(x.real()) * x.real() + static_cast<double>(x.imag()) * x.imag();
+    }
+    static T finite_check(const std::complex<T>& x) { return (x.real() - x.real()) + (x.imag() - x.imag()); }
+    static bool is_nan(const std::complex<T>& x) { return x.real() != x.real() || x.imag() != x.imag(); }
+};
+
+// Reduce a chunk with NaN or Inf elements, element by element.
+template <typename T>
+PartialStats reduce_checked(const T* data, const int64_t& begin, const int64_t& end) {
+    typedef StatsTraits<T> Traits;
+    PartialStats result;
+    for (int64_t ii = begin; ii < end; ii++) {
+        if (Traits::finite_check(data[ii]) == Traits::finite_check(data[ii])) {
+            const double key = Traits::key(data[ii]);
+            result.min = std::min(result.min, key);
+            result.max = std::max(result.max, key);
+            result.sum_real += Traits::real(data[ii]);
+            result.sum_imag += Traits::imag(data[ii]);
+            result.sum_squares += Traits::abs2(data[ii]);
+        }
+        else if (Traits::is_nan(data[ii])) {
+            result.num_nan++;
+        }
+        else {
+            result.num_inf++;
+        }
+    }
+    return result;
+}
+
+// Reduce a chunk without branches, the compiler can vectorize this loop.
+template <typename T>
+PartialStats reduce_chunk(const T* data, const int64_t& begin, const int64_t& end) {
+    typedef StatsTraits<T> Traits;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum_real = 0.0, sum_imag = 0.0, sum_squares = 0.0;
+    T check = T(0);
+    for (int64_t ii = begin; ii < end; ii++) {
+        const double key = Traits::key(data[ii]);
+        min = key < min ? key : min;
+        max = key > max ? key : max;
+        sum_real += Traits::real(data[ii]);
+        sum_imag += Traits::imag(data[ii]);
+        sum_squares += Traits::abs2(data[ii]);
+        check += Traits::finite_check(data[ii]);
+    }
+    if (check != check) {
+        return reduce_checked(data, begin, end);
+    }
+    PartialStats result;
+    result.min = min;
+    result.max = max;
+    result.sum_real = sum_real;
+    result.sum_imag = sum_imag;
+    result.sum_squares = sum_squares;
+    return result;
+}
+
+template <typename T>
+TensorStats compute_stats(const T* data, const int64_t& n) {
+    const PartialStats partial = parallel_reduce(
+            0, n, parallel_grain_size<T>(), PartialStats(),
+            [&](int64_t begin, int64_t end, PartialStats init) {
+                return merge(init, reduce_chunk(data, begin, end));
+            },
+            merge);
+    TensorStats result;
+    result.num_elements = n;
+    result.num_nan = partial.num_nan;
+    result.num_inf = partial.num_inf;
+    result.norm = std::sqrt(partial.sum_squares);
+    const int64_t num_finite = n - partial.num_nan - partial.num_inf;
+    if (num_finite == 0) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        result.min = result.max = nan;
+        result.mean = nan;
+        return result;
+    }
+    result.min = StatsTraits<T>::value(partial.min);
+    result.max = StatsTraits<T>::value(partial.max);
+    result.mean = std::complex<double>(partial.sum_real, partial.sum_imag) / static_cast<double>(num_finite);
+    return result;
+}
+
+// Whether n real values are all finite: x - x is 0 for finite x and NaN otherwise.
+template <typename T>
+bool real_all_finite(const T* data, const int64_t& n) {
+    return parallel_reduce(
+            0, n, parallel_grain_size<T>(), true,
+            [&](int64_t begin, int64_t end, bool init) {
+                T check = T(0);
+                for (int64_t ii = begin; ii < end; ii++) {
+                    check += data[ii] - data[ii];
+                }
+                return init && check == check;
+            },
+            [](bool a, bool b) { return a && b; });
+}
+
+} // namespace
+
+TensorStats stats(const Tensor& tensor) {
+    if (tensor.device_type() != DeviceType::CpuDevice) {
+        return stats(tensor.to_device<DEVICE_CPU>());
+    }
+    const int64_t n = tensor.NumElements();
+    switch (tensor.data_type()) {
+        case DataType::DT_FLOAT:
+            return compute_stats(tensor.data<float>(), n);
+        case DataType::DT_DOUBLE:
+            return compute_stats(tensor.data<double>(), n);
+        case DataType::DT_INT:
+            return compute_stats(tensor.data<int>(), n);
+        case DataType::DT_INT64:
+            return compute_stats(tensor.data<int64_t>(), n);
+        case DataType::DT_COMPLEX:
+            return compute_stats(tensor.data<std::complex<float>>(), n);
+        case DataType::DT_COMPLEX_DOUBLE:
+            return compute_stats(tensor.data<std::complex<double>>(), n);
+        default:
+            throw std::invalid_argument("stats: unsupported data type.");
+    }
+}
+
+bool all_finite(const Tensor& tensor) {
+    if (tensor.device_type() != DeviceType::CpuDevice) {
+        return all_finite(tensor.to_device<DEVICE_CPU>());
+    }
+    const int64_t n = tensor.NumElements();
+    switch (tensor.data_type()) {
+        case DataType::DT_INT:
+        case DataType::DT_INT64:
+            return true;
+        case DataType::DT_FLOAT:
+            return real_all_finite(tensor.data<float>(), n);
+        case DataType::DT_DOUBLE:
+            return real_all_finite(tensor.data<double>(), n);
+        // The real and imaginary parts are checked as 2n reals.
+        case DataType::DT_COMPLEX:
+            return real_all_finite(reinterpret_cast<const float*>(tensor.data<std::complex<float>>()), 2 * n);
+        case DataType::DT_COMPLEX_DOUBLE:
+            return real_all_finite(reinterpret_cast<const double*>(tensor.data<std::complex<double>>()), 2 * n);
+        default:
+            throw std::invalid_argument("all_finite: unsupported data type.");
+    }
+}
+
+std::string describe(const Tensor& tensor) {
+    std::ostringstream os;
+    os << "Tensor(shape=[";
+    for (unsigned int ii = 0; ii < tensor.shape().ndim(); ii++) {
+        os << (ii == 0 ? "" : ",") << tensor.shape().dim_size(ii);
+    }
+    os << "], data_type=" << tensor.data_type();
+    os << ", device_type=" << tensor.device_type() << "): " << stats(tensor);
+    return os.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const TensorStats& stats) {
+    os << "min=" << stats.min << ", max=" << stats.max << ", mean=";
+    if (stats.mean.imag() == 0.0) {
+        os << stats.mean.real();
+    }
+    else {
+        os << stats.mean;
+    }
+    os << ", norm=" << stats.norm << ", nan=" << stats.num_nan << ", inf=" << stats.num_inf;
+    return os;
+}
+
+} // namespace container
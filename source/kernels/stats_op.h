@@ -0,0 +1,66 @@
+#ifndef CONTAINER_KERNELS_STATS_OP_H
+#define CONTAINER_KERNELS_STATS_OP_H
+
+#include <string>
+#include <complex>
+#include <ostream>
+
+#include "../tensor.h"
+
+namespace container {
+
+/**
+ * @brief Summary statistics of the elements of a tensor.
+ *
+ * NaN and Inf elements are counted but otherwise excluded, so that a few diverged elements do
+ * not hide the magnitude of the rest. For complex data min and max are taken over the absolute
+ * values. min, max and mean are NaN if there are no finite elements.
+ */
+struct TensorStats {
+    int64_t num_elements = 0;      ///< The total number of elements.
+    int64_t num_nan = 0;           ///< The number of NaN elements, complex elements with a NaN part.
+    int64_t num_inf = 0;           ///< The number of other infinite elements.
+    double min = 0.0;              ///< The smallest finite value, or absolute value for complex data.
+    double max = 0.0;              ///< The largest finite value, or absolute value for complex data.
+    std::complex<double> mean = 0.0; ///< The mean of the finite values.
+    double norm = 0.0;             ///< The L2 (Frobenius) norm of the finite values.
+};
+
+/**
+ * @brief Compute the statistics of a tensor in a single pass.
+ *
+ * The data are split into chunks reduced in parallel on the shared thread pool. A chunk is first
+ * reduced by a branch-free loop, and only rescanned element by element if it holds a NaN or an Inf.
+ * GPU tensors are copied to the host first.
+ *
+ * @note float, double, int, int64, complex<float> and complex<double> data are supported.
+ * @throw std::invalid_argument for other data types.
+ */
+TensorStats stats(const Tensor& tensor);
+
+/**
+ * @brief Check that a tensor holds no NaN or Inf.
+ *
+ * This is a single branch-free, parallel pass without any other arithmetic, cheap enough to run
+ * on every iteration. Integer tensors are always finite.
+ *
+ * @throw std::invalid_argument for unsupported data types, see stats().
+ */
+bool all_finite(const Tensor& tensor);
+
+/**
+ * @brief A one-line description of a tensor: its shape, type and statistics.
+ *
+ * Use this instead of printing whole tensors to diagnose diverging runs, e.g.
+ * Tensor(shape=[16,1024], data_type=complex<double>, device_type=cpu): min=0.01, max=3.2, ...
+ */
+std::string describe(const Tensor& tensor);
+
+/**
+ * @brief Output the statistics as "min=..., max=..., mean=..., norm=..., nan=..., inf=...".
+ */
+std::ostream& operator<<(std::ostream& os, const TensorStats& stats);
+
+} // namespace container
+
+#endif // CONTAINER_KERNELS_STATS_OP_H
@@ -0,0 +1,168 @@
+#include <complex>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../blas_op.h"
+
+namespace {
+
+using container::DEVICE_CPU;
+
+template <typename T>
+class BlasOpTest : public ::testing::Test {
+  protected:
+    // Column-major 3 x 2 matrix and matching vectors.
+    const int m = 3, n = 2;
+    std::vector<T> A = {1, 2, 3, 4, 5, 6};
+    std::vector<T> x = {1, -1};
+    std::vector<T> y = {0.5, 1.5, -2};
+};
+
+using RealTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(BlasOpTest, RealTypes);
+
+} // namespace
+
+TYPED_TEST(BlasOpTest, ScalReal) {
+    using T = TypeParam;
+    std::vector<T> v = this->y;
+    const T alpha = 2;
+    container::op::scal_op<T, DEVICE_CPU>()(3, &alpha, v.data(), 1);
+    for (int ii = 0; ii < 3; ii++) {
+        EXPECT_NEAR(v[ii], 2 * this->y[ii], 1e-6);
+    }
+}
+
+TYPED_TEST(BlasOpTest, AxpyReal) {
+    using T = TypeParam;
+    std::vector<T> v = this->y;
+    const T alpha = -0.5;
+    container::op::axpy_op<T, DEVICE_CPU>()(3, &alpha, this->A.data(), 1, v.data(), 1);
+    for (int ii = 0; ii < 3; ii++) {
+        EXPECT_NEAR(v[ii], this->y[ii] - 0.5 * this->A[ii], 1e-6);
+    }
+}
+
+TYPED_TEST(BlasOpTest, GemvReal) {
+    using T = TypeParam;
+    const T alpha = 1, beta = 2;
+    std::vector<T> v = this->y;
+    container::op::gemv_op<T, DEVICE_CPU>()('N', this->m, this->n, &alpha, this->A.data(), this->m,
+                                            this->x.data(), 1, &beta, v.data(), 1);
+    for (int ii = 0; ii < this->m; ii++) {
+        EXPECT_NEAR(v[ii], this->A[ii] - this->A[ii + this->m] + 2 * this->y[ii], 1e-6);
+    }
+    // y = A^T * x with a vector of length m.
+    std::vector<T> w(this->n, 0);
+    const T zero = 0;
+    container::op::gemv_op<T, DEVICE_CPU>()('T', this->m, this->n, &alpha, this->A.data(), this->m,
+                                            this->y.data(), 1, &zero, w.data(), 1);
+    for (int jj = 0; jj < this->n; jj++) {
+        T sum = 0;
+        for (int ii = 0; ii < this->m; ii++) sum += this->A[ii + jj * this->m] * this->y[ii];
+        EXPECT_NEAR(w[jj], sum, 1e-6);
+    }
+}
+
+TYPED_TEST(BlasOpTest, GemmReal) {
+    using T = TypeParam;
+    const T alpha = 1, beta = 0;
+    // C = A^T * A, 2 x 2.
+    std::vector<T> C(this->n * this->n, 0);
+    container::op::gemm_op<T, DEVICE_CPU>()('T', 'N', this->n, this->n, this->m, &alpha, this->A.data(), this->m,
+                                            this->A.data(), this->m, &beta, C.data(), this->n);
+    for (int ii = 0; ii < this->n; ii++) {
+        for (int jj = 0; jj < this->n; jj++) {
+            T sum = 0;
+            for (int kk = 0; kk < this->m; kk++) sum += this->A[kk + ii * this->m] * this->A[kk + jj * this->m];
+            EXPECT_NEAR(C[ii + jj * this->n], sum, 1e-5);
+        }
+    }
+}
+
+TEST(BlasOpComplexTest, GemmConjTrans) {
+    using T = std::complex<double>;
+    std::vector<T> A = {{1, 1}, {2, -1}, {0, 3}};
+    const T alpha = 1.0, beta = 0.0;
+    T C = 0.0;
+    container::op::gemm_op<double, DEVICE_CPU>()('C', 'N', 1, 1, 3, &alpha, A.data(), 3, A.data(), 3, &beta, &C, 1);
+    EXPECT_NEAR(C.real(), 2 + 5 + 9, 1e-12);
+    EXPECT_NEAR(C.imag(), 0.0, 1e-12);
+}
+
+TEST(BlasOpSmallGemmTest, MatchesBlas) {
+    using T = std::complex<double>;
+    const std::vector<char> flags = {'N', 'T', 'C'};
+    const std::vector<int> sizes = {1, 3, 4, 7, 16, 32, 33};
+    const T alpha = {1.5, -0.5}, beta = {0.25, 0.75};
+    const int threshold = container::op::get_small_gemm_threshold();
+    for (int m : sizes) {
+        for (int n : {1, 5, 32}) {
+            for (int k : {2, 9, 32}) {
+                std::vector<T> a(36 * 36), b(36 * 36), c0(36 * 36);
+                for (size_t ii = 0; ii < a.size(); ii++) {
+                    a[ii] = T(0.1 * ((ii * 7) % 13) - 0.5, 0.05 * ((ii * 3) % 11) - 0.2);
+                    b[ii] = T(0.1 * ((ii * 5) % 11) - 0.4, 0.03 * ((ii * 2) % 7) - 0.1);
+                    c0[ii] = T(0.01 * (ii % 17), -0.02 * (ii % 5));
+                }
+                for (char ta : flags) {
+                    for (char tb : flags) {
+                        std::vector<T> c_small = c0, c_blas = c0;
+                        container::op::set_small_gemm_threshold(32);
+                        container::op::gemm_op<double, DEVICE_CPU>()(ta, tb, m, n, k, &alpha, a.data(), 35,
+                                                                     b.data(), 34, &beta, c_small.data(), 36);
+                        container::op::set_small_gemm_threshold(0);
+                        container::op::gemm_op<double, DEVICE_CPU>()(ta, tb, m, n, k, &alpha, a.data(), 35,
+                                                                     b.data(), 34, &beta, c_blas.data(), 36);
+                        for (size_t ii = 0; ii < c0.size(); ii++) {
+                            ASSERT_NEAR(std::abs(c_small[ii] - c_blas[ii]), 0.0, 1e-12)
+                                << "m=" << m << " n=" << n << " k=" << k << " transa=" << ta << " transb=" << tb;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    container::op::set_small_gemm_threshold(threshold);
+}
+
+TEST(BlasOpSmallGemmTest, RealAndBetaZero) {
+    const int m = 5, n = 6, k = 7;
+    std::vector<float> a(m * k), b(k * n), c(m * n, std::numeric_limits<float>::quiet_NaN());
+    for (int ii = 0; ii < m * k; ii++) a[ii] = 0.1f * (ii % 9);
+    for (int ii = 0; ii < k * n; ii++) b[ii] = 0.2f * (ii % 4) - 0.3f;
+    const float alpha = 2.0f, beta = 0.0f;
+    container::op::gemm_op<float, DEVICE_CPU>()('N', 'N', m, n, k, &alpha, a.data(), m, b.data(), k, &beta, c.data(), m);
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            float sum = 0;
+            for (int l = 0; l < k; l++) sum += a[i + l * m] * b[l + j * k];
+            EXPECT_NEAR(c[i + j * m], 2 * sum, 1e-5);
+        }
+    }
+    const int threshold = container::op::get_small_gemm_threshold();
+    container::op::set_small_gemm_threshold(100);
+    EXPECT_EQ(container::op::get_small_gemm_threshold(), 32);
+    container::op::set_small_gemm_threshold(threshold);
+}
+
+TEST(BlasOpTest, TriangularSolve) {
+    const int n = 5, nrhs = 3;
+    std::vector<double> l(n * n, 0.0), x(n * nrhs), b(n * nrhs, 0.0);
+    for (int j = 0; j < n; j++) {
+        for (int i = j; i < n; i++) l[i + j * n] = i == j ? 2.0 + i : 0.1 * (i - j);
+    }
+    for (int ii = 0; ii < n * nrhs; ii++) x[ii] = 0.3 * ii - 1.0;
+    // b = 2 L^T x, so 0.5 * L^-T b recovers x.
+    for (int k = 0; k < nrhs; k++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) b[i + k * n] += 2.0 * l[j + i * n] * x[j + k * n];
+        }
+    }
+    const double half = 0.5;
+    container::op::trsm_op<double, container::DEVICE_CPU>()('L', 'L', 'T', 'N', n, nrhs, &half, l.data(), n, b.data(), n);
+    for (int ii = 0; ii < n * nrhs; ii++) {
+        EXPECT_NEAR(b[ii], x[ii], 1e-12);
+    }
+}
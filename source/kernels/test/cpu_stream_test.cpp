@@ -0,0 +1,87 @@
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../cpu_stream.h"
+#include "../blas_op.h"
+
+using container::CpuEvent;
+using container::CpuStream;
+using container::DEVICE_CPU;
+
+TEST(CpuStreamTest, InOrderWithFutures) {
+    CpuStream stream;
+    std::vector<int> order;
+    for (int ii = 0; ii < 100; ii++) {
+        stream.enqueue([&order, ii]() { order.push_back(ii); });
+    }
+    std::future<int> size = stream.enqueue([&order]() { return static_cast<int>(order.size()); });
+    EXPECT_EQ(size.get(), 100);
+    for (int ii = 0; ii < 100; ii++) {
+        EXPECT_EQ(order[ii], ii);
+    }
+
+    // Arguments are passed through, exceptions end up in the future and the stream keeps running.
+    std::future<int> sum = stream.enqueue([](int a, int b) { return a + b; }, 2, 3);
+    std::future<void> failed = stream.enqueue([]() { throw std::runtime_error("failed"); });
+    std::future<int> after = stream.enqueue([]() { return 7; });
+    EXPECT_EQ(sum.get(), 5);
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_EQ(after.get(), 7);
+}
+
+TEST(CpuStreamTest, EventsOrderStreams) {
+    CpuStream producer, consumer;
+    std::atomic<bool> produced(false);
+    producer.enqueue([&produced]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        produced = true;
+    });
+    const CpuEvent event = producer.record();
+    consumer.wait(event);
+    std::future<bool> seen = consumer.enqueue([&produced]() { return produced.load(); });
+    EXPECT_TRUE(seen.get());
+    EXPECT_TRUE(event.query());
+
+    EXPECT_TRUE(CpuEvent().query());
+    consumer.wait(CpuEvent());
+    consumer.synchronize();
+}
+
+TEST(CpuStreamTest, OverlappedOps) {
+    const int n = 64;
+    std::vector<double> a(n * n), b(n * n), c1(n * n, 0.0), c2(n * n, 0.0), x(n, 1.0), y(n, 0.0);
+    for (int ii = 0; ii < n * n; ii++) {
+        a[ii] = 0.01 * (ii % 17);
+        b[ii] = 0.02 * (ii % 13);
+    }
+    const double one = 1.0, zero = 0.0;
+    CpuStream s1, s2;
+    // c1 = a b on one stream, c2 = b a on the other, then y = c1 x after both.
+    s1.enqueue(container::op::gemm_op<double, DEVICE_CPU>(), 'N', 'N', n, n, n,
+               &one, a.data(), n, b.data(), n, &zero, c1.data(), n);
+    s2.enqueue(container::op::gemm_op<double, DEVICE_CPU>(), 'N', 'N', n, n, n,
+               &one, b.data(), n, a.data(), n, &zero, c2.data(), n);
+    s2.wait(s1.record());
+    s2.enqueue(container::op::gemv_op<double, DEVICE_CPU>(), 'N', n, n,
+               &one, c1.data(), n, x.data(), 1, &zero, y.data(), 1);
+    s2.synchronize();
+
+    for (int ii = 0; ii < n; ii += 7) {
+        double ref = 0.0, row = 0.0;
+        for (int kk = 0; kk < n; kk++) {
+            ref += b[ii + kk * n] * a[kk + 3 * n];
+        }
+        EXPECT_NEAR(c2[ii + 3 * n], ref, 1e-12);
+        for (int jj = 0; jj < n; jj++) {
+            double cij = 0.0;
+            for (int kk = 0; kk < n; kk++) {
+                cij += a[ii + kk * n] * b[kk + jj * n];
+            }
+            row += cij;
+        }
+        EXPECT_NEAR(y[ii], row, 1e-10);
+    }
+}
@@ -0,0 +1,186 @@
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../eigensolver_op.h"
+#include "../lapack_op.h"
+
+namespace {
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+using container::DEVICE_CPU;
+
+// Add an imaginary part to complex values.
+double with_phase(const double& x, const double&) { return x; }
+std::complex<double> with_phase(const std::complex<double>& x, const double& im) { return x + std::complex<double>(0, im); }
+double conjugate(const double& x) { return x; }
+std::complex<double> conjugate(const std::complex<double>& x) { return std::conj(x); }
+
+// A diagonally dominant Hermitian H and a positive definite S, stored column-major.
+template <typename T>
+struct Problem {
+    int dim;
+    std::vector<T> h, s;
+
+    explicit Problem(const int& n) : dim(n), h(n * n), s(n * n) {
+        for (int j = 0; j < n; j++) {
+            for (int i = 0; i <= j; i++) {
+                const T hij = i == j ? T(0.5 * (i + 1)) : with_phase(T(0.02 * ((i * 7 + j * 3) % 11) - 0.1), 0.01 * (i - j));
+                const T sij = i == j ? T(1.0) : T(j - i == 1 ? 0.05 : 0.0);
+                h[i + j * n] = hij;
+                h[j + i * n] = conjugate(hij);
+                s[i + j * n] = sij;
+                s[j + i * n] = conjugate(sij);
+            }
+        }
+    }
+
+    // out[v] = a * in[v] for the row-major [nvec, dim] blocks.
+    void multiply(const std::vector<T>& a, const Tensor& in, Tensor& out) const {
+        const int nvec = in.shape().dim_size(0);
+        for (int v = 0; v < nvec; v++) {
+            const T* x = in.data<T>() + v * dim;
+            T* y = out.data<T>() + v * dim;
+            for (int i = 0; i < dim; i++) {
+                T sum = 0;
+                for (int j = 0; j < dim; j++) sum += a[i + j * dim] * x[j];
+                y[i] = sum;
+            }
+        }
+    }
+
+    // The lowest eigenvalues from the dense solver.
+    std::vector<typename container::GetTypeReal<T>::type> reference() const {
+        std::vector<T> s_copy = s, v(dim * dim);
+        std::vector<typename container::GetTypeReal<T>::type> w(dim);
+        container::op::dngvd_op<typename container::GetTypeReal<T>::type, DEVICE_CPU>()(
+                dim, dim, h.data(), s_copy.data(), w.data(), v.data());
+        return w;
+    }
+};
+
+// Start from a few unit vectors perturbed by a smooth function.
+template <typename T>
+Tensor initial_guess(const int& nband, const int& dim, const DataType& data_type) {
+    Tensor psi(data_type, TensorShape({nband, dim}));
+    for (int v = 0; v < nband; v++) {
+        for (int i = 0; i < dim; i++) {
+            psi.data<T>()[v * dim + i] = T((i == v ? 1.0 : 0.0) + 0.01 * std::cos(0.3 * (i + 1) * (v + 1)));
+        }
+    }
+    return psi;
+}
+
+// A diagonal preconditioner 1 / (h_ii - lambda s_ii), bounded away from the poles.
+template <typename T>
+container::BlockPreconditioner diagonal_preconditioner(const Problem<T>& problem) {
+    return [&problem](Tensor& block, const Tensor& eigenvalues) {
+        const int nvec = block.shape().dim_size(0), dim = problem.dim;
+        for (int v = 0; v < nvec; v++) {
+            const double lambda = eigenvalues.data<double>()[v];
+            for (int i = 0; i < dim; i++) {
+                double d = std::real(problem.h[i + i * dim]) - lambda * std::real(problem.s[i + i * dim]);
+                if (std::abs(d) < 0.1) d = d < 0 ? -0.1 : 0.1;
+                block.data<T>()[v * dim + i] /= d;
+            }
+        }
+    };
+}
+
+template <typename T>
+void check_solver(
+        container::EigensolverInfo (*solver)(
+                const container::BlockOperator&, const container::BlockOperator&,
+                const container::BlockPreconditioner&, Tensor&, Tensor&, const container::EigensolverOptions&),
+        const DataType& data_type)
+{
+    const int dim = 60, nband = 4;
+    const Problem<T> problem(dim);
+    const std::vector<double> expected = problem.reference();
+    auto apply_h = [&problem](const Tensor& in, Tensor& out) { problem.multiply(problem.h, in, out); };
+    auto apply_s = [&problem](const Tensor& in, Tensor& out) { problem.multiply(problem.s, in, out); };
+
+    Tensor psi = initial_guess<T>(nband, dim, data_type);
+    Tensor eigenvalues(DataType::DT_DOUBLE, TensorShape({nband}));
+    container::EigensolverOptions options;
+    options.tol = 1e-8;
+    options.max_iter = 200;
+    const container::EigensolverInfo info = solver(
+            apply_h, apply_s, diagonal_preconditioner(problem), psi, eigenvalues, options);
+    EXPECT_EQ(info.converged, nband);
+    EXPECT_LT(info.max_residual, 1e-8);
+    for (int ii = 0; ii < nband; ii++) {
+        EXPECT_NEAR(eigenvalues.data<double>()[ii], expected[ii], 1e-10);
+    }
+
+    // Warm start from the converged eigenvectors, nothing left to do.
+    const container::EigensolverInfo warm = solver(
+            apply_h, apply_s, diagonal_preconditioner(problem), psi, eigenvalues, options);
+    EXPECT_EQ(warm.iterations, 0);
+    EXPECT_EQ(warm.converged, nband);
+
+    // No preconditioner and S = I is the standard eigenproblem of H.
+    Tensor psi2 = initial_guess<T>(nband, dim, data_type);
+    options.tol = 1e-6;
+    const container::EigensolverInfo plain = solver(apply_h, nullptr, nullptr, psi2, eigenvalues, options);
+    EXPECT_EQ(plain.converged, nband);
+}
+
+} // namespace
+
+TEST(EigensolverOpTest, DavidsonReal) {
+    check_solver<double>(container::davidson, DataType::DT_DOUBLE);
+}
+
+TEST(EigensolverOpTest, DavidsonComplex) {
+    check_solver<std::complex<double>>(container::davidson, DataType::DT_COMPLEX_DOUBLE);
+}
+
+TEST(EigensolverOpTest, LobpcgReal) {
+    check_solver<double>(container::lobpcg, DataType::DT_DOUBLE);
+}
+
+TEST(EigensolverOpTest, LobpcgComplex) {
+    check_solver<std::complex<double>>(container::lobpcg, DataType::DT_COMPLEX_DOUBLE);
+}
+
+TEST(EigensolverOpTest, InvalidArguments) {
+    auto identity = [](const Tensor& in, Tensor& out) {
+        for (int ii = 0; ii < in.NumElements(); ii++) out.data<double>()[ii] = in.data<double>()[ii];
+    };
+    Tensor psi(DataType::DT_DOUBLE, TensorShape({3, 8}));
+    Tensor eigenvalues(DataType::DT_DOUBLE, TensorShape({2}));
+    EXPECT_THROW(container::davidson(identity, nullptr, nullptr, psi, eigenvalues), std::invalid_argument);
+    Tensor eigenvalues3(DataType::DT_DOUBLE, TensorShape({3}));
+    EXPECT_THROW(container::lobpcg(nullptr, nullptr, nullptr, psi, eigenvalues3), std::invalid_argument);
+    // Linearly dependent initial guess.
+    for (int ii = 0; ii < psi.NumElements(); ii++) psi.data<double>()[ii] = 1.0;
+    EXPECT_THROW(container::davidson(identity, nullptr, nullptr, psi, eigenvalues3), std::invalid_argument);
+}
+
+TEST(EigensolverOpTest, MixedPrecisionSubspace) {
+    const int dim = 60, nband = 4;
+    const Problem<std::complex<double>> problem(dim);
+    const std::vector<double> expected = problem.reference();
+    auto apply_h = [&problem](const Tensor& in, Tensor& out) { problem.multiply(problem.h, in, out); };
+    auto apply_s = [&problem](const Tensor& in, Tensor& out) { problem.multiply(problem.s, in, out); };
+
+    container::EigensolverOptions options;
+    options.max_iter = 200;
+    options.mixed_precision_tol = 1e-12;
+    for (auto solver : {container::davidson, container::lobpcg}) {
+        Tensor psi = initial_guess<std::complex<double>>(nband, dim, DataType::DT_COMPLEX_DOUBLE);
+        Tensor eigenvalues(DataType::DT_DOUBLE, TensorShape({nband}));
+        const container::EigensolverInfo info = solver(
+                apply_h, apply_s, diagonal_preconditioner(problem), psi, eigenvalues, options);
+        EXPECT_EQ(info.converged, nband);
+        EXPECT_LT(info.max_residual, 1e-8);
+        for (int ii = 0; ii < nband; ii++) {
+            EXPECT_NEAR(eigenvalues.data<double>()[ii], expected[ii], 1e-10);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <complex>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../einsum_op.h"
+
+namespace {
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+
+using T = std::complex<double>;
+
+// Naive evaluation of the explicit equation by looping over all the index combinations.
+std::vector<T> einsum_reference(const std::string& equation, const std::vector<const Tensor*>& operands) {
+    const size_t arrow = equation.find("->");
+    const std::string output = equation.substr(arrow + 2);
+    std::vector<std::string> inputs(1);
+    for (char c : equation.substr(0, arrow)) {
+        if (c == ',') inputs.push_back("");
+        else inputs.back().push_back(c);
+    }
+    std::map<char, int> sizes;
+    std::string labels;
+    for (size_t ii = 0; ii < inputs.size(); ii++) {
+        for (size_t jj = 0; jj < inputs[ii].size(); jj++) {
+            if (!sizes.count(inputs[ii][jj])) labels.push_back(inputs[ii][jj]);
+            sizes[inputs[ii][jj]] = operands[ii]->shape().dim_size(jj);
+        }
+    }
+    auto offset = [&](const std::string& term, std::map<char, int>& index) {
+        int64_t pos = 0;
+        for (char c : term) pos = pos * sizes[c] + index[c];
+        return pos;
+    };
+    int64_t out_size = 1, total = 1;
+    for (char c : output) out_size *= sizes[c];
+    for (char c : labels) total *= sizes[c];
+    std::vector<T> result(out_size, 0.0);
+    std::map<char, int> index;
+    for (int64_t ii = 0; ii < total; ii++) {
+        int64_t rest = ii;
+        for (int jj = static_cast<int>(labels.size()) - 1; jj >= 0; jj--) {
+            index[labels[jj]] = static_cast<int>(rest % sizes[labels[jj]]);
+            rest /= sizes[labels[jj]];
+        }
+        T value = 1.0;
+        for (size_t jj = 0; jj < inputs.size(); jj++) {
+            value *= operands[jj]->data<T>()[offset(inputs[jj], index)];
+        }
+        result[offset(output, index)] += value;
+    }
+    return result;
+}
+
+Tensor make_tensor(const std::vector<int>& dims, const int& seed) {
+    Tensor t(DataType::DT_COMPLEX_DOUBLE, TensorShape(dims));
+    for (int ii = 0; ii < t.NumElements(); ii++) {
+        t.data<T>()[ii] = T(0.1 * ((ii * 5 + seed) % 17) - 0.8, 0.07 * ((ii * 3 + seed) % 7) - 0.2);
+    }
+    return t;
+}
+
+void check_einsum(const std::string& equation, const std::vector<const Tensor*>& operands, Tensor& out) {
+    container::einsum(equation, operands, out);
+    const std::vector<T> expected = einsum_reference(equation, operands);
+    ASSERT_EQ(out.NumElements(), static_cast<int64_t>(expected.size()));
+    for (size_t ii = 0; ii < expected.size(); ii++) {
+        EXPECT_NEAR(std::abs(out.data<T>()[ii] - expected[ii]), 0.0, 1e-10) << equation << " index=" << ii;
+    }
+}
+
+} // namespace
+
+TEST(EinsumOpTest, MatrixProduct) {
+    Tensor a = make_tensor({3, 4}, 1), b = make_tensor({4, 5}, 2);
+    Tensor c(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 5}));
+    Tensor ct(DataType::DT_COMPLEX_DOUBLE, TensorShape({5, 3}));
+    check_einsum("ij,jk->ik", {&a, &b}, c);
+    check_einsum("ij,jk->ki", {&a, &b}, ct);
+    Tensor d = make_tensor({5, 4}, 3);
+    check_einsum("ij,kj->ik", {&a, &d}, c);
+}
+
+TEST(EinsumOpTest, ImplicitOutput) {
+    Tensor a = make_tensor({3, 4}, 1), b = make_tensor({4, 5}, 2);
+    Tensor c(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 5}));
+    container::einsum("ij,jk", {&a, &b}, c);
+    const std::vector<T> expected = einsum_reference("ij,jk->ik", {&a, &b});
+    for (size_t ii = 0; ii < expected.size(); ii++) {
+        EXPECT_NEAR(std::abs(c.data<T>()[ii] - expected[ii]), 0.0, 1e-10);
+    }
+}
+
+TEST(EinsumOpTest, BatchedAndInterleaved) {
+    Tensor a = make_tensor({2, 3, 4}, 1), b = make_tensor({2, 4, 5}, 2);
+    Tensor c(DataType::DT_COMPLEX_DOUBLE, TensorShape({2, 3, 5}));
+    check_einsum("bij,bjk->bik", {&a, &b}, c);
+    // batch index in the middle of the operands, needs a transpose.
+    Tensor x = make_tensor({3, 2, 4}, 4), y = make_tensor({4, 2, 5}, 5);
+    Tensor z(DataType::DT_COMPLEX_DOUBLE, TensorShape({5, 2, 3}));
+    check_einsum("ibj,jbk->kbi", {&x, &y}, z);
+}
+
+TEST(EinsumOpTest, MultipleOperands) {
+    // <beta|psi> summed over atoms and orbitals.
+    Tensor beta = make_tensor({2, 3, 6}, 1), coef = make_tensor({2, 3, 3}, 2), psi = make_tensor({4, 6}, 3);
+    Tensor out(DataType::DT_COMPLEX_DOUBLE, TensorShape({4, 2, 3}));
+    check_einsum("aig,aij,bg->baj", {&beta, &coef, &psi}, out);
+    Tensor s = make_tensor({3, 4}, 4), t = make_tensor({4, 5}, 5), u = make_tensor({5, 2}, 6), v = make_tensor({2, 3}, 7);
+    Tensor w(DataType::DT_COMPLEX_DOUBLE, TensorShape({}));
+    check_einsum("ij,jk,kl,li->", {&s, &t, &u, &v}, w);
+}
+
+TEST(EinsumOpTest, ReductionAndOuterProduct) {
+    Tensor a = make_tensor({3, 4, 2}, 1);
+    Tensor r(DataType::DT_COMPLEX_DOUBLE, TensorShape({2, 3}));
+    check_einsum("ijk->ki", {&a}, r);
+    Tensor x = make_tensor({3}, 2), y = make_tensor({4, 2}, 3);
+    Tensor o(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 4}));
+    check_einsum("i,jk->ij", {&x, &y}, o);
+}
+
+TEST(EinsumOpTest, CachedPlan) {
+    // Shapes that no other test uses, so that the first call makes a new plan.
+    Tensor a = make_tensor({3, 7}, 1), b = make_tensor({7, 6}, 2);
+    Tensor c(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 6}));
+    const container::EinsumCacheStats before = container::einsum_cache_stats();
+    for (int ii = 0; ii < 3; ii++) {
+        check_einsum("ij,jk->ik", {&a, &b}, c);
+    }
+    const container::EinsumCacheStats repeated = container::einsum_cache_stats();
+    EXPECT_EQ(repeated.misses, before.misses + 1);
+    EXPECT_EQ(repeated.hits, before.hits + 2);
+    EXPECT_EQ(repeated.plans, before.plans + 1);
+    // the same equation with different shapes uses another plan.
+    Tensor d = make_tensor({7, 2}, 3);
+    Tensor e(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 2}));
+    check_einsum("ij,jk->ik", {&a, &d}, e);
+    const container::EinsumCacheStats reshaped = container::einsum_cache_stats();
+    EXPECT_EQ(reshaped.misses, repeated.misses + 1);
+    EXPECT_EQ(reshaped.hits, repeated.hits);
+    EXPECT_EQ(reshaped.plans, repeated.plans + 1);
+}
+
+TEST(EinsumOpTest, InvalidArguments) {
+    Tensor a = make_tensor({3, 4}, 1), b = make_tensor({5, 5}, 2);
+    Tensor c(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 5}));
+    EXPECT_THROW(container::einsum("ij,jk->ik", {&a, &b}, c), std::invalid_argument);
+    EXPECT_THROW(container::einsum("ij->ik", {&a}, c), std::invalid_argument);
+    EXPECT_THROW(container::einsum("ii->i", {&b}, c), std::invalid_argument);
+    EXPECT_THROW(container::einsum("ij,jk->ik", {&a}, c), std::invalid_argument);
+    EXPECT_THROW(container::einsum("ij->ij", {&a}, c), std::invalid_argument);
+}
+
+TEST(EinsumOpTest, RealOperands) {
+    Tensor a(DataType::DT_DOUBLE, TensorShape({2, 3, 4})), b(DataType::DT_DOUBLE, TensorShape({4, 3}));
+    for (int ii = 0; ii < a.NumElements(); ii++) a.data<double>()[ii] = 0.1 * (ii % 7) - 0.3;
+    for (int ii = 0; ii < b.NumElements(); ii++) b.data<double>()[ii] = 0.2 * (ii % 5) - 0.4;
+    Tensor c(DataType::DT_DOUBLE, TensorShape({2}));
+    container::einsum("bij,ji->b", {&a, &b}, c);
+    for (int bb = 0; bb < 2; bb++) {
+        double sum = 0;
+        for (int ii = 0; ii < 3; ii++) {
+            for (int jj = 0; jj < 4; jj++) sum += a.data<double>()[(bb * 3 + ii) * 4 + jj] * b.data<double>()[jj * 3 + ii];
+        }
+        EXPECT_NEAR(c.data<double>()[bb], sum, 1e-12);
+    }
+}
@@ -0,0 +1,106 @@
+#include <cmath>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../fixed_tensor.h"
+
+using container::FixedTensor;
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+
+using Vec2 = FixedTensor<double, 2>;
+using Vec3 = FixedTensor<double, 3>;
+using Mat2 = FixedTensor<double, 2, 2>;
+using Mat3 = FixedTensor<double, 3, 3>;
+
+TEST(FixedTensorTest, ShapeAndAccess) {
+    FixedTensor<double, 2, 3> a({1, 2, 3, 4, 5, 6});
+    static_assert(FixedTensor<double, 2, 3>::rank == 2, "rank");
+    static_assert(FixedTensor<double, 2, 3>::size == 6, "size");
+    static_assert(sizeof(Mat3) == 9 * sizeof(double), "no overhead");
+    EXPECT_EQ(a.shape(), TensorShape({2, 3}));
+    EXPECT_EQ(a(1, 0), 4);
+    EXPECT_EQ(a(0, 2), 3);
+    a(1, 2) = 7;
+    EXPECT_EQ(a[5], 7);
+
+    Vec3 x(2.0);
+    EXPECT_EQ(x[0], 2.0);
+    EXPECT_EQ(x[2], 2.0);
+}
+
+TEST(FixedTensorTest, Arithmetic) {
+    Vec3 a({1, 2, 3}), b({4, 5, 6});
+    EXPECT_EQ(a + b, Vec3({5, 7, 9}));
+    EXPECT_EQ(b - a, Vec3({3, 3, 3}));
+    EXPECT_EQ(2.0 * a, Vec3({2, 4, 6}));
+    EXPECT_EQ(-a / 2.0, Vec3({-0.5, -1, -1.5}));
+    EXPECT_EQ(container::dot(a, b), 32.0);
+    EXPECT_EQ(container::cross(a, b), Vec3({-3, 6, -3}));
+}
+
+TEST(FixedTensorTest, LinearAlgebra) {
+    Mat3 a({2, 1, 0, 1, 3, 1, 0, 1, 4});
+    EXPECT_NEAR(container::det(a), 18.0, 1e-14);
+    const Mat3 inv = container::inverse(a);
+    const Mat3 id = container::matmul(a, inv);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_NEAR(id(i, j), i == j ? 1.0 : 0.0, 1e-14);
+        }
+    }
+    Mat2 b({1, 2, 3, 4});
+    EXPECT_EQ(container::det(b), -2.0);
+    EXPECT_EQ(container::inverse(b), Mat2({-2, 1, 1.5, -0.5}));
+    EXPECT_THROW(container::inverse(Mat2({1, 2, 2, 4})), std::invalid_argument);
+
+    FixedTensor<double, 2, 3> c({1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(container::transpose(c)(2, 1), 6.0);
+    EXPECT_EQ(container::matmul(c, Vec3({1, 0, -1})), Vec2({-2, -2}));
+}
+
+TEST(FixedTensorTest, SymmetricEigen) {
+    Mat3 a({4, 1, 2, 1, 3, 0, 2, 0, 5});
+    Vec3 w;
+    Mat3 v;
+    container::eigh(a, w, v);
+    EXPECT_LE(w[0], w[1]);
+    EXPECT_LE(w[1], w[2]);
+    EXPECT_NEAR(w[0] + w[1] + w[2], 12.0, 1e-12);
+    EXPECT_NEAR(w[0] * w[1] * w[2], container::det(a), 1e-11);
+    // a * v = v * diag(w) and v^T * v = 1
+    const Mat3 av = container::matmul(a, v);
+    const Mat3 vtv = container::matmul(container::transpose(v), v);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_NEAR(av(i, j), v(i, j) * w[j], 1e-12);
+            EXPECT_NEAR(vtv(i, j), i == j ? 1.0 : 0.0, 1e-12);
+        }
+    }
+    // Degenerate eigenvalues.
+    Mat3 d({2, 0, 0, 0, 2, 0, 0, 0, 1});
+    container::eigh(d, w, v);
+    EXPECT_EQ(w, Vec3({1, 2, 2}));
+}
+
+TEST(FixedTensorTest, TensorViews) {
+    Mat3 a({1, 2, 3, 4, 5, 6, 7, 8, 9});
+    Tensor t = a.view();
+    EXPECT_EQ(t.data<double>(), a.data());
+    EXPECT_EQ(t.shape(), TensorShape({3, 3}));
+    t.data<double>()[4] = -5;
+    EXPECT_EQ(a(1, 1), -5);
+
+    Tensor u(DataType::DT_DOUBLE, TensorShape({3, 3}));
+    u.zero();
+    Mat3& m = Mat3::map(u);
+    EXPECT_EQ(m.data(), u.data<double>());
+    m(0, 2) = 1.5;
+    EXPECT_EQ(u.data<double>()[2], 1.5);
+
+    Tensor wrong_shape(DataType::DT_DOUBLE, TensorShape({9}));
+    Tensor wrong_type(DataType::DT_FLOAT, TensorShape({3, 3}));
+    EXPECT_THROW(Mat3::map(wrong_shape), std::invalid_argument);
+    EXPECT_THROW(Mat3::map(wrong_type), std::invalid_argument);
+}
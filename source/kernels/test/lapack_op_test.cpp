@@ -0,0 +1,318 @@
+#include <complex>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../lapack_op.h"
+#include "../lapack_workspace.h"
+#include "../../thread_pool.h"
+
+namespace {
+
+using container::DEVICE_CPU;
+using container::DataType;
+
+// A column-major Hermitian matrix with a known spectrum-free structure, and a diagonally dominant overlap.
+template <typename T>
+void make_problem(const int& n, std::vector<std::complex<T>>& h, std::vector<std::complex<T>>& s) {
+    h.assign(n * n, 0);
+    s.assign(n * n, 0);
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i <= j; i++) {
+            const std::complex<T> hij(T(0.1) * ((i + 2 * j) % 7) + (i == j ? T(j) : T(0)), i == j ? T(0) : T(0.05) * (i - j));
+            h[i + j * n] = hij;
+            h[j + i * n] = std::conj(hij);
+            const std::complex<T> sij(i == j ? T(2) : T(0.01) * ((i * j) % 5), i == j ? T(0) : T(0.01));
+            s[i + j * n] = sij;
+            s[j + i * n] = std::conj(sij);
+        }
+    }
+}
+
+// max |(A v - lambda B v)| over the first m eigenpairs.
+template <typename T>
+T residual(const int& n, const int& m, const std::vector<std::complex<T>>& h, const std::vector<std::complex<T>>& s,
+           const T* w, const std::complex<T>* v)
+{
+    T res = 0;
+    for (int k = 0; k < m; k++) {
+        for (int i = 0; i < n; i++) {
+            std::complex<T> hv = 0, sv = 0;
+            for (int j = 0; j < n; j++) {
+                hv += h[i + j * n] * v[j + k * n];
+                sv += s[i + j * n] * v[j + k * n];
+            }
+            res = std::max(res, std::abs(hv - w[k] * sv));
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+TEST(LapackOpTest, DngvdRepeated) {
+    const int n = 12;
+    std::vector<std::complex<double>> h, s, v(n * n);
+    std::vector<double> w(n);
+    make_problem(n, h, s);
+    container::op::clear_lapack_workspace();
+    for (int iter = 0; iter < 3; iter++) {
+        std::vector<std::complex<double>> s_copy = s;
+        container::op::dngvd_op<double, DEVICE_CPU>()(n, n, h.data(), s_copy.data(), w.data(), v.data());
+        EXPECT_LT(residual(n, n, h, s, w.data(), v.data()), 1e-10);
+        for (int k = 1; k < n; k++) {
+            EXPECT_LE(w[k - 1], w[k]);
+        }
+    }
+    container::op::LapackWorkspace& ws =
+            container::op::get_lapack_workspace("hegvd", DataType::DT_COMPLEX_DOUBLE, n);
+    EXPECT_TRUE(ws.initialized());
+    EXPECT_GE(ws.lwork, 2 * n + n * n);
+}
+
+TEST(LapackOpTest, DnevxRepeated) {
+    const int n = 10, m = 4;
+    std::vector<std::complex<float>> h, s, v(n * n);
+    std::vector<float> w(n);
+    make_problem(n, h, s);
+    std::vector<std::complex<float>> identity(n * n, 0);
+    for (int i = 0; i < n; i++) identity[i * n + i] = 1;
+    for (int iter = 0; iter < 3; iter++) {
+        container::op::dnevx_op<float, DEVICE_CPU>()(n, n, h.data(), m, w.data(), v.data());
+        EXPECT_LT(residual(n, m, h, identity, w.data(), v.data()), 1e-4f);
+    }
+    EXPECT_TRUE(container::op::get_lapack_workspace("heevx", DataType::DT_COMPLEX, n).initialized());
+    container::op::clear_lapack_workspace();
+    EXPECT_FALSE(container::op::get_lapack_workspace("heevx", DataType::DT_COMPLEX, n).initialized());
+}
+
+TEST(LapackOpTest, InplaceMatchesCopy) {
+    const int n = 9, m = 3;
+    std::vector<std::complex<double>> h, s;
+    make_problem(n, h, s);
+
+    std::vector<std::complex<double>> s1 = s, v1(n * n);
+    std::vector<double> w1(n), w2(n);
+    container::op::dngvd_op<double, DEVICE_CPU>()(n, n, h.data(), s1.data(), w1.data(), v1.data());
+    std::vector<std::complex<double>> a2 = h, s2 = s;
+    container::op::dngvd_inplace_op<double, DEVICE_CPU>()(n, n, a2.data(), s2.data(), w2.data());
+    for (int ii = 0; ii < n * n; ii++) {
+        EXPECT_NEAR(std::abs(a2[ii] - v1[ii]), 0.0, 1e-12);
+    }
+    for (int ii = 0; ii < n; ii++) {
+        EXPECT_NEAR(w1[ii], w2[ii], 1e-12);
+    }
+
+    std::vector<std::complex<double>> v3(n * n), v4(n * n), a4 = h;
+    std::vector<double> w3(n), w4(n);
+    container::op::dnevx_op<double, DEVICE_CPU>()(n, n, h.data(), m, w3.data(), v3.data());
+    container::op::dnevx_inplace_op<double, DEVICE_CPU>()(n, n, a4.data(), m, w4.data(), v4.data());
+    for (int ii = 0; ii < n * m; ii++) {
+        EXPECT_NEAR(std::abs(v3[ii] - v4[ii]), 0.0, 1e-12);
+    }
+    for (int ii = 0; ii < m; ii++) {
+        EXPECT_NEAR(w3[ii], w4[ii], 1e-12);
+    }
+}
+
+TEST(LapackOpTest, DngvdBatched) {
+    const int n = 8, batch = 5;
+    std::vector<std::complex<double>> h, s, hs, ss;
+    for (int ii = 0; ii < batch; ii++) {
+        make_problem(n, h, s);
+        for (auto& x : h) x *= 1.0 + 0.1 * ii;
+        hs.insert(hs.end(), h.begin(), h.end());
+        ss.insert(ss.end(), s.begin(), s.end());
+    }
+    for (int threads : {1, 3, 0}) {
+        container::op::set_batched_eigen_threads(threads);
+        std::vector<std::complex<double>> s_copy = ss, v(batch * n * n);
+        std::vector<double> w(batch * n);
+        container::op::dngvd_batched_op<double, DEVICE_CPU>()(batch, n, n, hs.data(), s_copy.data(), w.data(), v.data());
+        for (int ii = 0; ii < batch; ii++) {
+            std::vector<std::complex<double>> hi(hs.begin() + ii * n * n, hs.begin() + (ii + 1) * n * n);
+            std::vector<std::complex<double>> si(ss.begin() + ii * n * n, ss.begin() + (ii + 1) * n * n);
+            EXPECT_LT(residual(n, n, hi, si, w.data() + ii * n, v.data() + ii * n * n), 1e-10) << "threads=" << threads;
+        }
+    }
+    container::op::set_batched_eigen_threads(0);
+}
+
+// The batch-parallel path, which only runs with more than one pool thread.
+TEST(LapackOpTest, DngvdBatchedOnThePool) {
+    const int n = 12, batch = 7;
+    std::vector<std::complex<double>> h, s, hs, ss;
+    for (int ii = 0; ii < batch; ii++) {
+        make_problem(n, h, s);
+        for (auto& x : h) x *= 1.0 + 0.1 * ii;
+        hs.insert(hs.end(), h.begin(), h.end());
+        ss.insert(ss.end(), s.begin(), s.end());
+    }
+    const int pool_threads = container::get_num_threads();
+    std::vector<std::vector<double>> eigenvalues;
+    for (int threads : {1, 3}) {
+        container::set_num_threads(threads);
+        container::op::set_batched_eigen_threads(threads);
+        std::vector<std::complex<double>> s_copy = ss, v(batch * n * n);
+        std::vector<double> w(batch * n);
+        container::op::dngvd_batched_op<double, DEVICE_CPU>()(batch, n, n, hs.data(), s_copy.data(), w.data(), v.data());
+        for (int ii = 0; ii < batch; ii++) {
+            std::vector<std::complex<double>> hi(hs.begin() + ii * n * n, hs.begin() + (ii + 1) * n * n);
+            std::vector<std::complex<double>> si(ss.begin() + ii * n * n, ss.begin() + (ii + 1) * n * n);
+            EXPECT_LT(residual(n, n, hi, si, w.data() + ii * n, v.data() + ii * n * n), 1e-10) << "threads=" << threads;
+        }
+        eigenvalues.push_back(w);
+    }
+    for (int ii = 0; ii < batch * n; ii++) {
+        EXPECT_NEAR(eigenvalues[0][ii], eigenvalues[1][ii], 1e-12);
+    }
+    container::op::set_batched_eigen_threads(0);
+    container::set_num_threads(pool_threads);
+}
+
+TEST(LapackOpTest, RealSymmetric) {
+    const int n = 10, m = 4;
+    std::vector<std::complex<double>> hc, sc;
+    make_problem(n, hc, sc);
+    // Keep the real parts, a real symmetric problem with the same structure.
+    std::vector<double> h(n * n), s(n * n);
+    for (int ii = 0; ii < n * n; ii++) {
+        h[ii] = hc[ii].real();
+        s[ii] = sc[ii].real();
+        hc[ii] = h[ii];
+        sc[ii] = s[ii];
+    }
+    std::vector<double> w(n), wc(n), v(n * n);
+    std::vector<std::complex<double>> vc(n * n);
+    std::vector<double> s_copy = s;
+    std::vector<std::complex<double>> sc_copy = sc;
+    container::op::dngvd_op<double, DEVICE_CPU>()(n, n, h.data(), s_copy.data(), w.data(), v.data());
+    container::op::dngvd_op<double, DEVICE_CPU>()(n, n, hc.data(), sc_copy.data(), wc.data(), vc.data());
+    std::vector<std::complex<double>> vr(v.begin(), v.end());
+    EXPECT_LT(residual(n, n, hc, sc, w.data(), vr.data()), 1e-10);
+    for (int ii = 0; ii < n; ii++) {
+        EXPECT_NEAR(w[ii], wc[ii], 1e-10);
+    }
+
+    std::vector<double> a = h;
+    container::op::dngvd_inplace_op<double, DEVICE_CPU>()(n, n, a.data(), s_copy.data(), w.data());
+    s_copy = s;
+    container::op::dngvd_inplace_op<double, DEVICE_CPU>()(n, n, a.data(), s_copy.data(), w.data());
+    EXPECT_TRUE(container::op::get_lapack_workspace("sygvd", DataType::DT_DOUBLE, n).initialized());
+
+    std::vector<float> hf(h.begin(), h.end()), wf(n), vf(n * n);
+    container::op::dnevx_op<float, DEVICE_CPU>()(n, n, hf.data(), m, wf.data(), vf.data());
+    std::vector<std::complex<double>> identity(n * n, 0), vfc(vf.begin(), vf.end());
+    std::vector<double> wfd(wf.begin(), wf.end());
+    for (int i = 0; i < n; i++) identity[i * n + i] = 1;
+    EXPECT_LT(residual(n, m, hc, identity, wfd.data(), vfc.data()), 1e-4);
+    container::op::dnevx_inplace_op<float, DEVICE_CPU>()(n, n, hf.data(), m, wf.data(), vf.data());
+    for (int ii = 0; ii < m; ii++) {
+        EXPECT_NEAR(wf[ii], wfd[ii], 1e-4);
+    }
+}
+
+TEST(LapackOpTest, DnevrRanges) {
+    const int n = 12, nbands = 5;
+    std::vector<std::complex<double>> h, s, v(n * n);
+    make_problem(n, h, s);
+    std::vector<std::complex<double>> identity(n * n, 0);
+    for (int i = 0; i < n; i++) identity[i * n + i] = 1;
+
+    // All the eigenvalues, the reference for the other ranges.
+    std::vector<double> w_all(n), w(n);
+    int m = 0;
+    container::op::dnevr_op<double, DEVICE_CPU>()('V', 'A', n, n, h.data(), 0.0, 0.0, 0, 0, m, w_all.data(), v.data());
+    ASSERT_EQ(m, n);
+    EXPECT_LT(residual(n, n, h, identity, w_all.data(), v.data()), 1e-10);
+
+    container::op::dnevr_op<double, DEVICE_CPU>()('V', 'I', n, n, h.data(), 0.0, 0.0, 1, nbands, m, w.data(), v.data());
+    ASSERT_EQ(m, nbands);
+    EXPECT_LT(residual(n, nbands, h, identity, w.data(), v.data()), 1e-10);
+
+    // Eigenvalues only, V is not referenced.
+    container::op::dnevr_op<double, DEVICE_CPU>()('N', 'I', n, n, h.data(), 0.0, 0.0, 1, nbands, m, w.data(), nullptr);
+    for (int ii = 0; ii < nbands; ii++) {
+        EXPECT_NEAR(w[ii], w_all[ii], 1e-10);
+    }
+    const double vl = 0.5 * (w_all[2] + w_all[3]), vu = 0.5 * (w_all[6] + w_all[7]);
+    container::op::dnevr_op<double, DEVICE_CPU>()('N', 'V', n, n, h.data(), vl, vu, 0, 0, m, w.data(), nullptr);
+    ASSERT_EQ(m, 4);
+    for (int ii = 0; ii < m; ii++) {
+        EXPECT_NEAR(w[ii], w_all[ii + 3], 1e-10);
+    }
+
+    // The same through dnevx_op without eigenvectors, and the real overload.
+    container::op::dnevx_op<double, DEVICE_CPU>()(n, n, h.data(), nbands, w.data(), nullptr);
+    for (int ii = 0; ii < nbands; ii++) {
+        EXPECT_NEAR(w[ii], w_all[ii], 1e-10);
+    }
+    std::vector<double> hr(n * n), vr(n * n);
+    for (int ii = 0; ii < n * n; ii++) hr[ii] = h[ii].real();
+    container::op::dnevr_op<double, DEVICE_CPU>()('V', 'I', n, n, hr.data(), 0.0, 0.0, 2, 4, m, w.data(), vr.data());
+    ASSERT_EQ(m, 3);
+    std::vector<std::complex<double>> hc(hr.begin(), hr.end()), vc(vr.begin(), vr.end());
+    EXPECT_LT(residual(n, m, hc, identity, w.data(), vc.data()), 1e-10);
+}
+
+TEST(LapackOpTest, FactoredOverlap) {
+    const int n = 11;
+    std::vector<std::complex<double>> h, s;
+    make_problem(n, h, s);
+    // Factorize S once, then solve for several Hamiltonians.
+    std::vector<std::complex<double>> l = s;
+    container::op::potrf_op<double, DEVICE_CPU>()('L', n, l.data(), n);
+    for (int iter = 0; iter < 3; iter++) {
+        for (auto& x : h) x *= 1.0 + 0.1 * iter;
+        std::vector<std::complex<double>> v(n * n), s_copy = s, v_ref(n * n);
+        std::vector<double> w(n), w_ref(n);
+        container::op::dngvd_factored_op<double, DEVICE_CPU>()(n, n, h.data(), l.data(), w.data(), v.data());
+        container::op::dngvd_op<double, DEVICE_CPU>()(n, n, h.data(), s_copy.data(), w_ref.data(), v_ref.data());
+        EXPECT_LT(residual(n, n, h, s, w.data(), v.data()), 1e-10);
+        for (int ii = 0; ii < n; ii++) {
+            EXPECT_NEAR(w[ii], w_ref[ii], 1e-10);
+        }
+    }
+
+    // Real version.
+    std::vector<double> hr(n * n), sr(n * n), vr(n * n), wr(n);
+    for (int ii = 0; ii < n * n; ii++) {
+        hr[ii] = h[ii].real();
+        sr[ii] = s[ii].real();
+    }
+    std::vector<double> lr = sr;
+    container::op::potrf_op<double, DEVICE_CPU>()('L', n, lr.data(), n);
+    container::op::dngvd_factored_op<double, DEVICE_CPU>()(n, n, hr.data(), lr.data(), wr.data(), vr.data());
+    std::vector<std::complex<double>> hc(hr.begin(), hr.end()), sc(sr.begin(), sr.end()), vc(vr.begin(), vr.end());
+    EXPECT_LT(residual(n, n, hc, sc, wr.data(), vc.data()), 1e-10);
+}
+
+TEST(LapackOpTest, MixedPrecisionRefinement) {
+    const int n = 30;
+    std::vector<std::complex<double>> h, s;
+    make_problem(n, h, s);
+    std::vector<std::complex<double>> s_copy = s, v_ref(n * n), v(n * n);
+    std::vector<double> w_ref(n), w(n);
+    container::op::dngvd_op<double, DEVICE_CPU>()(n, n, h.data(), s_copy.data(), w_ref.data(), v_ref.data());
+
+    // Without refinement, the single precision accuracy.
+    container::op::dngvd_mixed_op<double, DEVICE_CPU>()(n, n, h.data(), s.data(), w.data(), v.data(), 1e-12, 0);
+    EXPECT_GT(residual(n, n, h, s, w.data(), v.data()), 1e-9);
+
+    const int steps = container::op::dngvd_mixed_op<double, DEVICE_CPU>()(n, n, h.data(), s.data(), w.data(), v.data());
+    EXPECT_GT(steps, 0);
+    EXPECT_LE(steps, 5);
+    EXPECT_LT(residual(n, n, h, s, w.data(), v.data()), 1e-10);
+    for (int ii = 0; ii < n; ii++) {
+        EXPECT_NEAR(w[ii], w_ref[ii], 1e-11);
+    }
+
+    // Real version.
+    std::vector<double> hr(n * n), sr(n * n), vr(n * n);
+    for (int ii = 0; ii < n * n; ii++) {
+        hr[ii] = h[ii].real();
+        sr[ii] = s[ii].real();
+    }
+    container::op::dngvd_mixed_op<double, DEVICE_CPU>()(n, n, hr.data(), sr.data(), w.data(), vr.data());
+    std::vector<std::complex<double>> hc(hr.begin(), hr.end()), sc(sr.begin(), sr.end()), vc(vr.begin(), vr.end());
+    EXPECT_LT(residual(n, n, hc, sc, w.data(), vc.data()), 1e-10);
+}
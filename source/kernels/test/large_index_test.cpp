@@ -0,0 +1,202 @@
+#include <cstdint>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "../memory_op.h"
+#include "../../tensor.h"
+#include "../../thread_pool.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+using container::DeviceType;
+
+namespace {
+
+// Just above 2^31 elements.
+const int64_t kLarge = (int64_t(1) << 31) + 24;
+
+// Reserve the address space of a large tensor without committing memory, only the pages that
+// are touched get backed, so the tests run on machines with a few GB.
+class LargeBuffer {
+  public:
+    explicit LargeBuffer(const size_t& bytes) : bytes_(bytes) {
+        data_ = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    }
+    ~LargeBuffer() {
+        if (data_ != MAP_FAILED) munmap(data_, bytes_);
+    }
+    bool valid() const { return data_ != MAP_FAILED; }
+    void* data() const { return data_; }
+
+  private:
+    size_t bytes_;
+    void* data_;
+};
+
+// A large buffer whose pages repeat a small memory file with the given period, so that loops
+// can write all of it. Element i and i + period alias, the periods of the buffers in a test are
+// coprime so that the value left in every slot tells which index was written last.
+class AliasedBuffer {
+  public:
+    AliasedBuffer(const size_t& bytes, const size_t& period) : bytes_(bytes), data_(MAP_FAILED), fd_(-1) {
+        void* base = mmap(nullptr, bytes_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) return;
+        data_ = base;
+        fd_ = memfd_create("large_index_test", 0);
+        if (fd_ < 0 || ftruncate(fd_, period) != 0) return;
+        for (size_t offset = 0; offset < bytes_; offset += period) {
+            const size_t length = bytes_ - offset < period ? bytes_ - offset : period;
+            void* page = mmap(static_cast<char*>(base) + offset, length, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_FIXED, fd_, 0);
+            if (page == MAP_FAILED) return;
+        }
+        valid_ = true;
+    }
+    ~AliasedBuffer() {
+        if (data_ != MAP_FAILED) munmap(data_, bytes_);
+        if (fd_ >= 0) close(fd_);
+    }
+    bool valid() const { return valid_; }
+    void* data() const { return data_; }
+
+  private:
+    size_t bytes_;
+    void* data_;
+    int fd_;
+    bool valid_ = false;
+};
+
+// Page multiples with odd prime factors, so that no period divides 2^31.
+const size_t kSourcePeriod = 4096 * 4111;
+const size_t kOutputPeriod = 4096 * 4099;
+
+// The index of the last write into the slot of index ii, for a sequential loop over [0, size).
+int64_t last_alias(const int64_t& ii, const int64_t& size, const int64_t& period) {
+    return ii + (size - 1 - ii) / period * period;
+}
+
+// Indices on both sides of 2^31 and the last one.
+const int64_t kChecked[] = {(int64_t(1) << 31) - 2, (int64_t(1) << 31) - 1,
+                            int64_t(1) << 31, (int64_t(1) << 31) + 1, kLarge - 1};
+
+// Fill the source with the index within its period, exact in float.
+bool make_source(AliasedBuffer& buffer) {
+    if (!buffer.valid()) return false;
+    float* data = static_cast<float*>(buffer.data());
+    for (size_t ii = 0; ii < kSourcePeriod / sizeof(float); ii++) {
+        data[ii] = static_cast<float>(ii);
+    }
+    return true;
+}
+
+// The memory ops run sequentially on one thread, so that the last write is well defined.
+class LargeMemoryOpTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        threads_ = container::get_num_threads();
+        container::set_num_threads(1);
+    }
+    void TearDown() override {
+        container::set_num_threads(threads_);
+    }
+
+  private:
+    int threads_ = 1;
+};
+
+} // namespace
+
+TEST(LargeIndexTest, ShapeAndReshape) {
+    TensorShape shape({3, kLarge / 3 + 1});
+    EXPECT_GT(shape.NumElements(), int64_t(1) << 31);
+
+    LargeBuffer buffer(sizeof(float) * 8 * (kLarge / 8 + 1));
+    if (!buffer.valid()) GTEST_SKIP() << "cannot reserve the address space";
+    Tensor t(buffer.data(), DataType::DT_FLOAT, DeviceType::CpuDevice, TensorShape({kLarge / 8 + 1, 8}));
+    EXPECT_EQ(t.NumElements(), 8 * (kLarge / 8 + 1));
+    t.reshape({-1, 2});
+    EXPECT_EQ(t.shape().dim_size(0), 4 * (kLarge / 8 + 1));
+}
+
+TEST(LargeIndexTest, AccessorAndSlice2D) {
+    const int64_t rows = 3, cols = kLarge / 2;
+    LargeBuffer buffer(sizeof(float) * rows * cols);
+    if (!buffer.valid()) GTEST_SKIP() << "cannot reserve the address space";
+    Tensor t(buffer.data(), DataType::DT_FLOAT, DeviceType::CpuDevice, TensorShape({rows, cols}));
+
+    auto a = t.accessor<float, 2>();
+    EXPECT_EQ(a.offset(2, cols - 4), 2 * cols + cols - 4);
+    EXPECT_GT(a.offset(2, cols - 4), int64_t(1) << 31);
+    for (int64_t j = cols - 4; j < cols; j++) {
+        a(2, j) = static_cast<float>(j - cols);
+    }
+    EXPECT_EQ(t.data<float>()[3 * cols - 1], -1.0f);
+
+    Tensor s = t.slice({2, cols - 4}, {1, 4});
+    EXPECT_EQ(s.shape(), TensorShape({1, 4}));
+    for (int ii = 0; ii < 4; ii++) {
+        EXPECT_EQ(s.data<float>()[ii], static_cast<float>(ii - 4));
+    }
+}
+
+TEST(LargeIndexTest, Slice3D) {
+    const int64_t n0 = 2, n1 = kLarge / 4, n2 = 2;
+    LargeBuffer buffer(sizeof(float) * n0 * n1 * n2);
+    if (!buffer.valid()) GTEST_SKIP() << "cannot reserve the address space";
+    Tensor t(buffer.data(), DataType::DT_FLOAT, DeviceType::CpuDevice, TensorShape({n0, n1, n2}));
+    auto a = t.accessor<float, 3>();
+    a(1, n1 - 1, 0) = 1.0f;
+    a(1, n1 - 1, 1) = 2.0f;
+
+    Tensor s = t.slice({1, n1 - 1, 0}, {1, 1, 2});
+    EXPECT_EQ(s.data<float>()[0], 1.0f);
+    EXPECT_EQ(s.data<float>()[1], 2.0f);
+}
+
+TEST(LargeIndexTest, ParallelLoopIndices) {
+    const int64_t count = container::parallel_reduce<int64_t>(
+            0, kLarge, int64_t(1) << 28, 0,
+            [](int64_t begin, int64_t end, int64_t init) { return init + (end - begin); },
+            [](int64_t x, int64_t y) { return x + y; });
+    EXPECT_EQ(count, kLarge);
+}
+
+TEST_F(LargeMemoryOpTest, SetMemory) {
+    AliasedBuffer buffer(sizeof(float) * kLarge, kOutputPeriod);
+    if (!buffer.valid()) GTEST_SKIP() << "cannot map the aliased buffer";
+    float* data = static_cast<float*>(buffer.data());
+    for (size_t ii = 0; ii < kOutputPeriod / sizeof(float); ii++) {
+        data[ii] = 1.0f;
+    }
+    // An op that stops early or wraps its size leaves some of the 1.0f in place.
+    container::op::set_memory_op<float, container::DEVICE_CPU>()(data, 0, kLarge);
+    for (const int64_t& ii : kChecked) {
+        EXPECT_EQ(data[ii], 0.0f) << ii;
+    }
+}
+
+TEST_F(LargeMemoryOpTest, SynchronizeMemory) {
+    AliasedBuffer source(sizeof(float) * kLarge, kSourcePeriod);
+    AliasedBuffer output(sizeof(float) * kLarge, kOutputPeriod);
+    if (!make_source(source) || !output.valid()) GTEST_SKIP() << "cannot map the aliased buffers";
+    const float* in = static_cast<const float*>(source.data());
+    float* out = static_cast<float*>(output.data());
+    container::op::synchronize_memory_op<float, container::DEVICE_CPU, container::DEVICE_CPU>()(out, in, kLarge);
+    for (const int64_t& ii : kChecked) {
+        EXPECT_EQ(out[ii], in[last_alias(ii, kLarge, kOutputPeriod / sizeof(float))]) << ii;
+    }
+}
+
+TEST_F(LargeMemoryOpTest, CastMemory) {
+    AliasedBuffer source(sizeof(float) * kLarge, kSourcePeriod);
+    AliasedBuffer output(sizeof(double) * kLarge, kOutputPeriod);
+    if (!make_source(source) || !output.valid()) GTEST_SKIP() << "cannot map the aliased buffers";
+    const float* in = static_cast<const float*>(source.data());
+    double* out = static_cast<double*>(output.data());
+    container::op::cast_memory_op<double, float, container::DEVICE_CPU, container::DEVICE_CPU>()(out, in, kLarge);
+    for (const int64_t& ii : kChecked) {
+        EXPECT_EQ(out[ii], static_cast<double>(in[last_alias(ii, kLarge, kOutputPeriod / sizeof(double))])) << ii;
+    }
+}
@@ -0,0 +1,192 @@
+#include <complex>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../linalg_op.h"
+
+namespace {
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+using container::DeviceType;
+
+template <typename T>
+T op_element(const T* x, const int& ld, const int& i, const int& j, const char& trans) {
+    return trans == 'N' ? x[i * ld + j] : x[j * ld + i];
+}
+
+template <typename T>
+std::complex<T> op_element(const std::complex<T>* x, const int& ld, const int& i, const int& j, const char& trans) {
+    if (trans == 'N') return x[i * ld + j];
+    if (trans == 'T') return x[j * ld + i];
+    return std::conj(x[j * ld + i]);
+}
+
+// Naive row-major reference of c = alpha * op(a) * op(b) + beta * c.
+template <typename T>
+void matmul_reference(const char& trans_a, const char& trans_b, const int& m, const int& n, const int& k,
+                      const T& alpha, const T* a, const T* b, const T& beta, T* c)
+{
+    const int lda = trans_a == 'N' ? k : m;
+    const int ldb = trans_b == 'N' ? n : k;
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            T sum = 0;
+            for (int l = 0; l < k; l++) {
+                sum += op_element(a, lda, i, l, trans_a) * op_element(b, ldb, l, j, trans_b);
+            }
+            c[i * n + j] = alpha * sum + beta * c[i * n + j];
+        }
+    }
+}
+
+template <typename T>
+void fill(Tensor& t, const int& seed) {
+    T* data = t.data<T>();
+    for (int ii = 0; ii < t.NumElements(); ii++) {
+        data[ii] = T(0.1 * ((ii * 7 + seed) % 13) - 0.5, 0.05 * ((ii * 3 + seed) % 11) - 0.2);
+    }
+}
+
+} // namespace
+
+class LinalgOpTest : public ::testing::Test {
+  protected:
+    using T = std::complex<double>;
+    const DataType dtype = DataType::DT_COMPLEX_DOUBLE;
+    const std::vector<char> flags = {'N', 'T', 'C'};
+
+    void check_2d(const int& m, const int& n, const int& k) {
+        const T alpha = {1.5, -0.5}, beta = {0.25, 0.75};
+        for (char ta : flags) {
+            for (char tb : flags) {
+                Tensor a(dtype, ta == 'N' ? TensorShape({m, k}) : TensorShape({k, m}));
+                Tensor b(dtype, tb == 'N' ? TensorShape({k, n}) : TensorShape({n, k}));
+                Tensor c(dtype, TensorShape({m, n}));
+                fill<T>(a, 1); fill<T>(b, 2); fill<T>(c, 3);
+                std::vector<T> expected(c.data<T>(), c.data<T>() + c.NumElements());
+                matmul_reference(ta, tb, m, n, k, alpha, a.data<T>(), b.data<T>(), beta, expected.data());
+
+                container::matmul(a, b, c, ta, tb, alpha, beta);
+                for (int ii = 0; ii < c.NumElements(); ii++) {
+                    EXPECT_NEAR(std::abs(c.data<T>()[ii] - expected[ii]), 0.0, 1e-12)
+                        << "trans_a=" << ta << " trans_b=" << tb << " index=" << ii;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(LinalgOpTest, MatmulGemm) {
+    check_2d(4, 5, 3);
+}
+
+TEST_F(LinalgOpTest, MatmulGemvRowVector) {
+    check_2d(1, 6, 4);
+}
+
+TEST_F(LinalgOpTest, MatmulGemvColumnVector) {
+    check_2d(6, 1, 4);
+}
+
+TEST_F(LinalgOpTest, MatmulEmptyInnerDimension) {
+    check_2d(1, 6, 0);
+    check_2d(6, 1, 0);
+    check_2d(4, 5, 0);
+}
+
+TEST_F(LinalgOpTest, MatmulBatched) {
+    const int batch = 3, m = 4, n = 2, k = 5;
+    for (char ta : flags) {
+        Tensor a(dtype, ta == 'N' ? TensorShape({batch, m, k}) : TensorShape({batch, k, m}));
+        Tensor b3(dtype, TensorShape({batch, k, n}));
+        Tensor b2(dtype, TensorShape({k, n}));
+        Tensor c3(dtype, TensorShape({batch, m, n}));
+        Tensor c2(dtype, TensorShape({batch, m, n}));
+        fill<T>(a, 4); fill<T>(b3, 5); fill<T>(b2, 6);
+        c3.zero(); c2.zero();
+
+        container::matmul(a, b3, c3, ta, 'N');
+        container::matmul(a, b2, c2, ta, 'N');
+        for (int ii = 0; ii < batch; ii++) {
+            std::vector<T> expected3(m * n, 0.0), expected2(m * n, 0.0);
+            matmul_reference(ta, 'N', m, n, k, T(1.0), a.data<T>() + ii * m * k, b3.data<T>() + ii * k * n,
+                             T(0.0), expected3.data());
+            matmul_reference(ta, 'N', m, n, k, T(1.0), a.data<T>() + ii * m * k, b2.data<T>(),
+                             T(0.0), expected2.data());
+            for (int jj = 0; jj < m * n; jj++) {
+                EXPECT_NEAR(std::abs(c3.data<T>()[ii * m * n + jj] - expected3[jj]), 0.0, 1e-12);
+                EXPECT_NEAR(std::abs(c2.data<T>()[ii * m * n + jj] - expected2[jj]), 0.0, 1e-12);
+            }
+        }
+    }
+}
+
+TEST_F(LinalgOpTest, MatmulInvalidShape) {
+    Tensor a(dtype, TensorShape({4, 3}));
+    Tensor b(dtype, TensorShape({4, 2}));
+    Tensor c(dtype, TensorShape({4, 2}));
+    EXPECT_THROW(container::matmul(a, b, c), std::invalid_argument);
+    EXPECT_THROW(container::matmul(a, b, c, 'X', 'N'), std::invalid_argument);
+    Tensor c_wrong(dtype, TensorShape({4, 2}));
+    EXPECT_THROW(container::matmul(a, b, c_wrong, 'T', 'N'), std::invalid_argument);
+}
+
+// The shapes are checked before the data are touched, so views of a small buffer suffice.
+TEST_F(LinalgOpTest, MatmulDimensionOverflow) {
+    std::vector<std::complex<double>> data(1);
+    const int64_t big = int64_t(1) << 31;
+    Tensor a(data.data(), dtype, DeviceType::CpuDevice, TensorShape({1, big}));
+    Tensor b(data.data(), dtype, DeviceType::CpuDevice, TensorShape({big, 1}));
+    Tensor c(data.data(), dtype, DeviceType::CpuDevice, TensorShape({1, 1}));
+    EXPECT_THROW(container::matmul(a, b, c), std::invalid_argument);
+    // batch * m of a stacked a with a shared b.
+    Tensor stacked(data.data(), dtype, DeviceType::CpuDevice, TensorShape({3, int64_t(1) << 30, 1}));
+    Tensor shared(data.data(), dtype, DeviceType::CpuDevice, TensorShape({1, 1}));
+    Tensor out(data.data(), dtype, DeviceType::CpuDevice, TensorShape({3, int64_t(1) << 30, 1}));
+    EXPECT_THROW(container::matmul(stacked, shared, out), std::invalid_argument);
+}
+
+TEST_F(LinalgOpTest, MatmulReal) {
+    const int m = 4, n = 3, k = 5;
+    for (char ta : flags) {
+        for (char tb : flags) {
+            Tensor a(DataType::DT_DOUBLE, ta == 'N' ? TensorShape({m, k}) : TensorShape({k, m}));
+            Tensor b(DataType::DT_DOUBLE, tb == 'N' ? TensorShape({k, n}) : TensorShape({n, k}));
+            Tensor c(DataType::DT_DOUBLE, TensorShape({m, n}));
+            Tensor af(DataType::DT_FLOAT, a.shape()), bf(DataType::DT_FLOAT, b.shape()), cf(DataType::DT_FLOAT, c.shape());
+            for (int ii = 0; ii < a.NumElements(); ii++) af.data<float>()[ii] = a.data<double>()[ii] = 0.1 * ((ii * 7 + 1) % 13) - 0.5;
+            for (int ii = 0; ii < b.NumElements(); ii++) bf.data<float>()[ii] = b.data<double>()[ii] = 0.1 * ((ii * 5 + 2) % 11) - 0.4;
+            for (int ii = 0; ii < c.NumElements(); ii++) cf.data<float>()[ii] = c.data<double>()[ii] = 0.1 * ii;
+            std::vector<double> expected(c.data<double>(), c.data<double>() + c.NumElements());
+            matmul_reference(ta, tb, m, n, k, 1.5, a.data<double>(), b.data<double>(), 0.5, expected.data());
+
+            container::matmul(a, b, c, ta, tb, 1.5, 0.5);
+            container::matmul(af, bf, cf, ta, tb, 1.5, 0.5);
+            for (int ii = 0; ii < c.NumElements(); ii++) {
+                EXPECT_NEAR(c.data<double>()[ii], expected[ii], 1e-12) << "trans_a=" << ta << " trans_b=" << tb;
+                EXPECT_NEAR(cf.data<float>()[ii], expected[ii], 1e-5) << "trans_a=" << ta << " trans_b=" << tb;
+            }
+        }
+    }
+    Tensor v(DataType::DT_DOUBLE, TensorShape({1, k}));
+    Tensor w(DataType::DT_DOUBLE, TensorShape({k, n}));
+    Tensor r(DataType::DT_DOUBLE, TensorShape({1, n}));
+    for (int ii = 0; ii < k; ii++) v.data<double>()[ii] = ii + 1;
+    for (int ii = 0; ii < k * n; ii++) w.data<double>()[ii] = ii % 3;
+    container::matmul(v, w, r);
+    for (int jj = 0; jj < n; jj++) {
+        double sum = 0;
+        for (int ii = 0; ii < k; ii++) sum += (ii + 1) * ((ii * n + jj) % 3);
+        EXPECT_NEAR(r.data<double>()[jj], sum, 1e-12);
+    }
+}
+
+TEST_F(LinalgOpTest, MatmulIntegerUnsupported) {
+    Tensor a(DataType::DT_INT, TensorShape({2, 2}));
+    Tensor b(DataType::DT_INT, TensorShape({2, 2}));
+    Tensor c(DataType::DT_INT, TensorShape({2, 2}));
+    EXPECT_THROW(container::matmul(a, b, c), std::invalid_argument);
+}
@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <complex>
+#include <fstream>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "../blas_op.h"
+#include "../memory_op.h"
+#include "../../profiler.h"
+
+using container::DEVICE_CPU;
+using container::DataType;
+using container::Profiler;
+
+namespace {
+
+// Enables a clean profiler for a test, and disables it afterwards.
+class ProfilerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        Profiler::instance().reset();
+        Profiler::instance().enable();
+    }
+
+    void TearDown() override {
+        Profiler::instance().enable(false);
+        Profiler::instance().reset();
+    }
+
+    const Profiler::OpSummary* find(const std::vector<Profiler::OpSummary>& ops,
+                                    const std::string& name, const DataType& data_type) {
+        for (const Profiler::OpSummary& op : ops) {
+            if (op.name == name && op.data_type == data_type) {
+                return &op;
+            }
+        }
+        return nullptr;
+    }
+};
+
+} // namespace
+
+TEST_F(ProfilerTest, RecordsCallsBytesAndFlops) {
+    const int n = 8;
+    std::vector<std::complex<double>> a(n * n, 1.0), b(n * n, 2.0), c(n * n, 0.0);
+    const std::complex<double> alpha = 1.0, beta = 0.0;
+    for (int ii = 0; ii < 3; ii++) {
+        container::op::gemm_op<double, DEVICE_CPU>()('N', 'N', n, n, n, &alpha, a.data(), n,
+                                                     b.data(), n, &beta, c.data(), n);
+    }
+    std::vector<float> x(100, 1.0f), y(100);
+    container::op::synchronize_memory_op<float, DEVICE_CPU, DEVICE_CPU>()(y.data(), x.data(), x.size());
+    container::op::scal_op<double, DEVICE_CPU>()(n, &alpha, c.data(), 1);
+    container::op::axpy_op<double, DEVICE_CPU>()(n, &alpha, a.data(), 1, c.data(), 1);
+
+    const std::vector<Profiler::OpSummary> ops = Profiler::instance().summary();
+    const Profiler::OpSummary* gemm = find(ops, "gemm_op", DataType::DT_COMPLEX_DOUBLE);
+    ASSERT_TRUE(gemm != nullptr);
+    EXPECT_EQ(gemm->calls, 3);
+    EXPECT_DOUBLE_EQ(gemm->flops, 3 * 8.0 * n * n * n);
+    EXPECT_DOUBLE_EQ(gemm->bytes, 3 * 4.0 * n * n * sizeof(std::complex<double>));
+    EXPECT_GE(gemm->time, 0);
+
+    const Profiler::OpSummary* copy = find(ops, "synchronize_memory_op", DataType::DT_FLOAT);
+    ASSERT_TRUE(copy != nullptr);
+    EXPECT_EQ(copy->calls, 1);
+    EXPECT_DOUBLE_EQ(copy->bytes, 2.0 * sizeof(float) * x.size());
+    EXPECT_DOUBLE_EQ(copy->flops, 0.0);
+
+    // A complex multiplication takes 6 real flops, a complex multiply-add 8.
+    const Profiler::OpSummary* scal = find(ops, "scal_op", DataType::DT_COMPLEX_DOUBLE);
+    ASSERT_TRUE(scal != nullptr);
+    EXPECT_DOUBLE_EQ(scal->flops, 6.0 * n);
+    const Profiler::OpSummary* axpy = find(ops, "axpy_op", DataType::DT_COMPLEX_DOUBLE);
+    ASSERT_TRUE(axpy != nullptr);
+    EXPECT_DOUBLE_EQ(axpy->flops, 8.0 * n);
+
+    std::ostringstream table;
+    Profiler::instance().print_summary(table);
+    EXPECT_NE(table.str().find("gemm_op"), std::string::npos);
+    EXPECT_NE(table.str().find("synchronize_memory_op"), std::string::npos);
+}
+
+TEST_F(ProfilerTest, DisabledRecordsNothing) {
+    Profiler::instance().enable(false);
+    std::vector<double> x(10, 1.0), y(10);
+    container::op::synchronize_memory_op<double, DEVICE_CPU, DEVICE_CPU>()(y.data(), x.data(), x.size());
+    EXPECT_TRUE(Profiler::instance().summary().empty());
+}
+
+TEST_F(ProfilerTest, ChromeTrace) {
+    std::vector<double> x(10, 1.0);
+    const double alpha = 2.0;
+    container::op::scal_op<double, DEVICE_CPU>()(10, &alpha, x.data(), 1);
+    container::op::scal_op<double, DEVICE_CPU>()(10, &alpha, x.data(), 1);
+
+    const std::string path = testing::TempDir() + "container_profile.json";
+    Profiler::instance().write_chrome_trace(path);
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    const std::string json = text.str();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"name\":\"scal_op\",\"cat\":\"float64\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"flops\":10}"), std::string::npos);
+    size_t events = 0;
+    for (size_t pos = json.find("\"scal_op\""); pos != std::string::npos; pos = json.find("\"scal_op\"", pos + 1)) {
+        events++;
+    }
+    EXPECT_EQ(events, 2u);
+    std::remove(path.c_str());
+}
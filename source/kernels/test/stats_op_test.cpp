@@ -0,0 +1,116 @@
+#include <cmath>
+#include <limits>
+#include <complex>
+#include <gtest/gtest.h>
+
+#include "../stats_op.h"
+#include "../../thread_pool.h"
+
+using container::Tensor;
+using container::TensorStats;
+using container::DataType;
+
+TEST(StatsOpTest, Real) {
+    Tensor t(DataType::DT_DOUBLE, {4});
+    double* data = t.data<double>();
+    data[0] = 3.0; data[1] = -4.0; data[2] = 1.0; data[3] = 0.0;
+    const TensorStats s = container::stats(t);
+    EXPECT_EQ(s.num_elements, 4);
+    EXPECT_EQ(s.num_nan, 0);
+    EXPECT_EQ(s.num_inf, 0);
+    EXPECT_DOUBLE_EQ(s.min, -4.0);
+    EXPECT_DOUBLE_EQ(s.max, 3.0);
+    EXPECT_DOUBLE_EQ(s.mean.real(), 0.0);
+    EXPECT_DOUBLE_EQ(s.norm, std::sqrt(26.0));
+    EXPECT_TRUE(container::all_finite(t));
+}
+
+TEST(StatsOpTest, Complex) {
+    Tensor t(DataType::DT_COMPLEX, {2});
+    t.data<std::complex<float>>()[0] = {3.0f, 4.0f};
+    t.data<std::complex<float>>()[1] = {1.0f, 0.0f};
+    const TensorStats s = container::stats(t);
+    EXPECT_DOUBLE_EQ(s.min, 1.0);
+    EXPECT_DOUBLE_EQ(s.max, 5.0);
+    EXPECT_DOUBLE_EQ(s.mean.real(), 2.0);
+    EXPECT_DOUBLE_EQ(s.mean.imag(), 2.0);
+    EXPECT_DOUBLE_EQ(s.norm, std::sqrt(26.0));
+}
+
+TEST(StatsOpTest, Integer) {
+    Tensor t(DataType::DT_INT64, {3});
+    t.data<int64_t>()[0] = 7;
+    t.data<int64_t>()[1] = -2;
+    t.data<int64_t>()[2] = 4;
+    const TensorStats s = container::stats(t);
+    EXPECT_DOUBLE_EQ(s.min, -2.0);
+    EXPECT_DOUBLE_EQ(s.max, 7.0);
+    EXPECT_DOUBLE_EQ(s.mean.real(), 3.0);
+    EXPECT_TRUE(container::all_finite(t));
+}
+
+TEST(StatsOpTest, NonFiniteAreCountedAndExcluded) {
+    Tensor t(DataType::DT_COMPLEX_DOUBLE, {4});
+    std::complex<double>* data = t.data<std::complex<double>>();
+    data[0] = {1.0, 1.0};
+    data[1] = {std::numeric_limits<double>::quiet_NaN(), 0.0};
+    data[2] = {0.0, -std::numeric_limits<double>::infinity()};
+    data[3] = {-1.0, 1.0};
+    const TensorStats s = container::stats(t);
+    EXPECT_EQ(s.num_nan, 1);
+    EXPECT_EQ(s.num_inf, 1);
+    EXPECT_DOUBLE_EQ(s.mean.real(), 0.0);
+    EXPECT_DOUBLE_EQ(s.mean.imag(), 1.0);
+    EXPECT_DOUBLE_EQ(s.norm, 2.0);
+    EXPECT_FALSE(container::all_finite(t));
+
+    data[1] = 0.0;
+    EXPECT_FALSE(container::all_finite(t));
+    data[2] = 0.0;
+    EXPECT_TRUE(container::all_finite(t));
+}
+
+TEST(StatsOpTest, NoFiniteElements) {
+    Tensor t(DataType::DT_FLOAT, {2});
+    t.data<float>()[0] = std::numeric_limits<float>::quiet_NaN();
+    t.data<float>()[1] = std::numeric_limits<float>::infinity();
+    const TensorStats s = container::stats(t);
+    EXPECT_TRUE(std::isnan(s.min));
+    EXPECT_TRUE(std::isnan(s.mean.real()));
+    EXPECT_EQ(s.norm, 0.0);
+}
+
+TEST(StatsOpTest, ParallelMatchesSerial) {
+    const int64_t n = 1 << 20;
+    Tensor t(DataType::DT_DOUBLE, {n});
+    double* data = t.data<double>();
+    for (int64_t ii = 0; ii < n; ii++) {
+        data[ii] = std::sin(0.001 * ii);
+    }
+    data[n - 5] = std::numeric_limits<double>::infinity();
+
+    container::set_num_threads(4);
+    const TensorStats parallel = container::stats(t);
+    const bool parallel_finite = container::all_finite(t);
+    container::set_num_threads(1);
+    const TensorStats serial = container::stats(t);
+    container::set_num_threads(0);
+
+    EXPECT_EQ(parallel.num_inf, 1);
+    EXPECT_EQ(serial.num_inf, 1);
+    EXPECT_FALSE(parallel_finite);
+    EXPECT_DOUBLE_EQ(parallel.min, serial.min);
+    EXPECT_DOUBLE_EQ(parallel.max, serial.max);
+    EXPECT_NEAR(parallel.mean.real(), serial.mean.real(), 1e-12);
+    EXPECT_NEAR(parallel.norm, serial.norm, 1e-9);
+}
+
+TEST(StatsOpTest, Describe) {
+    Tensor t(DataType::DT_DOUBLE, {2, 2});
+    for (int ii = 0; ii < 4; ii++) {
+        t.data<double>()[ii] = ii;
+    }
+    EXPECT_EQ(container::describe(t),
+              "Tensor(shape=[2,2], data_type=float64, device_type=cpu): "
+              "min=0, max=3, mean=1.5, norm=3.74166, nan=0, inf=0");
+}
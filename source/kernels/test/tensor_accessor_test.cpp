@@ -0,0 +1,71 @@
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../tensor.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+
+TEST(TensorAccessorTest, IndexingMatchesRowMajorLayout) {
+    Tensor t(DataType::DT_DOUBLE, TensorShape({2, 3, 4}));
+    for (int ii = 0; ii < t.NumElements(); ii++) {
+        t.data<double>()[ii] = ii;
+    }
+    auto a = t.accessor<double, 3>();
+    EXPECT_EQ(a.size(0), 2);
+    EXPECT_EQ(a.size(2), 4);
+    EXPECT_EQ(a.stride(0), 12);
+    EXPECT_EQ(a.stride(1), 4);
+    EXPECT_EQ(a.stride(2), 1);
+    EXPECT_EQ(a.NumElements(), 24);
+    for (int64_t i = 0; i < a.size(0); i++) {
+        for (int64_t j = 0; j < a.size(1); j++) {
+            for (int64_t k = 0; k < a.size(2); k++) {
+                EXPECT_EQ(a(i, j, k), static_cast<double>(i * 12 + j * 4 + k));
+                EXPECT_EQ(a.offset(i, j, k), i * 12 + j * 4 + k);
+                EXPECT_EQ(a[i][j][k], a(i, j, k));
+            }
+        }
+    }
+
+    // Writes go to the tensor.
+    a(1, 2, 3) = -1.0;
+    a[0][1][2] = -2.0;
+    EXPECT_EQ(t.data<double>()[23], -1.0);
+    EXPECT_EQ(t.data<double>()[6], -2.0);
+
+    // A row of a read-only accessor.
+    const Tensor& ct = t;
+    auto row = ct.accessor<const double, 3>()[1][2];
+    EXPECT_EQ(row.size(0), 4);
+    EXPECT_EQ(row[0], 20.0);
+    EXPECT_EQ(row.data(), t.data<double>() + 20);
+}
+
+TEST(TensorAccessorTest, ComplexData) {
+    Tensor t(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 5}));
+    auto a = t.accessor<std::complex<double>, 2>();
+    for (int64_t i = 0; i < 3; i++) {
+        for (int64_t j = 0; j < 5; j++) {
+            a(i, j) = std::complex<double>(i, j);
+        }
+    }
+    EXPECT_EQ(t.data<std::complex<double>>()[7], std::complex<double>(1, 2));
+}
+
+TEST(TensorAccessorTest, ChecksTypeAndRank) {
+    Tensor t(DataType::DT_FLOAT, TensorShape({2, 3}));
+    EXPECT_THROW((t.accessor<double, 2>()), std::invalid_argument);
+    EXPECT_THROW((t.accessor<float, 3>()), std::invalid_argument);
+    EXPECT_NO_THROW((t.accessor<const float, 2>()));
+}
+
+#if defined(__CUDA)
+// The non-owning constructor does not touch the data, so no device memory is needed.
+TEST(TensorAccessorTest, ChecksDevice) {
+    float data = 0;
+    Tensor t(&data, DataType::DT_FLOAT, container::DeviceType::GpuDevice, TensorShape({1}));
+    EXPECT_THROW((t.accessor<float, 1>()), std::invalid_argument);
+}
+#endif // __CUDA
@@ -0,0 +1,109 @@
+#include <cstdio>
+#include <string>
+#include <complex>
+#include <fstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../tensor_archive.h"
+#include "test_utils.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+using container::TensorArchive;
+using container::TensorArchiveWriter;
+using container::test::make_tensor;
+using container::test::expect_equal;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return testing::TempDir() + "container_" + name + ".cta";
+}
+
+} // namespace
+
+TEST(TensorArchiveTest, Crc32) {
+    EXPECT_EQ(container::crc32("123456789", 9), 0xCBF43926u);
+    EXPECT_EQ(container::crc32("", 0), 0u);
+    // The checksum can be computed in pieces.
+    EXPECT_EQ(container::crc32("6789", 4, container::crc32("12345", 5)), 0xCBF43926u);
+}
+
+TEST(TensorArchiveTest, RandomAccess) {
+    const std::string path = temp_path("random_access");
+    const Tensor psi = make_tensor<std::complex<double>>(TensorShape({4, 33}), 1.0);
+    const Tensor h = make_tensor<double>(TensorShape({5, 5}), 2.0);
+    const Tensor rho = make_tensor<float>(TensorShape({3, 1, 7}), 3.0);
+    const Tensor index = make_tensor<int64_t>(TensorShape({9}), 4.0);
+    const Tensor scalar = make_tensor<int>(TensorShape({}), 5.0);
+    {
+        TensorArchiveWriter writer(path);
+        writer.write("psi/k0", psi);
+        writer.write("h/k0", h);
+        writer.write("rho", rho);
+        writer.write("index", index);
+        writer.write("nelec", scalar);
+        EXPECT_THROW(writer.write("rho", rho), std::invalid_argument);
+        writer.close();
+        EXPECT_THROW(writer.write("late", rho), std::invalid_argument);
+    }
+
+    const TensorArchive archive(path);
+    ASSERT_EQ(archive.entries().size(), 5);
+    EXPECT_EQ(archive.entries()[0].name, "psi/k0");
+    EXPECT_TRUE(archive.contains("rho"));
+    EXPECT_FALSE(archive.contains("s/k0"));
+    for (const auto& entry : archive.entries()) {
+        EXPECT_EQ(entry.offset % 64, 0);
+    }
+    EXPECT_EQ(archive.entry("h/k0").shape, TensorShape({5, 5}));
+    EXPECT_EQ(archive.entry("h/k0").bytes, 25 * sizeof(double));
+
+    expect_equal(archive.read("rho"), rho);
+    expect_equal(archive.read("psi/k0"), psi);
+    expect_equal(archive.map("h/k0"), h);
+    expect_equal(archive.map("index"), index);
+    expect_equal(archive.read("nelec"), scalar);
+    EXPECT_THROW(archive.read("s/k0"), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(TensorArchiveTest, DestructorWritesIndex) {
+    const std::string path = temp_path("destructor");
+    const Tensor h = make_tensor<double>(TensorShape({2, 3}), 0.5);
+    {
+        TensorArchiveWriter writer(path);
+        writer.write("h", h);
+    }
+    expect_equal(TensorArchive(path).read("h"), h);
+    std::remove(path.c_str());
+}
+
+TEST(TensorArchiveTest, CorruptData) {
+    const std::string path = temp_path("corrupt");
+    const Tensor h = make_tensor<double>(TensorShape({8}), 1.0);
+    uint64_t offset = 0;
+    {
+        TensorArchiveWriter writer(path);
+        writer.write("h", h);
+    }
+    offset = TensorArchive(path).entry("h").offset;
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset + 3);
+        file.put('\x7f');
+    }
+    const TensorArchive archive(path);
+    EXPECT_THROW(archive.read("h"), std::runtime_error);
+    EXPECT_NO_THROW(archive.read("h", false));
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "not an archive at all, just some text";
+    }
+    EXPECT_THROW(TensorArchive archive2(path), std::invalid_argument);
+    EXPECT_THROW(TensorArchive archive3(temp_path("missing")), std::runtime_error);
+    std::remove(path.c_str());
+}
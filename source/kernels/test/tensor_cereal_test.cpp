@@ -0,0 +1,119 @@
+#include <memory>
+#include <complex>
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/memory.hpp>
+
+#include "../../tensor_cereal.h"
+#include "test_utils.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+using container::test::make_tensor;
+using container::test::expect_equal;
+
+namespace {
+
+// Save a tensor with one archive type and load it into a tensor of the same type and size.
+template <class OutputArchive, class InputArchive>
+void round_trip(const Tensor& input) {
+    std::stringstream stream;
+    {
+        OutputArchive archive(stream);
+        archive(input);
+    }
+    Tensor output(input.data_type(), {input.NumElements()});
+    {
+        InputArchive archive(stream);
+        archive(output);
+    }
+    expect_equal(input, output);
+}
+
+} // namespace
+
+TEST(TensorCerealTest, BinaryRoundTrip) {
+    round_trip<cereal::BinaryOutputArchive, cereal::BinaryInputArchive>(make_tensor<double>({3, 4, 5}, 0.5));
+    round_trip<cereal::BinaryOutputArchive, cereal::BinaryInputArchive>(make_tensor<float>({7}, 1.0));
+    round_trip<cereal::BinaryOutputArchive, cereal::BinaryInputArchive>(make_tensor<int>({2, 3}, 3));
+    round_trip<cereal::BinaryOutputArchive, cereal::BinaryInputArchive>(make_tensor<int64_t>({4, 2}, 9));
+    round_trip<cereal::BinaryOutputArchive, cereal::BinaryInputArchive>(
+            make_tensor<std::complex<double>>({2, 2}, 1.5));
+}
+
+TEST(TensorCerealTest, PortableBinaryRoundTrip) {
+    round_trip<cereal::PortableBinaryOutputArchive, cereal::PortableBinaryInputArchive>(
+            make_tensor<double>({6, 3}, 2.0));
+    round_trip<cereal::PortableBinaryOutputArchive, cereal::PortableBinaryInputArchive>(
+            make_tensor<std::complex<float>>({5}, 0.25));
+}
+
+TEST(TensorCerealTest, JsonRoundTrip) {
+    round_trip<cereal::JSONOutputArchive, cereal::JSONInputArchive>(make_tensor<double>({2, 3}, 0.5));
+    round_trip<cereal::JSONOutputArchive, cereal::JSONInputArchive>(
+            make_tensor<std::complex<double>>({3}, 1.0));
+}
+
+TEST(TensorCerealTest, ShapeRoundTrip) {
+    const TensorShape input({2, 3, 4, 5});
+    TensorShape output;
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive archive(stream);
+        archive(input);
+    }
+    {
+        cereal::BinaryInputArchive archive(stream);
+        archive(output);
+    }
+    EXPECT_EQ(input, output);
+}
+
+TEST(TensorCerealTest, ConstructThroughPointer) {
+    const Tensor input = make_tensor<std::complex<double>>({4, 3}, 0.5);
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive archive(stream);
+        archive(std::make_shared<Tensor>(input));
+    }
+    std::shared_ptr<Tensor> output;
+    {
+        cereal::BinaryInputArchive archive(stream);
+        archive(output);
+    }
+    ASSERT_TRUE(output != nullptr);
+    expect_equal(input, *output);
+}
+
+TEST(TensorCerealTest, ConstructThroughUniquePointer) {
+    const Tensor input = make_tensor<float>({2, 5}, 0.25);
+    std::stringstream stream;
+    {
+        cereal::JSONOutputArchive archive(stream);
+        archive(std::unique_ptr<Tensor>(new Tensor(input)));
+    }
+    std::unique_ptr<Tensor> output;
+    {
+        cereal::JSONInputArchive archive(stream);
+        archive(output);
+    }
+    ASSERT_TRUE(output != nullptr);
+    expect_equal(input, *output);
+}
+
+TEST(TensorCerealTest, MismatchThrows) {
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive archive(stream);
+        archive(make_tensor<double>({3, 4}, 0.0));
+    }
+    Tensor output(DataType::DT_FLOAT, {12});
+    cereal::BinaryInputArchive archive(stream);
+    EXPECT_THROW(archive(output), std::invalid_argument);
+}
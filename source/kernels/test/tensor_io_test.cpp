@@ -0,0 +1,145 @@
+#include <cstdio>
+#include <string>
+#include <complex>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../tensor.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return testing::TempDir() + "container_" + name + ".npy";
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+template <typename T>
+void check_round_trip(const DataType& data_type, const TensorShape& shape, const std::string& name) {
+    Tensor t(data_type, shape);
+    for (int64_t ii = 0; ii < t.NumElements(); ii++) {
+        t.data<T>()[ii] = static_cast<T>(ii * 3 + 1);
+    }
+    const std::string path = temp_path(name);
+    t.save(path);
+    for (const bool map : {true, false}) {
+        const Tensor loaded = Tensor::load(path, map);
+        EXPECT_EQ(loaded.data_type(), data_type);
+        EXPECT_EQ(loaded.shape(), shape);
+        for (int64_t ii = 0; ii < t.NumElements(); ii++) {
+            ASSERT_EQ(loaded.data<T>()[ii], t.data<T>()[ii]);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+TEST(TensorIoTest, RoundTrip) {
+    check_round_trip<float>(DataType::DT_FLOAT, TensorShape({3, 4}), "float");
+    check_round_trip<double>(DataType::DT_DOUBLE, TensorShape({2, 3, 5}), "double");
+    check_round_trip<int>(DataType::DT_INT, TensorShape({7}), "int");
+    check_round_trip<int64_t>(DataType::DT_INT64, TensorShape({2, 2}), "int64");
+    check_round_trip<std::complex<float>>(DataType::DT_COMPLEX, TensorShape({4, 1}), "complex");
+    check_round_trip<std::complex<double>>(DataType::DT_COMPLEX_DOUBLE, TensorShape({3, 3}), "complex_double");
+    check_round_trip<double>(DataType::DT_DOUBLE, TensorShape({}), "scalar");
+    check_round_trip<double>(DataType::DT_DOUBLE, TensorShape({0, 4}), "empty");
+}
+
+TEST(TensorIoTest, NpyHeader) {
+    Tensor t(DataType::DT_DOUBLE, TensorShape({3, 4}));
+    t.zero();
+    const std::string path = temp_path("header");
+    t.save(path);
+    const std::string file = read_file(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(file.compare(0, 6, "\x93NUMPY"), 0);
+    EXPECT_EQ(file[6], 1);
+    EXPECT_EQ(file[7], 0);
+    const size_t header_size = static_cast<unsigned char>(file[8]) | (static_cast<unsigned char>(file[9]) << 8);
+    // The data start at an aligned offset, after a newline-terminated header.
+    EXPECT_EQ((10 + header_size) % 64, 0);
+    EXPECT_EQ(file[10 + header_size - 1], '\n');
+    EXPECT_EQ(file.size(), 10 + header_size + 12 * sizeof(double));
+    const std::string header = file.substr(10, header_size);
+    EXPECT_NE(header.find("'descr': '<f8'"), std::string::npos);
+    EXPECT_NE(header.find("'fortran_order': False"), std::string::npos);
+    EXPECT_NE(header.find("'shape': (3, 4)"), std::string::npos);
+
+    Tensor v(DataType::DT_INT, TensorShape({5}));
+    v.save(path);
+    EXPECT_NE(read_file(path).find("'shape': (5,)"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST(TensorIoTest, MappedDataArePrivate) {
+    Tensor t(DataType::DT_DOUBLE, TensorShape({16}));
+    for (int ii = 0; ii < 16; ii++) t.data<double>()[ii] = ii;
+    const std::string path = temp_path("private");
+    t.save(path);
+    {
+        Tensor mapped = Tensor::load(path);
+        // The data are 64-byte aligned in the mapping.
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped.data()) % 64, 0);
+        mapped.data<double>()[3] = -1.0;
+        // A copy of a mapped tensor owns its own buffer.
+        Tensor copy(mapped);
+        EXPECT_EQ(copy.data<double>()[3], -1.0);
+        EXPECT_NE(copy.data(), mapped.data());
+    }
+    {
+        // The copy does not depend on the mapping, which is released with the mapped tensor.
+        std::unique_ptr<Tensor> mapped(new Tensor(Tensor::load(path)));
+        Tensor copy(*mapped);
+        mapped.reset();
+        EXPECT_EQ(copy.data<double>()[15], 15.0);
+    }
+    EXPECT_EQ(Tensor::load(path).data<double>()[3], 3.0);
+    std::remove(path.c_str());
+}
+
+TEST(TensorIoTest, InvalidFiles) {
+    EXPECT_THROW(Tensor::load(temp_path("missing")), std::runtime_error);
+
+    const std::string path = temp_path("invalid");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a npy file";
+    }
+    EXPECT_THROW(Tensor::load(path), std::invalid_argument);
+
+    // A Fortran-ordered, big-endian file written by hand.
+    const std::string header = "{'descr': '>f8', 'fortran_order': True, 'shape': (2,), }";
+    for (const std::string& dict : {header, std::string("{'descr': '<f8', 'fortran_order': True, 'shape': (2,), }")}) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write("\x93NUMPY\x01\x00", 8);
+        const char length[2] = {static_cast<char>(dict.size()), 0};
+        out.write(length, 2);
+        out << dict << std::string(16, '\0');
+        out.close();
+        EXPECT_THROW(Tensor::load(path), std::invalid_argument);
+    }
+
+    // Truncated data.
+    Tensor t(DataType::DT_DOUBLE, TensorShape({8}));
+    t.save(path);
+    const std::string file = read_file(path);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(file.data(), file.size() - 8);
+    }
+    EXPECT_THROW(Tensor::load(path, true), std::runtime_error);
+    EXPECT_THROW(Tensor::load(path, false), std::runtime_error);
+    std::remove(path.c_str());
+}
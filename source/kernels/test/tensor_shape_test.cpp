@@ -0,0 +1,64 @@
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../tensor.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+
+TEST(TensorShapeTest, CachedElementCount) {
+    TensorShape scalar;
+    EXPECT_EQ(scalar.ndim(), 0);
+    EXPECT_EQ(scalar.NumElements(), 1);
+
+    TensorShape shape({2, 3, 4});
+    EXPECT_EQ(shape.ndim(), 3);
+    EXPECT_EQ(shape.NumElements(), 24);
+    shape.set_dim_size(1, 5);
+    EXPECT_EQ(shape.NumElements(), 40);
+    shape.add_dim(2);
+    EXPECT_EQ(shape.NumElements(), 80);
+    shape.remove_dim(0);
+    EXPECT_EQ(shape, TensorShape({5, 4, 2}));
+    EXPECT_EQ(shape.NumElements(), 40);
+    EXPECT_EQ(shape.dims(), std::vector<int64_t>({5, 4, 2}));
+
+    int64_t product = 1;
+    for (const int64_t& dim : shape) {
+        product *= dim;
+    }
+    EXPECT_EQ(product, shape.NumElements());
+}
+
+TEST(TensorShapeTest, LargeDimsAndCopies) {
+    // More than 2^31 elements.
+    const TensorShape big({1 << 20, 1 << 12});
+    EXPECT_EQ(big.NumElements(), int64_t(1) << 32);
+    const TensorShape wide({int64_t(3) << 31});
+    EXPECT_EQ(wide.dim_size(0), int64_t(3) << 31);
+
+    TensorShape copy(big);
+    EXPECT_EQ(copy, big);
+    copy = TensorShape(std::vector<int>{7, 8});
+    EXPECT_NE(copy, big);
+    EXPECT_EQ(copy.NumElements(), 56);
+    EXPECT_EQ(TensorShape(std::vector<int64_t>{7, 8}), copy);
+}
+
+TEST(TensorShapeTest, MaxDims) {
+    TensorShape shape({1, 2, 1, 2, 1, 2, 1, 2});
+    EXPECT_EQ(shape.ndim(), TensorShape::kMaxDims);
+    EXPECT_EQ(shape.NumElements(), 16);
+    EXPECT_THROW(shape.add_dim(2), std::invalid_argument);
+    EXPECT_THROW(TensorShape({1, 1, 1, 1, 1, 1, 1, 1, 1}), std::invalid_argument);
+}
+
+TEST(TensorShapeTest, TensorReshape) {
+    Tensor t(DataType::DT_DOUBLE, TensorShape({4, 6}));
+    t.reshape({-1, 3, 2});
+    EXPECT_EQ(t.shape(), TensorShape({4, 3, 2}));
+    EXPECT_EQ(t.NumElements(), 24);
+    EXPECT_THROW(t.reshape({5, -1}), std::invalid_argument);
+}
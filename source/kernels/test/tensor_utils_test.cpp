@@ -0,0 +1,121 @@
+#include <string>
+#include <complex>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "../../tensor_utils.h"
+
+using container::Tensor;
+using container::TensorShape;
+using container::DataType;
+using container::PrintOptions;
+
+namespace {
+
+template <typename T>
+Tensor make_tensor(const TensorShape& shape) {
+    Tensor t(container::DataTypeToEnum<T>::value, shape);
+    for (int64_t ii = 0; ii < t.NumElements(); ii++) {
+        t.data<T>()[ii] = static_cast<T>(ii);
+    }
+    return t;
+}
+
+template <typename T>
+std::string format(const Tensor& t) {
+    std::ostringstream os;
+    container::_internal_output(os, t.data<T>(), t.shape(), t.NumElements());
+    return os.str();
+}
+
+// Restores the default print options after every test.
+class TensorUtilsTest : public testing::Test {
+  protected:
+    void TearDown() override {
+        container::set_print_options(PrintOptions());
+    }
+};
+
+} // namespace
+
+TEST_F(TensorUtilsTest, AlignsToTheWidestValue) {
+    Tensor t = make_tensor<int>({2, 3});
+    t.data<int>()[5] = -120;
+    EXPECT_EQ(format<int>(t), "[[   0,    1,    2],\n"
+                              "       [   3,    4, -120]]");
+
+    Tensor d(DataType::DT_DOUBLE, {3});
+    d.data<double>()[0] = 1.0;
+    d.data<double>()[1] = -2.5;
+    d.data<double>()[2] = 10.125;
+    EXPECT_EQ(format<double>(d), "[ 1.000, -2.500, 10.125]");
+}
+
+TEST_F(TensorUtilsTest, IntegralFloatsKeepOneFraction) {
+    EXPECT_EQ(format<float>(make_tensor<float>({3})), "[0.0, 1.0, 2.0]");
+}
+
+TEST_F(TensorUtilsTest, Complex) {
+    Tensor t(DataType::DT_COMPLEX_DOUBLE, {2});
+    t.data<std::complex<double>>()[0] = {1.5, -2.0};
+    t.data<std::complex<double>>()[1] = {0.0, 3.25};
+    EXPECT_EQ(format<std::complex<double>>(t), "[{ 1.50, -2.00}, { 0.00,  3.25}]");
+}
+
+TEST_F(TensorUtilsTest, PrecisionIsClamped) {
+    PrintOptions options;
+    options.precision = 1000;
+    container::set_print_options(options);
+    EXPECT_EQ(container::get_print_options().precision, container::kMaxPrintPrecision);
+    options.precision = -1;
+    container::set_print_options(options);
+    EXPECT_EQ(container::get_print_options().precision, 0);
+
+    // The widest doubles still fit the formatting buffer.
+    container::set_print_options(PrintOptions());
+    Tensor d(DataType::DT_DOUBLE, {2});
+    d.data<double>()[0] = -1.0e308;
+    d.data<double>()[1] = 0.5;
+    const std::string text = format<double>(d);
+    EXPECT_EQ(text.size(), 2 * 312 + 4);
+    EXPECT_EQ(text.substr(text.size() - 5), " 0.5]");
+}
+
+TEST_F(TensorUtilsTest, SummarizesLargeTensors) {
+    const Tensor t = make_tensor<int64_t>({2000});
+    EXPECT_EQ(format<int64_t>(t), "[   0,    1,    2, ..., 1997, 1998, 1999]");
+
+    PrintOptions options;
+    options.threshold = 10;
+    options.edge_items = 1;
+    container::set_print_options(options);
+    EXPECT_EQ(format<int>(make_tensor<int>({4, 5})), "[[ 0, ...,  4],\n"
+                                                      "       ...,\n"
+                                                      "       [15, ..., 19]]");
+}
+
+TEST_F(TensorUtilsTest, ThresholdDisablesSummary) {
+    PrintOptions options;
+    options.threshold = 5000;
+    container::set_print_options(options);
+    const std::string text = format<int>(make_tensor<int>({2000}));
+    EXPECT_EQ(text.find("..."), std::string::npos);
+    EXPECT_NE(text.find("1000"), std::string::npos);
+}
+
+TEST_F(TensorUtilsTest, NestsAnyNumberOfDimensions) {
+    EXPECT_EQ(format<int>(make_tensor<int>({2, 1, 1, 2})), "[[[[0, 1]]],\n"
+                                                           "\n"
+                                                           "\n"
+                                                           "       [[[2, 3]]]]");
+    EXPECT_EQ(format<int>(make_tensor<int>({2, 2, 2})), "[[[0, 1],\n"
+                                                        "        [2, 3]],\n"
+                                                        "\n"
+                                                        "       [[4, 5],\n"
+                                                        "        [6, 7]]]");
+}
+
+TEST_F(TensorUtilsTest, ScalarAndEmpty) {
+    EXPECT_EQ(format<int>(make_tensor<int>(TensorShape())), "0");
+    EXPECT_EQ(format<double>(make_tensor<double>({2, 0})), "[[],\n       []]");
+}
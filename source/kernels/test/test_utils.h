@@ -0,0 +1,33 @@
+#ifndef CONTAINER_KERNELS_TEST_TEST_UTILS_H
+#define CONTAINER_KERNELS_TEST_TEST_UTILS_H
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include "../../tensor.h"
+
+namespace container {
+namespace test {
+
+// A tensor of the given type and shape holding seed, seed + 1, ...
+template <typename T>
+Tensor make_tensor(const TensorShape& shape, const double& seed) {
+    Tensor t(DataTypeToEnum<T>::value, shape);
+    for (int64_t ii = 0; ii < t.NumElements(); ii++) {
+        t.data<T>()[ii] = static_cast<T>(seed + ii);
+    }
+    return t;
+}
+
+// Expect the same data type, shape and bytes.
+inline void expect_equal(const Tensor& a, const Tensor& b) {
+    ASSERT_EQ(a.data_type(), b.data_type());
+    ASSERT_EQ(a.shape(), b.shape());
+    const size_t bytes = a.NumElements() * Tensor::SizeOfType(a.data_type());
+    EXPECT_EQ(std::memcmp(a.data(), b.data(), bytes), 0);
+}
+
+} // namespace test
+} // namespace container
+
+#endif // CONTAINER_KERNELS_TEST_TEST_UTILS_H
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "../../thread_pool.h"
+#include "../memory_op.h"
+
+namespace {
+
+class ThreadPoolTest : public testing::Test {
+  protected:
+    void SetUp() override { container::set_num_threads(4); }
+    void TearDown() override { container::set_num_threads(0); }
+};
+
+} // namespace
+
+TEST_F(ThreadPoolTest, ParallelForCoversRange) {
+    EXPECT_EQ(container::get_num_threads(), 4);
+    const int64_t n = 100003;
+    std::vector<int> hits(n, 0);
+    container::parallel_for(3, n, 1000, [&](int64_t begin, int64_t end) {
+        EXPECT_LT(begin, end);
+        for (int64_t ii = begin; ii < end; ii++) hits[ii]++;
+    });
+    for (int64_t ii = 0; ii < n; ii++) {
+        ASSERT_EQ(hits[ii], ii < 3 ? 0 : 1);
+    }
+
+    // A loop not larger than the grain size runs serially as a single chunk.
+    int calls = 0;
+    container::parallel_for(0, 10, 10, [&](int64_t begin, int64_t end) {
+        calls++;
+        EXPECT_EQ(begin, 0);
+        EXPECT_EQ(end, 10);
+    });
+    EXPECT_EQ(calls, 1);
+    container::parallel_for(5, 5, 1, [&](int64_t, int64_t) { calls++; });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(ThreadPoolTest, ParallelReduce) {
+    const int64_t n = 1 << 20;
+    const int64_t sum = container::parallel_reduce<int64_t>(
+            0, n, 1024, 0,
+            [](int64_t begin, int64_t end, int64_t init) {
+                for (int64_t ii = begin; ii < end; ii++) init += ii;
+                return init;
+            },
+            [](int64_t a, int64_t b) { return a + b; });
+    EXPECT_EQ(sum, n * (n - 1) / 2);
+
+    // The result is deterministic for a given number of threads.
+    std::vector<double> x(n);
+    for (int64_t ii = 0; ii < n; ii++) x[ii] = 1.0 / (ii + 1);
+    auto partial = [&](int64_t begin, int64_t end, double init) {
+        for (int64_t ii = begin; ii < end; ii++) init += x[ii];
+        return init;
+    };
+    auto plus = [](double a, double b) { return a + b; };
+    const double first = container::parallel_reduce(0, n, 1000, 0.0, partial, plus);
+    for (int ii = 0; ii < 5; ii++) {
+        EXPECT_EQ(container::parallel_reduce(0, n, 1000, 0.0, partial, plus), first);
+    }
+}
+
+TEST_F(ThreadPoolTest, NestedLoopsRunSerially) {
+    std::atomic<int64_t> total(0);
+    container::parallel_for(0, 64, 1, [&](int64_t begin, int64_t end) {
+        EXPECT_TRUE(container::ThreadPool::in_parallel_region());
+        for (int64_t ii = begin; ii < end; ii++) {
+            int inner_calls = 0;
+            container::parallel_for(0, 1000, 1, [&](int64_t b, int64_t e) {
+                inner_calls++;
+                total += e - b;
+            });
+            EXPECT_EQ(inner_calls, 1);
+        }
+    });
+    EXPECT_FALSE(container::ThreadPool::in_parallel_region());
+    EXPECT_EQ(total.load(), 64000);
+}
+
+TEST_F(ThreadPoolTest, ExceptionIsRethrown) {
+    EXPECT_THROW(container::parallel_for(0, 1000, 1, [](int64_t begin, int64_t end) {
+        if (begin <= 500 && 500 < end) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+    // The pool is still usable.
+    std::atomic<int64_t> count(0);
+    container::parallel_for(0, 1000, 1, [&](int64_t begin, int64_t end) { count += end - begin; });
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST_F(ThreadPoolTest, SerialAndPinnedPools) {
+    container::set_num_threads(1);
+    EXPECT_EQ(container::get_num_threads(), 1);
+    int calls = 0;
+    container::parallel_for(0, 1 << 20, 1, [&](int64_t, int64_t) { calls++; });
+    EXPECT_EQ(calls, 1);
+
+    container::ThreadPool pool(3, true);
+    EXPECT_EQ(pool.num_threads(), 3);
+    std::vector<int> hits(100, 0);
+    pool.run(100, [&](int64_t chunk) { hits[chunk]++; });
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 100);
+}
+
+TEST_F(ThreadPoolTest, MemoryOps) {
+    const size_t n = (1 << 20) + 7;
+    std::vector<double> a(n), b(n, 0.0);
+    std::vector<float> c(n);
+    for (size_t ii = 0; ii < n; ii++) a[ii] = static_cast<double>(ii);
+    container::op::synchronize_memory_op<double, container::DEVICE_CPU, container::DEVICE_CPU>()(b.data(), a.data(), n);
+    container::op::cast_memory_op<float, double, container::DEVICE_CPU, container::DEVICE_CPU>()(c.data(), a.data(), n);
+    for (size_t ii = 0; ii < n; ii++) {
+        ASSERT_EQ(b[ii], a[ii]);
+        ASSERT_EQ(c[ii], static_cast<float>(a[ii]));
+    }
+    container::op::set_memory_op<double, container::DEVICE_CPU>()(b.data(), 0, n);
+    for (size_t ii = 0; ii < n; ii++) {
+        ASSERT_EQ(b[ii], 0.0);
+    }
+}
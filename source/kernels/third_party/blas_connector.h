@@ -36,6 +36,10 @@ double dnrm2_( const int *n, const double *X, const int *incX );
 double dznrm2_( const int *n, const std::complex<double> *X, const int *incX );
 
 // level 2: matrix-std::vector operations, O(n^2) data and O(n^2) work.
+void sgemv_(const char*const transa, const int*const m, const int*const n,
+            const float*const alpha, const float*const a, const int*const lda, const float*const x, const int*const incx,
+            const float*const beta, float*const y, const int*const incy);
+
 void dgemv_(const char*const transa, const int*const m, const int*const n,
             const double*const alpha, const double*const a, const int*const lda, const double*const x, const int*const incx,
             const double*const beta, double*const y, const int*const incy);
@@ -83,6 +87,10 @@ void zhemm_(char *side, char *uplo, int *m, int *n,std::complex<double> *alpha,
             std::complex<double> *a,  int *lda,  std::complex<double> *b, int *ldb, std::complex<double> *beta, std::complex<double> *c, int *ldc);
 
 //solving triangular matrix with multiple right hand sides
+void strsm_(char *side, char* uplo, char *transa, char *diag, int *m, int *n,
+            float* alpha, float* a, int *lda, float*b, int *ldb);
+void ctrsm_(char *side, char* uplo, char *transa, char *diag, int *m, int *n,
+            std::complex<float>* alpha, std::complex<float>* a, int *lda, std::complex<float>*b, int *ldb);
 void dtrsm_(char *side, char* uplo, char *transa, char *diag, int *m, int *n,
             double* alpha, double* a, int *lda, double*b, int *ldb);
 void ztrsm_(char *side, char* uplo, char *transa, char *diag, int *m, int *n,
@@ -193,6 +201,57 @@ public:
                &alpha, b, &ldb, a, &lda,
                &beta, c, &ldc);
     }
+    // C = a * A.? * B.? + b * C, column-major version without swapping A and B.
+    static inline
+    void gemm_cm(const char transa, const char transb, const int m, const int n, const int k,
+                 const float alpha, const float *a, const int lda, const float *b, const int ldb,
+                 const float beta, float *c, const int ldc)
+    {
+        sgemm_(&transa, &transb, &m, &n, &k,
+               &alpha, a, &lda, b, &ldb,
+               &beta, c, &ldc);
+    }
+    static inline
+    void gemm_cm(const char transa, const char transb, const int m, const int n, const int k,
+                 const double alpha, const double *a, const int lda, const double *b, const int ldb,
+                 const double beta, double *c, const int ldc)
+    {
+        dgemm_(&transa, &transb, &m, &n, &k,
+               &alpha, a, &lda, b, &ldb,
+               &beta, c, &ldc);
+    }
+    static inline
+    void gemm_cm(const char transa, const char transb, const int m, const int n, const int k,
+                 const std::complex<float> alpha, const std::complex<float> *a, const int lda, const std::complex<float> *b, const int ldb,
+                 const std::complex<float> beta, std::complex<float> *c, const int ldc)
+    {
+        cgemm_(&transa, &transb, &m, &n, &k,
+               &alpha, a, &lda, b, &ldb,
+               &beta, c, &ldc);
+    }
+    static inline
+    void gemm_cm(const char transa, const char transb, const int m, const int n, const int k,
+                 const std::complex<double> alpha, const std::complex<double> *a, const int lda, const std::complex<double> *b, const int ldb,
+                 const std::complex<double> beta, std::complex<double> *c, const int ldc)
+    {
+        zgemm_(&transa, &transb, &m, &n, &k,
+               &alpha, a, &lda, b, &ldb,
+               &beta, c, &ldc);
+    }
+    static inline
+    void gemv(const char trans, const int m, const int n,
+              const float alpha, const float *A, const int lda, const float *X, const int incx,
+              const float beta, float *Y, const int incy)
+    {
+        sgemv_(&trans, &m, &n, &alpha, A, &lda, X, &incx, &beta, Y, &incy);
+    }
+    static inline
+    void gemv(const char trans, const int m, const int n,
+              const double alpha, const double *A, const int lda, const double *X, const int incx,
+              const double beta, double *Y, const int incy)
+    {
+        dgemv_(&trans, &m, &n, &alpha, A, &lda, X, &incx, &beta, Y, &incy);
+    }
     static inline
     void gemv(const char trans, const int m, const int n,
               const std::complex<float> alpha, const std::complex<float> *A, const int lda, const std::complex<float> *X, const int incx,
@@ -226,6 +285,32 @@ public:
         return dznrm2_( &n, X, &incX );
     }
 
+    // B = a * op(A)^-1 * B (side = 'L') or B = a * B * op(A)^-1 (side = 'R'), A is triangular, column-major.
+    static inline
+    void trsm(char side, char uplo, char transa, char diag, int m, int n,
+              float alpha, const float *a, int lda, float *b, int ldb)
+    {
+        strsm_(&side, &uplo, &transa, &diag, &m, &n, &alpha, const_cast<float*>(a), &lda, b, &ldb);
+    }
+    static inline
+    void trsm(char side, char uplo, char transa, char diag, int m, int n,
+              double alpha, const double *a, int lda, double *b, int ldb)
+    {
+        dtrsm_(&side, &uplo, &transa, &diag, &m, &n, &alpha, const_cast<double*>(a), &lda, b, &ldb);
+    }
+    static inline
+    void trsm(char side, char uplo, char transa, char diag, int m, int n,
+              std::complex<float> alpha, const std::complex<float> *a, int lda, std::complex<float> *b, int ldb)
+    {
+        ctrsm_(&side, &uplo, &transa, &diag, &m, &n, &alpha, const_cast<std::complex<float>*>(a), &lda, b, &ldb);
+    }
+    static inline
+    void trsm(char side, char uplo, char transa, char diag, int m, int n,
+              std::complex<double> alpha, const std::complex<double> *a, int lda, std::complex<double> *b, int ldb)
+    {
+        ztrsm_(&side, &uplo, &transa, &diag, &m, &n, &alpha, const_cast<std::complex<double>*>(a), &lda, b, &ldb);
+    }
+
     // copies a into b
     static inline
     void copy(const long n, const double *a, const int incx, double *b, const int incy)
@@ -37,14 +37,67 @@ void zhegvd_(const int* itype, const char* jobz, const char* uplo, const int* n,
 void cheevx_(const char* jobz, const char* range, const char* uplo, const int* n,
              std::complex<float> *a, const int* lda,
              const float* vl, const float* vu, const int* il, const int* iu, const float* abstol,
-             const int* m, float* w, std::complex<float> *z, const int *ldz,
+             int* m, float* w, std::complex<float> *z, const int *ldz,
              std::complex<float> *work, const int* lwork, float* rwork, int* iwork, int* ifail, int* info);
 
 void zheevx_(const char* jobz, const char* range, const char* uplo, const int* n,
              std::complex<double> *a, const int* lda,
              const double* vl, const double* vu, const int* il, const int* iu, const double* abstol,
-             const int* m, double* w, std::complex<double> *z, const int *ldz,
+             int* m, double* w, std::complex<double> *z, const int *ldz,
              std::complex<double> *work, const int* lwork, double* rwork, int* iwork, int* ifail, int* info);
+
+// selected eigenpairs of a hermitian matrix with the MRRR algorithm
+void cheevr_(const char* jobz, const char* range, const char* uplo, const int* n,
+             std::complex<float>* a, const int* lda,
+             const float* vl, const float* vu, const int* il, const int* iu, const float* abstol,
+             int* m, float* w, std::complex<float>* z, const int* ldz, int* isuppz,
+             std::complex<float>* work, const int* lwork, float* rwork, const int* lrwork,
+             int* iwork, const int* liwork, int* info);
+
+void zheevr_(const char* jobz, const char* range, const char* uplo, const int* n,
+             std::complex<double>* a, const int* lda,
+             const double* vl, const double* vu, const int* il, const int* iu, const double* abstol,
+             int* m, double* w, std::complex<double>* z, const int* ldz, int* isuppz,
+             std::complex<double>* work, const int* lwork, double* rwork, const int* lrwork,
+             int* iwork, const int* liwork, int* info);
+
+// Cholesky factorization of a positive definite matrix
+void spotrf_(const char* uplo, const int* n, float* a, const int* lda, int* info);
+void dpotrf_(const char* uplo, const int* n, double* a, const int* lda, int* info);
+void cpotrf_(const char* uplo, const int* n, std::complex<float>* a, const int* lda, int* info);
+void zpotrf_(const char* uplo, const int* n, std::complex<double>* a, const int* lda, int* info);
+
+// reduce the generalized eigenproblem to the standard form with the Cholesky factor of B
+void ssygst_(const int* itype, const char* uplo, const int* n,
+             float* a, const int* lda, const float* b, const int* ldb, int* info);
+void dsygst_(const int* itype, const char* uplo, const int* n,
+             double* a, const int* lda, const double* b, const int* ldb, int* info);
+void chegst_(const int* itype, const char* uplo, const int* n,
+             std::complex<float>* a, const int* lda, const std::complex<float>* b, const int* ldb, int* info);
+void zhegst_(const int* itype, const char* uplo, const int* n,
+             std::complex<double>* a, const int* lda, const std::complex<double>* b, const int* ldb, int* info);
+
+// solve the generalized eigenproblem Ax=eBx, where A is real symmetric
+void ssygvd_(const int* itype, const char* jobz, const char* uplo, const int* n,
+             float* a, const int* lda, const float* b, const int* ldb, float* w,
+             float* work, const int* lwork, int* iwork, const int* liwork, int* info);
+
+void dsygvd_(const int* itype, const char* jobz, const char* uplo, const int* n,
+             double* a, const int* lda, const double* b, const int* ldb, double* w,
+             double* work, const int* lwork, int* iwork, const int* liwork, int* info);
+
+// selected eigenpairs of a real symmetric matrix with the MRRR algorithm
+void ssyevr_(const char* jobz, const char* range, const char* uplo, const int* n,
+             float* a, const int* lda,
+             const float* vl, const float* vu, const int* il, const int* iu, const float* abstol,
+             int* m, float* w, float* z, const int* ldz, int* isuppz,
+             float* work, const int* lwork, int* iwork, const int* liwork, int* info);
+
+void dsyevr_(const char* jobz, const char* range, const char* uplo, const int* n,
+             double* a, const int* lda,
+             const double* vl, const double* vu, const int* il, const int* iu, const double* abstol,
+             int* m, double* w, double* z, const int* ldz, int* isuppz,
+             double* work, const int* lwork, int* iwork, const int* liwork, int* info);
 }
 
 // Class LapackConnector provide the connector to fortran lapack routine.
@@ -60,7 +113,7 @@ private:
                 std::complex<double>* a, const int lda,
                 const std::complex<double>* b, const int ldb, double* w,
                 std::complex<double>* work, int lwork, double* rwork, int lrwork,
-                int* iwork, int liwork, int info)
+                int* iwork, int liwork, int& info)
     {
         zhegvd_(&itype, &jobz, &uplo, &n,
                 a, &lda, b, &ldb, w,
@@ -74,8 +127,8 @@ private:
     void zheevx( const int itype, const char jobz, const char range, const char uplo, const int n,
                  std::complex<double>* a, const int lda,
                  const double vl, const double vu, const int il, const int iu, const double abstol,
-                 const int m, double* w, std::complex<double>* z, const int ldz,
-                 std::complex<double>* work, const int lwork, double* rwork, int* iwork, int* ifail, int info)
+                 int& m, double* w, std::complex<double>* z, const int ldz,
+                 std::complex<double>* work, const int lwork, double* rwork, int* iwork, int* ifail, int& info)
     {
         zheevx_(&jobz, &range, &uplo, &n,
                 a, &lda, &vl, &vu, &il, &iu,
@@ -90,7 +143,7 @@ void xhegvd(const int itype, const char jobz, const char uplo, const int n,
             std::complex<float>* a, const int lda,
             const std::complex<float>* b, const int ldb, float* w,
             std::complex<float>* work, int lwork, float* rwork, int lrwork,
-            int* iwork, int liwork, int info)
+            int* iwork, int liwork, int& info)
 {
     // call the fortran routine
     chegvd_(&itype, &jobz, &uplo, &n,
@@ -105,7 +158,7 @@ void xhegvd(const int itype, const char jobz, const char uplo, const int n,
             std::complex<double>* a, const int lda,
             const std::complex<double>* b, const int ldb, double* w,
             std::complex<double>* work, int lwork, double* rwork, int lrwork,
-            int* iwork, int liwork, int info)
+            int* iwork, int liwork, int& info)
 {
     // call the fortran routine
     zhegvd_(&itype, &jobz, &uplo, &n,
@@ -127,8 +180,8 @@ static inline
 void xheevx( const int itype, const char jobz, const char range, const char uplo, const int n,
              std::complex<float>* a, const int lda,
              const float vl, const float vu, const int il, const int iu, const float abstol,
-             const int m, float* w, std::complex<float>* z, const int ldz,
-             std::complex<float>* work, const int lwork, float* rwork, int* iwork, int* ifail, int info)
+             int& m, float* w, std::complex<float>* z, const int ldz,
+             std::complex<float>* work, const int lwork, float* rwork, int* iwork, int* ifail, int& info)
 {
     cheevx_(&jobz, &range, &uplo, &n,
             a, &lda, &vl, &vu, &il, &iu,
@@ -141,13 +194,141 @@ static inline
 void xheevx( const int itype, const char jobz, const char range, const char uplo, const int n,
              std::complex<double>* a, const int lda,
              const double vl, const double vu, const int il, const int iu, const double abstol,
-             const int m, double* w, std::complex<double>* z, const int ldz,
-             std::complex<double>* work, const int lwork, double* rwork, int* iwork, int* ifail, int info)
+             int& m, double* w, std::complex<double>* z, const int ldz,
+             std::complex<double>* work, const int lwork, double* rwork, int* iwork, int* ifail, int& info)
 {
     zheevx_(&jobz, &range, &uplo, &n,
             a, &lda, &vl, &vu, &il, &iu,
             &abstol, &m, w, z, &ldz,
             work, &lwork, rwork, iwork, ifail, &info);
 }
+
+// wrap function of fortran lapack routine cheevr.
+static inline
+void xheevr(const char jobz, const char range, const char uplo, const int n,
+            std::complex<float>* a, const int lda,
+            const float vl, const float vu, const int il, const int iu, const float abstol,
+            int& m, float* w, std::complex<float>* z, const int ldz, int* isuppz,
+            std::complex<float>* work, const int lwork, float* rwork, const int lrwork,
+            int* iwork, const int liwork, int& info)
+{
+    cheevr_(&jobz, &range, &uplo, &n,
+            a, &lda, &vl, &vu, &il, &iu,
+            &abstol, &m, w, z, &ldz, isuppz,
+            work, &lwork, rwork, &lrwork, iwork, &liwork, &info);
+}
+
+// wrap function of fortran lapack routine zheevr.
+static inline
+void xheevr(const char jobz, const char range, const char uplo, const int n,
+            std::complex<double>* a, const int lda,
+            const double vl, const double vu, const int il, const int iu, const double abstol,
+            int& m, double* w, std::complex<double>* z, const int ldz, int* isuppz,
+            std::complex<double>* work, const int lwork, double* rwork, const int lrwork,
+            int* iwork, const int liwork, int& info)
+{
+    zheevr_(&jobz, &range, &uplo, &n,
+            a, &lda, &vl, &vu, &il, &iu,
+            &abstol, &m, w, z, &ldz, isuppz,
+            work, &lwork, rwork, &lrwork, iwork, &liwork, &info);
+}
+
+// wrap function of fortran lapack routine xpotrf.
+static inline
+void xpotrf(const char uplo, const int n, float* a, const int lda, int& info)
+{
+    spotrf_(&uplo, &n, a, &lda, &info);
+}
+static inline
+void xpotrf(const char uplo, const int n, double* a, const int lda, int& info)
+{
+    dpotrf_(&uplo, &n, a, &lda, &info);
+}
+static inline
+void xpotrf(const char uplo, const int n, std::complex<float>* a, const int lda, int& info)
+{
+    cpotrf_(&uplo, &n, a, &lda, &info);
+}
+static inline
+void xpotrf(const char uplo, const int n, std::complex<double>* a, const int lda, int& info)
+{
+    zpotrf_(&uplo, &n, a, &lda, &info);
+}
+
+// wrap function of fortran lapack routine xhegst, xsygst for real data.
+static inline
+void xhegst(const int itype, const char uplo, const int n,
+            float* a, const int lda, const float* b, const int ldb, int& info)
+{
+    ssygst_(&itype, &uplo, &n, a, &lda, b, &ldb, &info);
+}
+static inline
+void xhegst(const int itype, const char uplo, const int n,
+            double* a, const int lda, const double* b, const int ldb, int& info)
+{
+    dsygst_(&itype, &uplo, &n, a, &lda, b, &ldb, &info);
+}
+static inline
+void xhegst(const int itype, const char uplo, const int n,
+            std::complex<float>* a, const int lda, const std::complex<float>* b, const int ldb, int& info)
+{
+    chegst_(&itype, &uplo, &n, a, &lda, b, &ldb, &info);
+}
+static inline
+void xhegst(const int itype, const char uplo, const int n,
+            std::complex<double>* a, const int lda, const std::complex<double>* b, const int ldb, int& info)
+{
+    zhegst_(&itype, &uplo, &n, a, &lda, b, &ldb, &info);
+}
+
+// wrap function of fortran lapack routine ssygvd.
+static inline
+void xsygvd(const int itype, const char jobz, const char uplo, const int n,
+            float* a, const int lda, const float* b, const int ldb, float* w,
+            float* work, const int lwork, int* iwork, const int liwork, int& info)
+{
+    ssygvd_(&itype, &jobz, &uplo, &n,
+            a, &lda, b, &ldb, w,
+            work, &lwork, iwork, &liwork, &info);
+}
+
+// wrap function of fortran lapack routine dsygvd.
+static inline
+void xsygvd(const int itype, const char jobz, const char uplo, const int n,
+            double* a, const int lda, const double* b, const int ldb, double* w,
+            double* work, const int lwork, int* iwork, const int liwork, int& info)
+{
+    dsygvd_(&itype, &jobz, &uplo, &n,
+            a, &lda, b, &ldb, w,
+            work, &lwork, iwork, &liwork, &info);
+}
+
+// wrap function of fortran lapack routine ssyevr.
+static inline
+void xsyevr(const char jobz, const char range, const char uplo, const int n,
+            float* a, const int lda,
+            const float vl, const float vu, const int il, const int iu, const float abstol,
+            int& m, float* w, float* z, const int ldz, int* isuppz,
+            float* work, const int lwork, int* iwork, const int liwork, int& info)
+{
+    ssyevr_(&jobz, &range, &uplo, &n,
+            a, &lda, &vl, &vu, &il, &iu,
+            &abstol, &m, w, z, &ldz, isuppz,
+            work, &lwork, iwork, &liwork, &info);
+}
+
+// wrap function of fortran lapack routine dsyevr.
+static inline
+void xsyevr(const char jobz, const char range, const char uplo, const int n,
+            double* a, const int lda,
+            const double vl, const double vu, const int il, const int iu, const double abstol,
+            int& m, double* w, double* z, const int ldz, int* isuppz,
+            double* work, const int lwork, int* iwork, const int liwork, int& info)
+{
+    dsyevr_(&jobz, &range, &uplo, &n,
+            a, &lda, &vl, &vu, &il, &iu,
+            &abstol, &m, w, z, &ldz, isuppz,
+            work, &lwork, iwork, &liwork, &info);
+}
 };
 #endif  // CONTAINER_KERNELS_THIRD_PARTY_LAPACK_CONNECTOR_H
@@ -0,0 +1,151 @@
+#include "profiler.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace container {
+
+namespace {
+
+bool env_enabled() {
+    const char* value = std::getenv("CONTAINER_PROFILE");
+    return value != nullptr && *value != '\0' && std::atoi(value) != 0;
+}
+
+int64_t steady_nanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A small, stable id of the calling thread for the trace.
+int thread_id() {
+    static std::atomic<int> next_id(0);
+    thread_local int id = next_id++;
+    return id;
+}
+
+std::string type_name(const DataType& data_type) {
+    std::ostringstream os;
+    os << data_type;
+    return os.str();
+}
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled_(env_enabled());
+
+const size_t Profiler::max_events;
+
+Profiler::Profiler() : epoch_(steady_nanoseconds()) {}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::enable(const bool& on) {
+    enabled_.store(on);
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+    totals_.clear();
+}
+
+int64_t Profiler::now() const {
+    return steady_nanoseconds() - epoch_;
+}
+
+void Profiler::record(const Event& event) {
+    Event copy = event;
+    copy.thread = thread_id();
+    std::lock_guard<std::mutex> lock(mutex_);
+    OpSummary& total = totals_[std::make_pair(std::string(event.name), event.data_type)];
+    if (total.calls == 0) {
+        total.name = event.name;
+        total.data_type = event.data_type;
+    }
+    total.calls++;
+    total.time += event.duration;
+    total.bytes += event.bytes;
+    total.flops += event.flops;
+    if (events_.size() < max_events) {
+        events_.push_back(copy);
+    }
+}
+
+std::vector<Profiler::OpSummary> Profiler::summary() const {
+    std::vector<OpSummary> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& total : totals_) {
+            result.push_back(total.second);
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const OpSummary& a, const OpSummary& b) {
+        return a.time > b.time;
+    });
+    return result;
+}
+
+void Profiler::print_summary(std::ostream& os) const {
+    const std::vector<OpSummary> ops = summary();
+    const std::ios::fmtflags flags = os.flags();
+    os << std::left << std::setw(28) << "op" << std::setw(18) << "data_type" << std::right
+       << std::setw(10) << "calls" << std::setw(14) << "total(ms)" << std::setw(14) << "mean(us)"
+       << std::setw(12) << "GB/s" << std::setw(12) << "GFLOP/s" << "\n";
+    os << std::fixed;
+    for (const OpSummary& op : ops) {
+        const double seconds = op.time * 1e-9;
+        os << std::left << std::setw(28) << op.name << std::setw(18) << type_name(op.data_type) << std::right
+           << std::setw(10) << op.calls
+           << std::setw(14) << std::setprecision(3) << op.time * 1e-6
+           << std::setw(14) << std::setprecision(3) << op.time * 1e-3 / op.calls;
+        if (seconds > 0 && op.bytes > 0) {
+            os << std::setw(12) << std::setprecision(2) << op.bytes / seconds * 1e-9;
+        }
+        else {
+            os << std::setw(12) << "-";
+        }
+        if (seconds > 0 && op.flops > 0) {
+            os << std::setw(12) << std::setprecision(2) << op.flops / seconds * 1e-9;
+        }
+        else {
+            os << std::setw(12) << "-";
+        }
+        os << "\n";
+    }
+    os.flags(flags);
+}
+
+void Profiler::write_chrome_trace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Profiler: failed to create " + path + ".");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Complete ("X") events, the times are in microseconds.
+    out << "{\"traceEvents\":[";
+    out << std::fixed << std::setprecision(3);
+    for (size_t ii = 0; ii < events_.size(); ii++) {
+        const Event& event = events_[ii];
+        out << (ii == 0 ? "\n" : ",\n")
+            << "{\"name\":\"" << event.name << "\",\"cat\":\"" << type_name(event.data_type)
+            << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+            << ",\"ts\":" << event.begin * 1e-3 << ",\"dur\":" << event.duration * 1e-3
+            << ",\"args\":{\"bytes\":" << std::setprecision(0) << event.bytes
+            << ",\"flops\":" << event.flops << std::setprecision(3) << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    if (!out) {
+        throw std::runtime_error("Profiler: failed to write " + path + ".");
+    }
+}
+
+} // namespace container
@@ -0,0 +1,197 @@
+#ifndef CONTAINER_PROFILER_H
+#define CONTAINER_PROFILER_H
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <ostream>
+
+#include "tensor_types.h"
+
+namespace container {
+
+/**
+ * @brief Records the calls of the op functors, for a summary table and a Chrome trace.
+ *
+ * Every instrumented op opens a ProfileScope, which records the wall time of the call together
+ * with the bytes it moved and the floating point operations it did. The profiler is off by
+ * default, a disabled scope costs a single relaxed atomic load. It is enabled with enable(),
+ * or by setting the environment variable CONTAINER_PROFILE to a nonzero value.
+ *
+ * Times are inclusive: an op calling other ops (e.g. dngvd_op copying its input with
+ * synchronize_memory_op) also counts the time of the inner ops, the trace shows them nested.
+ * Only ops running on the host are timed, GPU kernels are asynchronous.
+ */
+class Profiler {
+  public:
+    /**
+     * @brief A single op call.
+     */
+    struct Event {
+        const char* name = nullptr;   ///< The op name, a string literal.
+        DataType data_type = DataType::DT_INVALID;
+        int64_t begin = 0;            ///< Start time in nanoseconds since the profiler was created.
+        int64_t duration = 0;         ///< Wall time in nanoseconds.
+        double bytes = 0.0;           ///< The bytes read and written.
+        double flops = 0.0;           ///< The floating point operations, 0 if data dependent.
+        int thread = 0;               ///< A small id of the calling thread.
+    };
+
+    /**
+     * @brief The totals of all the calls of an op with a data type.
+     */
+    struct OpSummary {
+        std::string name;
+        DataType data_type = DataType::DT_INVALID;
+        int64_t calls = 0;
+        int64_t time = 0;             ///< Total wall time in nanoseconds.
+        double bytes = 0.0;
+        double flops = 0.0;
+    };
+
+    /**
+     * @brief The process-wide profiler.
+     */
+    static Profiler& instance();
+
+    /**
+     * @brief Whether ops are recorded.
+     */
+    static bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Start or stop recording, the recorded calls are kept.
+     */
+    void enable(const bool& on = true);
+
+    /**
+     * @brief Discard all recorded calls.
+     */
+    void reset();
+
+    /**
+     * @brief Record an op call, see ProfileScope.
+     */
+    void record(const Event& event);
+
+    /**
+     * @brief The nanoseconds since the profiler was created.
+     */
+    int64_t now() const;
+
+    /**
+     * @brief The totals per op and data type, sorted by decreasing time.
+     */
+    std::vector<OpSummary> summary() const;
+
+    /**
+     * @brief Print the summary as a table: calls, total and mean time, GB/s and GFLOP/s.
+     */
+    void print_summary(std::ostream& os) const;
+
+    /**
+     * @brief Write the recorded calls as a Chrome trace_event JSON file.
+     *
+     * The file can be opened in chrome://tracing or https://ui.perfetto.dev.
+     * Only the first max_events calls are kept for the trace, the summary counts all of them.
+     *
+     * @throw std::runtime_error if the file can not be written.
+     */
+    void write_chrome_trace(const std::string& path) const;
+
+    /// The maximum number of calls kept for the trace.
+    static const size_t max_events = 1 << 20;
+
+  private:
+    Profiler();
+
+    static std::atomic<bool> enabled_;
+
+    int64_t epoch_ = 0;
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+    std::map<std::pair<std::string, DataType>, OpSummary> totals_;
+};
+
+/**
+ * @brief Records the enclosing op call if the profiler is enabled.
+ *
+ *     ProfileScope profile("gemm_op", DataTypeToEnum<T>::value, bytes, flops);
+ */
+class ProfileScope {
+  public:
+    ProfileScope(const char* name, const DataType& data_type, const double& bytes, const double& flops) {
+        if (Profiler::enabled()) {
+            event_.name = name;
+            event_.data_type = data_type;
+            event_.bytes = bytes;
+            event_.flops = flops;
+            event_.begin = Profiler::instance().now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (event_.name != nullptr) {
+            Profiler& profiler = Profiler::instance();
+            event_.duration = profiler.now() - event_.begin;
+            profiler.record(event_);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    Profiler::Event event_;
+};
+
+/**
+ * @brief The kind of the arithmetic of an op, which sets the cost of its complex version.
+ */
+enum class FlopKind {
+    MultiplyAdd, ///< a * b + c per element, e.g. axpy, gemv, gemm and the factorizations.
+    Multiply,    ///< a * b per element, e.g. scal.
+};
+
+/**
+ * @brief The real flops of an op on complex data per real flop of the same op on real data.
+ *
+ * A complex multiply-add takes 8 real flops against 2, a complex multiplication 6 against 1.
+ */
+template <typename T>
+struct FlopFactor {
+    static double value(const FlopKind& = FlopKind::MultiplyAdd) { return 1.0; }
+};
+
+template <typename T>
+struct FlopFactor<std::complex<T>> {
+    static double value(const FlopKind& kind = FlopKind::MultiplyAdd) {
+        return kind == FlopKind::Multiply ? 6.0 : 4.0;
+    }
+};
+
+/**
+ * @brief The data type of the elements of an op operand, for ProfileScope.
+ */
+template <typename T>
+DataType profile_type(const T*) {
+    return DataTypeToEnum<T>::value;
+}
+
+/**
+ * @brief The flops of an op on the elements of an operand, given the flops of the same op on real data.
+ */
+template <typename T>
+double profile_flops(const T*, const double& real_flops, const FlopKind& kind = FlopKind::MultiplyAdd) {
+    return FlopFactor<T>::value(kind) * real_flops;
+}
+
+} // namespace container
+
+#endif // CONTAINER_PROFILER_H
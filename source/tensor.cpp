@@ -14,8 +14,8 @@ namespace container {
 // Constructor that creates a tensor with the given data type and shape using the default allocator.
 Tensor::Tensor(DataType data_type, const TensorShape& shape)
         : data_type_(data_type),
-          shape_(shape),
           device_(DeviceType::CpuDevice),
+          shape_(shape),
           allocator_(GetAllocator(device_)),
           buffer_(allocator_, allocator_->allocate(shape.NumElements() * SizeOfType(data_type))) {
 }
@@ -23,25 +23,34 @@ Tensor::Tensor(DataType data_type, const TensorShape& shape)
 // Constructor that creates a tensor with the given data pointer, data type, device type and shape.
 Tensor::Tensor(void *data, DataType data_type, DeviceType device, const TensorShape &shape)
         : data_type_(data_type),
-          shape_(shape),
           device_(device),
+          shape_(shape),
           allocator_(GetAllocator(device_)),
           buffer_(data) {}
 
 // Construct a new Tensor object with the given data type and shape.
 Tensor::Tensor(DataType data_type, DeviceType device, const TensorShape& shape)
         : data_type_(data_type),
-          shape_(shape),
           device_(device),
+          shape_(shape),
           allocator_(GetAllocator(device_)),
           buffer_(allocator_, allocator_->allocate(shape.NumElements() * SizeOfType(data_type))) {}
 
+// Construct a CPU tensor owning the given data and the allocator that releases them.
+Tensor::Tensor(DataType data_type, const TensorShape& shape, std::unique_ptr<Allocator> allocator, void* data)
+        : data_type_(data_type),
+          device_(DeviceType::CpuDevice),
+          shape_(shape),
+          allocator_(allocator.get()),
+          buffer_(std::move(allocator), data) {}
+
 // Construct a new Tensor object by copying another Tensor.
+// The allocator of other may be owned by its buffer, so the copy takes the default one.
 Tensor::Tensor(const Tensor& other)
         : data_type_(other.data_type_),
-          shape_(other.shape_),
           device_(other.device_),
-          allocator_(other.allocator_),
+          shape_(other.shape_),
+          allocator_(GetAllocator(device_)),
           buffer_(allocator_, allocator_->allocate(shape_.NumElements() * SizeOfType(data_type_)))
 {
     TEMPLATE_ALL_2(data_type_, device_,
@@ -64,6 +73,25 @@ int64_t Tensor::NumElements() const { return shape_.NumElements(); }
 // Get a pointer to the data buffer of the tensor.
 void* Tensor::data() const { return buffer_.data(); }
 
+// Report a data type mismatch in data<T>() and exit.
+void Tensor::DataTypeMismatch() {
+    std::cerr << "Tensor data type does not match requested type." << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+// Check the data type and the rank requested by accessor<T, Rank>().
+void Tensor::CheckAccessor(DataType data_type, int rank) const {
+    if (device_ != DeviceType::CpuDevice) {
+        throw std::invalid_argument("TensorAccessor: the data of the tensor is not on the CPU.");
+    }
+    if (data_type != data_type_) {
+        throw std::invalid_argument("TensorAccessor: the requested type does not match the data type of the tensor.");
+    }
+    if (rank != static_cast<int>(shape_.ndim())) {
+        throw std::invalid_argument("TensorAccessor: the requested rank does not match the rank of the tensor.");
+    }
+}
+
 // Get the TensorBuffer object that holds the data of the tensor.
 const TensorBuffer& Tensor::buffer() const { return buffer_; }
 
@@ -94,9 +122,10 @@ void Tensor::zero() {
 // Reshape the current tensor
 void Tensor::reshape(TensorShape shape) {
     // check the -1 dimension
-    int num = 1, auto_shape = 0, dim_count = -1, dim_idx = -1;
+    int64_t num = 1;
+    int auto_shape = 0, dim_count = -1, dim_idx = -1;
 
-    for (int dim : shape.dims()) {
+    for (const int64_t& dim : shape) {
         dim_count++;
         if (dim < 1 && dim != -1) {
             throw std::invalid_argument("Invalid shape, dim of tensor must >= 1 or equal to -1(auto shape).");
@@ -113,7 +142,7 @@ void Tensor::reshape(TensorShape shape) {
     }
     // auto reshape
     if (auto_shape == 1) {
-        int dim_ = static_cast<int>(this->NumElements()) / (-num);
+        const int64_t dim_ = this->NumElements() / (-num);
         if (dim_ < 1 || -dim_ * num != this->NumElements()) {
             throw std::invalid_argument("Invalid shape, total number of elements does not match!");
         }
@@ -128,7 +157,7 @@ void Tensor::reshape(TensorShape shape) {
 }
 
 // Slice the current tensor object.
-Tensor Tensor::slice(const std::vector<int> &start, const std::vector<int> &size) const {
+Tensor Tensor::slice(const std::vector<int64_t> &start, const std::vector<int64_t> &size) const {
     // check the ndim of input shape
     if (start.size() > 3 || size.size() > 3) {
         throw std::invalid_argument("TensorSlice: The slice method only supports tensor ranks that are less than or equal to 2.");
@@ -164,23 +193,23 @@ Tensor Tensor::slice(const std::vector<int> &start, const std::vector<int> &size
                                output.data<T_>(), this->data<T_>() + start[0], size[0]))
     }
     else if (ndim == 2) {
-        for (int i = 0; i < size[0]; i++) {
-            int offset = (start[0] + i) * shape_.dim_size(1) + start[1];
-            int offset_out = i * size[1];
+        for (int64_t i = 0; i < size[0]; i++) {
+            const int64_t offset = (start[0] + i) * shape_.dim_size(1) + start[1];
+            const int64_t offset_out = i * size[1];
             TEMPLATE_ALL_2(this->data_type_, this->device_,
                            op::synchronize_memory_op<T_, DEVICE_, DEVICE_>()(
                                    output.data<T_>() + offset_out, this->data<T_>() + offset, size[1]))
         }
     }
     else if (ndim == 3) {
-        for (int i = 0; i < size[0]; i++) {
-            for (int j = 0; j < size[1]; j++) {
-                int offset = (i + start[0]) * shape_.dim_size(1) * shape_.dim_size(2) +
+        for (int64_t i = 0; i < size[0]; i++) {
+            for (int64_t j = 0; j < size[1]; j++) {
+                const int64_t offset = (i + start[0]) * shape_.dim_size(1) * shape_.dim_size(2) +
                         (j + start[1]) * shape_.dim_size(2) + start[2];
-                int offset_out = i * size[1] * size[2] + j * size[2];
+                const int64_t offset_out = i * size[1] * size[2] + j * size[2];
                 TEMPLATE_ALL_2(this->data_type_, this->device_,
                                op::synchronize_memory_op<T_, DEVICE_, DEVICE_>()(
-                                       output.data<T_>() + offset_out, this->data<T_>() + offset, size[1]))
+                                       output.data<T_>() + offset_out, this->data<T_>() + offset, size[2]))
             }
         }
     }
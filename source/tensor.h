@@ -1,12 +1,15 @@
 #ifndef CONTAINER_TENSOR_H
 #define CONTAINER_TENSOR_H
 
+#include <string>
+#include <memory>
 #include <complex>
 
 #include "allocator.h"
 #include "tensor_types.h"
 #include "tensor_shape.h"
 #include "tensor_buffer.h"
+#include "tensor_accessor.h"
 #include "kernels/memory_op.h"
 
 namespace container {
@@ -105,27 +108,39 @@ class Tensor {
      *
      * @return A typed pointer to the data buffer of the tensor.
      *
-     * @note The template parameter `T` must match the data type of the tensor. If `T`
-     * does not match the data type of the tensor, the behavior is undefined.
+     * @note The template parameter `T` must match the data type of the tensor, the program
+     * exits with an error message otherwise.
      *
      * @note This function returns a pointer to the first element in the data buffer
      * of the tensor. If the tensor is empty, the behavior is undefined.
      */
     template <typename T>
     T* data() const {
-        if ((std::is_same<T, float>::value && data_type_ != DataType::DT_FLOAT) ||
-            (std::is_same<T, int>::value && data_type_ != DataType::DT_INT) ||
-            (std::is_same<T, int64_t>::value && data_type_ != DataType::DT_INT64) ||
-            (std::is_same<T, double>::value && data_type_ != DataType::DT_DOUBLE) ||
-            (std::is_same<T, std::complex<float>>::value && data_type_ != DataType::DT_COMPLEX) ||
-            (std::is_same<T, std::complex<double>>::value && data_type_ != DataType::DT_COMPLEX_DOUBLE))
-        {
-            std::cerr << "Tensor data type does not match requested type." << std::endl;
-            exit(EXIT_FAILURE);
+        if (DataTypeToEnum<T>::value != data_type_) {
+            DataTypeMismatch();
         }
         return buffer_.base<T>();
     }
 
+    /**
+     * @brief Get a typed, fixed-rank accessor of the data, for hot loops.
+     *
+     * The device, the data type and the rank are checked once here, the indexing of the accessor
+     * does no further checks, see TensorAccessor.
+     *
+     * @tparam T The data type of the tensor, const for read-only access.
+     * @tparam Rank The number of dimensions of the tensor.
+     *
+     * @return An accessor of the data, valid as long as the tensor is.
+     *
+     * @throw std::invalid_argument if the tensor is not on the CPU, or `T` or `Rank` do not match it.
+     */
+    template <typename T, int Rank>
+    TensorAccessor<T, Rank> accessor() const {
+        CheckAccessor(DataTypeToEnum<typename std::remove_const<T>::type>::value, Rank);
+        return TensorAccessor<T, Rank>(buffer_.base<T>(), shape_.begin());
+    }
+
 
     /**
      * @brief Get the TensorBuffer object that holds the data of the tensor.
@@ -148,6 +163,7 @@ class Tensor {
      * Supported data types:
      * DT_FLOAT: 4 bytes
      * DT_INT32: 4 bytes
+     * DT_INT64: 8 bytes
      * DT_DOUBLE: 8 bytes
      * DT_COMPLEX: 8 bytes (2 floats)
      * DT_COMPLEX_DOUBLE: 16 bytes (2 doubles)
@@ -158,6 +174,8 @@ class Tensor {
                 return sizeof(float);
             case DataType::DT_INT:
                 return sizeof(int32_t);
+            case DataType::DT_INT64:
+                return sizeof(int64_t);
             case DataType::DT_DOUBLE:
                 return sizeof(double);
             case DataType::DT_COMPLEX:
@@ -237,10 +255,75 @@ class Tensor {
      *
      * @note Currently, this method only supports tensors with a ndim of less than or equal to 3.
      */
-    Tensor slice(const std::vector<int>& start, const std::vector<int>& size) const;
+    Tensor slice(const std::vector<int64_t>& start, const std::vector<int64_t>& size) const;
+
+    /**
+     * @brief Save the tensor to a file in the NumPy .npy format (version 1.0).
+     *
+     * The header holds the data type, the row-major shape and is padded so that the raw data
+     * start at a 64-byte aligned offset, the file can be read with numpy.load. GPU tensors are
+     * copied to the host first.
+     *
+     * @param path The path of the file, overwritten if it exists.
+     *
+     * @throw std::runtime_error if the file can not be written.
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Load a tensor from a .npy file, e.g. written by save() or numpy.save.
+     *
+     * With map = true the file is mapped into memory instead of being read: no data are copied,
+     * pages are read on first access, and the mapping is released with the tensor. The mapping
+     * is private, writes to the tensor do not change the file.
+     *
+     * @param path The path of the file.
+     * @param map Map the file (zero-copy) instead of reading it into a new buffer.
+     *
+     * @return A CPU tensor with the data type and shape of the file.
+     *
+     * @throw std::runtime_error if the file can not be read.
+     * @throw std::invalid_argument if the file is not a little-endian, C-ordered .npy file of a
+     *        supported data type.
+     */
+    static Tensor load(const std::string& path, bool map = true);
+
+    /**
+     * @brief Map raw data of a file into a CPU tensor, without copying.
+     *
+     * The mapping is private and released with the tensor, see load().
+     *
+     * @param path The path of the file.
+     * @param offset The byte offset of the data in the file, any alignment.
+     * @param data_type The data type of the tensor.
+     * @param shape The shape of the tensor.
+     *
+     * @throw std::runtime_error if the file can not be mapped or is too short.
+     */
+    static Tensor map(const std::string& path, const size_t& offset, DataType data_type, const TensorShape& shape);
 
 private:
 
+    /**
+     * @brief Construct a CPU tensor owning the given data and the allocator that releases them.
+     *
+     * @param data_type The data type of the tensor.
+     * @param shape The shape of the tensor.
+     * @param allocator The allocator that frees the data, deleted with the tensor.
+     * @param data The data pointer.
+     */
+    Tensor(DataType data_type, const TensorShape& shape, std::unique_ptr<Allocator> allocator, void* data);
+
+    /**
+     * @brief Report a data type mismatch in data<T>() and exit, kept out of line.
+     */
+    [[noreturn]] static void DataTypeMismatch();
+
+    /**
+     * @brief Check the device, the data type and the rank requested by accessor<T, Rank>().
+     */
+    void CheckAccessor(DataType data_type, int rank) const;
+
     /**
      * @brief Get the Allocator object according to the given device type.
      *
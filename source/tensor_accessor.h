@@ -0,0 +1,128 @@
+#ifndef CONTAINER_TENSOR_ACCESSOR_H
+#define CONTAINER_TENSOR_ACCESSOR_H
+
+#include <cstdint>
+#include <type_traits>
+
+namespace container {
+
+/**
+ * @brief A typed, fixed-rank view of row-major tensor data for hot loops.
+ *
+ * The accessor is obtained once from `Tensor::accessor<T, Rank>()`, which checks the data type and
+ * the rank. Indexing is then plain 64-bit offset arithmetic with strides precomputed at
+ * construction: there are no further checks or branches, so the compiler can vectorize loops
+ * written against it, e.g.
+ *
+ *     auto a = tensor.accessor<double, 3>();
+ *     for (int64_t i = 0; i < a.size(0); i++)
+ *         for (int64_t j = 0; j < a.size(1); j++)
+ *             for (int64_t k = 0; k < a.size(2); k++)
+ *                 a(i, j, k) *= 2.0;
+ *
+ * `operator[]` drops the leading dimension, a[i][j] is a rank-1 accessor of the row (i, j).
+ * The accessor does not own the data, it must not outlive the tensor.
+ *
+ * @tparam T The element type, const for read-only access.
+ * @tparam Rank The number of dimensions.
+ */
+template <typename T, int Rank>
+class TensorAccessor {
+    static_assert(Rank > 0, "TensorAccessor: the rank must be positive.");
+
+  public:
+    /**
+     * @brief Construct an accessor of contiguous row-major data.
+     *
+     * @param data The first element.
+     * @param sizes The Rank dimension sizes.
+     */
+    template <typename Index>
+    TensorAccessor(T* data, const Index* sizes) : data_(data) {
+        int64_t stride = 1;
+        for (int ii = Rank - 1; ii >= 0; ii--) {
+            sizes_[ii] = static_cast<int64_t>(sizes[ii]);
+            strides_[ii] = stride;
+            stride *= sizes_[ii];
+        }
+    }
+
+    /**
+     * @brief Construct an accessor with the given sizes and strides, in elements.
+     */
+    TensorAccessor(T* data, const int64_t* sizes, const int64_t* strides) : data_(data) {
+        for (int ii = 0; ii < Rank; ii++) {
+            sizes_[ii] = sizes[ii];
+            strides_[ii] = strides[ii];
+        }
+    }
+
+    /**
+     * @brief The element at the given Rank indices.
+     */
+    template <typename... Indices>
+    T& operator()(Indices... indices) const {
+        static_assert(sizeof...(Indices) == Rank, "TensorAccessor: the number of indices must match the rank.");
+        return data_[offset_from<0>(static_cast<int64_t>(indices)...)];
+    }
+
+    /**
+     * @brief The offset of an element from data(), in elements.
+     */
+    template <typename... Indices>
+    int64_t offset(Indices... indices) const {
+        static_assert(sizeof...(Indices) == Rank, "TensorAccessor: the number of indices must match the rank.");
+        return offset_from<0>(static_cast<int64_t>(indices)...);
+    }
+
+    /**
+     * @brief Index the leading dimension, a rank Rank - 1 accessor or an element for Rank == 1.
+     */
+    typename std::conditional<Rank == 1, T&, TensorAccessor<T, (Rank > 1 ? Rank - 1 : 1)>>::type
+    operator[](const int64_t& index) const {
+        return subscript(index, std::integral_constant<bool, Rank == 1>());
+    }
+
+    /// @brief The pointer to the first element.
+    T* data() const { return data_; }
+
+    /// @brief The size of a dimension.
+    int64_t size(const int& dim) const { return sizes_[dim]; }
+
+    /// @brief The stride of a dimension, in elements.
+    int64_t stride(const int& dim) const { return strides_[dim]; }
+
+    /// @brief The total number of elements.
+    int64_t NumElements() const {
+        int64_t n = 1;
+        for (int ii = 0; ii < Rank; ii++) {
+            n *= sizes_[ii];
+        }
+        return n;
+    }
+
+  private:
+    template <int Dim>
+    int64_t offset_from() const { return 0; }
+
+    template <int Dim, typename... Rest>
+    int64_t offset_from(const int64_t& index, Rest... rest) const {
+        return index * strides_[Dim] + offset_from<Dim + 1>(rest...);
+    }
+
+    T& subscript(const int64_t& index, std::true_type) const {
+        return data_[index * strides_[0]];
+    }
+
+    TensorAccessor<T, (Rank > 1 ? Rank - 1 : 1)> subscript(const int64_t& index, std::false_type) const {
+        return TensorAccessor<T, (Rank > 1 ? Rank - 1 : 1)>(data_ + index * strides_[0], sizes_ + 1, strides_ + 1);
+    }
+
+    T* data_;
+    int64_t sizes_[Rank];
+    int64_t strides_[Rank];
+};
+
+} // namespace container
+
+#endif // CONTAINER_TENSOR_ACCESSOR_H
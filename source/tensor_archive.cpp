@@ -0,0 +1,233 @@
+#include "tensor_archive.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace container {
+
+namespace {
+
+const char kArchiveMagic[8] = {'C', 'T', 'A', 'R', 'C', 'H', 'I', 'V'};
+const uint32_t kArchiveVersion = 1;
+// magic, version, reserved, index offset, number of entries.
+const uint64_t kPreambleSize = 32;
+// The data of every tensor start at a multiple of this.
+const uint64_t kArchiveAlignment = 64;
+
+struct Crc32Table {
+    uint32_t values[256];
+
+    Crc32Table() {
+        for (uint32_t ii = 0; ii < 256; ii++) {
+            uint32_t crc = ii;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            values[ii] = crc;
+        }
+    }
+};
+
+// The fields are written in the byte order of the host, all the supported hosts are little-endian.
+template <typename T>
+void put(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T get(std::istream& in, const std::string& path) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::invalid_argument("TensorArchive: " + path + " is truncated.");
+    }
+    return value;
+}
+
+void write_preamble(std::ostream& out, const uint64_t& index_offset, const uint64_t& num_entries) {
+    out.write(kArchiveMagic, sizeof(kArchiveMagic));
+    put<uint32_t>(out, kArchiveVersion);
+    put<uint32_t>(out, 0);
+    put<uint64_t>(out, index_offset);
+    put<uint64_t>(out, num_entries);
+}
+
+bool is_supported(const DataType& data_type) {
+    return data_type == DataType::DT_FLOAT || data_type == DataType::DT_DOUBLE ||
+           data_type == DataType::DT_INT || data_type == DataType::DT_INT64 ||
+           data_type == DataType::DT_COMPLEX || data_type == DataType::DT_COMPLEX_DOUBLE;
+}
+
+} // namespace
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+    static const Crc32Table table;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t ii = 0; ii < size; ii++) {
+        crc = table.values[(crc ^ bytes[ii]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+TensorArchiveWriter::TensorArchiveWriter(const std::string& path)
+        : path_(path), out_(path, std::ios::binary | std::ios::trunc)
+{
+    if (!out_) {
+        throw std::runtime_error("TensorArchiveWriter: failed to create " + path + ".");
+    }
+    // The index offset is filled in by close().
+    write_preamble(out_, 0, 0);
+    position_ = kPreambleSize;
+}
+
+TensorArchiveWriter::~TensorArchiveWriter() {
+    try {
+        close();
+    }
+    catch (...) {
+    }
+}
+
+void TensorArchiveWriter::write(const std::string& name, const Tensor& tensor) {
+    if (!out_.is_open()) {
+        throw std::invalid_argument("TensorArchiveWriter: the archive " + path_ + " is closed.");
+    }
+    if (lookup_.count(name) != 0) {
+        throw std::invalid_argument("TensorArchiveWriter: duplicate tensor name '" + name + "'.");
+    }
+    if (!is_supported(tensor.data_type())) {
+        throw std::invalid_argument("TensorArchiveWriter: unsupported data type of '" + name + "'.");
+    }
+    if (tensor.device_type() != DeviceType::CpuDevice) {
+        write(name, tensor.to_device<DEVICE_CPU>());
+        return;
+    }
+    static const char zeros[kArchiveAlignment] = {};
+    const uint64_t padding = (kArchiveAlignment - position_ % kArchiveAlignment) % kArchiveAlignment;
+    out_.write(zeros, padding);
+    position_ += padding;
+
+    TensorArchiveEntry entry;
+    entry.name = name;
+    entry.data_type = tensor.data_type();
+    entry.shape = tensor.shape();
+    entry.offset = position_;
+    entry.bytes = tensor.NumElements() * Tensor::SizeOfType(tensor.data_type());
+    entry.checksum = crc32(tensor.data(), entry.bytes);
+    out_.write(static_cast<const char*>(tensor.data()), entry.bytes);
+    if (!out_) {
+        throw std::runtime_error("TensorArchiveWriter: failed to write '" + name + "' to " + path_ + ".");
+    }
+    position_ += entry.bytes;
+    lookup_[name] = entries_.size();
+    entries_.push_back(entry);
+}
+
+void TensorArchiveWriter::close() {
+    if (!out_.is_open()) {
+        return;
+    }
+    const uint64_t index_offset = position_;
+    for (const TensorArchiveEntry& entry : entries_) {
+        put<uint32_t>(out_, static_cast<uint32_t>(entry.name.size()));
+        out_.write(entry.name.data(), entry.name.size());
+        put<int32_t>(out_, static_cast<int32_t>(entry.data_type));
+        put<uint32_t>(out_, entry.shape.ndim());
+        for (const int64_t& dim : entry.shape) {
+            put<int64_t>(out_, dim);
+        }
+        put<uint64_t>(out_, entry.offset);
+        put<uint64_t>(out_, entry.bytes);
+        put<uint32_t>(out_, entry.checksum);
+    }
+    out_.seekp(0);
+    write_preamble(out_, index_offset, entries_.size());
+    const bool failed = !out_;
+    out_.close();
+    if (failed || out_.fail()) {
+        throw std::runtime_error("TensorArchiveWriter: failed to write the index of " + path_ + ".");
+    }
+}
+
+TensorArchive::TensorArchive(const std::string& path) : path_(path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("TensorArchive: failed to open " + path + ".");
+    }
+    char magic[sizeof(kArchiveMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kArchiveMagic, sizeof(magic)) != 0) {
+        throw std::invalid_argument("TensorArchive: " + path + " is not a tensor archive.");
+    }
+    if (get<uint32_t>(in, path) != kArchiveVersion) {
+        throw std::invalid_argument("TensorArchive: unsupported archive version in " + path + ".");
+    }
+    get<uint32_t>(in, path);
+    const uint64_t index_offset = get<uint64_t>(in, path);
+    const uint64_t num_entries = get<uint64_t>(in, path);
+    if (index_offset < kPreambleSize) {
+        throw std::invalid_argument("TensorArchive: " + path + " was not closed, it has no index.");
+    }
+
+    in.seekg(index_offset);
+    for (uint64_t ii = 0; ii < num_entries; ii++) {
+        TensorArchiveEntry entry;
+        entry.name.resize(get<uint32_t>(in, path));
+        if (!in.read(&entry.name[0], entry.name.size())) {
+            throw std::invalid_argument("TensorArchive: " + path + " is truncated.");
+        }
+        entry.data_type = static_cast<DataType>(get<int32_t>(in, path));
+        const uint32_t ndim = get<uint32_t>(in, path);
+        if (!is_supported(entry.data_type) || ndim > TensorShape::kMaxDims) {
+            throw std::invalid_argument("TensorArchive: corrupt index entry '" + entry.name + "' in " + path + ".");
+        }
+        for (uint32_t dim = 0; dim < ndim; dim++) {
+            entry.shape.add_dim(get<int64_t>(in, path));
+        }
+        entry.offset = get<uint64_t>(in, path);
+        entry.bytes = get<uint64_t>(in, path);
+        entry.checksum = get<uint32_t>(in, path);
+        if (entry.bytes != entry.shape.NumElements() * Tensor::SizeOfType(entry.data_type) ||
+            entry.offset + entry.bytes > index_offset) {
+            throw std::invalid_argument("TensorArchive: corrupt index entry '" + entry.name + "' in " + path + ".");
+        }
+        lookup_[entry.name] = entries_.size();
+        entries_.push_back(entry);
+    }
+}
+
+const std::vector<TensorArchiveEntry>& TensorArchive::entries() const {
+    return entries_;
+}
+
+bool TensorArchive::contains(const std::string& name) const {
+    return lookup_.count(name) != 0;
+}
+
+const TensorArchiveEntry& TensorArchive::entry(const std::string& name) const {
+    const auto it = lookup_.find(name);
+    if (it == lookup_.end()) {
+        throw std::invalid_argument("TensorArchive: no tensor '" + name + "' in " + path_ + ".");
+    }
+    return entries_[it->second];
+}
+
+Tensor TensorArchive::read(const std::string& name, bool verify) const {
+    const TensorArchiveEntry& e = entry(name);
+    Tensor output(e.data_type, e.shape);
+    std::ifstream in(path_, std::ios::binary);
+    in.seekg(e.offset);
+    if (!in.read(static_cast<char*>(output.data()), e.bytes)) {
+        throw std::runtime_error("TensorArchive: failed to read '" + name + "' from " + path_ + ".");
+    }
+    if (verify && crc32(output.data(), e.bytes) != e.checksum) {
+        throw std::runtime_error("TensorArchive: checksum mismatch of '" + name + "' in " + path_ + ".");
+    }
+    return output;
+}
+
+Tensor TensorArchive::map(const std::string& name) const {
+    const TensorArchiveEntry& e = entry(name);
+    return Tensor::map(path_, e.offset, e.data_type, e.shape);
+}
+
+} // namespace container
@@ -0,0 +1,154 @@
+#ifndef CONTAINER_TENSOR_ARCHIVE_H
+#define CONTAINER_TENSOR_ARCHIVE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+
+#include "tensor.h"
+
+namespace container {
+
+/**
+ * @brief Compute the CRC-32 (IEEE 802.3) checksum of a buffer.
+ *
+ * @param data The buffer.
+ * @param size The size of the buffer in bytes.
+ * @param crc The checksum of the preceding data, to checksum a stream in pieces.
+ *
+ * @return The checksum of the preceding data and the buffer.
+ */
+uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+
+/**
+ * @brief The index entry of a tensor in an archive.
+ */
+struct TensorArchiveEntry {
+    std::string name;        ///< The unique name of the tensor.
+    DataType data_type = DataType::DT_INVALID; ///< The data type of the tensor.
+    TensorShape shape;       ///< The row-major shape of the tensor.
+    uint64_t offset = 0;     ///< The byte offset of the data in the file, a multiple of 64.
+    uint64_t bytes = 0;      ///< The size of the data in bytes.
+    uint32_t checksum = 0;   ///< The CRC-32 of the data.
+};
+
+/**
+ * @brief Write named tensors into an indexed archive file.
+ *
+ * The archive layout (little-endian) is:
+ *  - a 32-byte preamble: the magic "CTARCHIV", the format version, the offset and the number
+ *    of entries of the index;
+ *  - the raw row-major data of every tensor, starting at 64-byte aligned offsets;
+ *  - the index, with the name, data type, shape, offset, size and CRC-32 of every tensor.
+ *
+ * Tensors are streamed to the file as they are written, only the index is kept in memory and
+ * is written by close(). A single tensor can then be read or mapped (TensorArchive) without
+ * scanning the file.
+ */
+class TensorArchiveWriter {
+  public:
+    /**
+     * @brief Create the archive, overwriting an existing file.
+     *
+     * @throw std::runtime_error if the file can not be created.
+     */
+    explicit TensorArchiveWriter(const std::string& path);
+
+    /**
+     * @brief Close the archive if close() was not called, errors are ignored.
+     */
+    ~TensorArchiveWriter();
+
+    TensorArchiveWriter(const TensorArchiveWriter&) = delete;
+    TensorArchiveWriter& operator=(const TensorArchiveWriter&) = delete;
+
+    /**
+     * @brief Append a tensor, GPU tensors are copied to the host first.
+     *
+     * @param name The unique name of the tensor, e.g. "psi/k0".
+     * @param tensor The tensor to write.
+     *
+     * @throw std::invalid_argument if the name is already used or the archive is closed.
+     * @throw std::runtime_error if the data can not be written.
+     */
+    void write(const std::string& name, const Tensor& tensor);
+
+    /**
+     * @brief Write the index and close the file.
+     *
+     * @throw std::runtime_error if the index can not be written.
+     */
+    void close();
+
+  private:
+    std::string path_;
+    std::ofstream out_;
+    uint64_t position_ = 0;
+    std::vector<TensorArchiveEntry> entries_;
+    std::map<std::string, size_t> lookup_;
+};
+
+/**
+ * @brief Random access to the tensors of an archive written by TensorArchiveWriter.
+ *
+ * Only the preamble and the index are read on construction.
+ */
+class TensorArchive {
+  public:
+    /**
+     * @brief Open an archive and read its index.
+     *
+     * @throw std::runtime_error if the file can not be read.
+     * @throw std::invalid_argument if the file is not a valid archive.
+     */
+    explicit TensorArchive(const std::string& path);
+
+    /**
+     * @brief The index entries, in the order the tensors were written.
+     */
+    const std::vector<TensorArchiveEntry>& entries() const;
+
+    /**
+     * @brief Whether the archive holds a tensor of the given name.
+     */
+    bool contains(const std::string& name) const;
+
+    /**
+     * @brief The index entry of a tensor.
+     *
+     * @throw std::invalid_argument if there is no tensor of the given name.
+     */
+    const TensorArchiveEntry& entry(const std::string& name) const;
+
+    /**
+     * @brief Read a tensor into a new CPU tensor.
+     *
+     * @param name The name of the tensor.
+     * @param verify Check the CRC-32 of the data.
+     *
+     * @throw std::invalid_argument if there is no tensor of the given name.
+     * @throw std::runtime_error if the data can not be read or the checksum does not match.
+     */
+    Tensor read(const std::string& name, bool verify = true) const;
+
+    /**
+     * @brief Map a tensor into memory without copying, see Tensor::map.
+     *
+     * The checksum is not verified, that would read all the data.
+     *
+     * @throw std::invalid_argument if there is no tensor of the given name.
+     * @throw std::runtime_error if the file can not be mapped.
+     */
+    Tensor map(const std::string& name) const;
+
+  private:
+    std::string path_;
+    std::vector<TensorArchiveEntry> entries_;
+    std::map<std::string, size_t> lookup_;
+};
+
+} // namespace container
+
+#endif // CONTAINER_TENSOR_ARCHIVE_H
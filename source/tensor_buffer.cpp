@@ -5,6 +5,10 @@ namespace container {
 // Construct a new TensorBuffer object.
 TensorBuffer::TensorBuffer(Allocator* alloc, void* data_ptr) : data_(data_ptr), alloc_(alloc), owns_memory(true) {}
 
+// Construct a new TensorBuffer object that owns its allocator.
+TensorBuffer::TensorBuffer(std::unique_ptr<Allocator> alloc, void* data_ptr)
+        : data_(data_ptr), alloc_(alloc.get()), owns_memory(true), owned_alloc_(std::move(alloc)) {}
+
 // Construct a new TensorBuffer object.
 // Note, this is a reference TensorBuffer, does not owns memory itself.
 TensorBuffer::TensorBuffer(void* data_ptr) : data_(data_ptr), alloc_(), owns_memory(false) {}
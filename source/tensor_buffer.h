@@ -2,6 +2,7 @@
 #define CONTAINER_TENSOR_BUFFER_H_
 
 #include <cstddef>
+#include <memory>
 
 #include "allocator.h"
 #include "tensor_types.h"
@@ -21,6 +22,16 @@ namespace container {
       */
      explicit TensorBuffer(Allocator* alloc, void* data_ptr);
 
+     /**
+      * @brief Construct a new TensorBuffer object that also owns its allocator.
+      *
+      * The allocator is deleted after it has freed the data.
+      *
+      * @param alloc The allocator to use for memory allocation.
+      * @param data_ptr Pointer to the underlying data buffer.
+      */
+     explicit TensorBuffer(std::unique_ptr<Allocator> alloc, void* data_ptr);
+
     /**
       * @brief Construct a new TensorBuffer object.
       *
@@ -96,6 +107,7 @@ namespace container {
      void* const data_;  ///< Pointer to the underlying data buffer.
      Allocator* const alloc_; ///< Pointer to the allocator used for memory allocation.
      bool owns_memory; ///< Bool to indicate whether this tensor owns it's memory.
+     std::unique_ptr<Allocator> owned_alloc_; ///< The allocator, if this buffer owns it.
 };
 
 }  // namespace container
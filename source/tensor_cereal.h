@@ -0,0 +1,225 @@
+#ifndef CONTAINER_TENSOR_CEREAL_H
+#define CONTAINER_TENSOR_CEREAL_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cereal/cereal.hpp>
+#include <cereal/specialize.hpp>
+#include <cereal/types/complex.hpp>
+
+#include "tensor.h"
+
+/**
+ * @file tensor_cereal.h
+ * @brief cereal serialization of DataType, TensorShape and Tensor.
+ *
+ * A tensor is written as its data type, its shape and its data. With binary archives
+ * (cereal::BinaryOutputArchive, cereal::PortableBinaryOutputArchive) the data are a single raw
+ * block, so saving and loading run at memcpy speed; text archives (JSON, XML) fall back to one
+ * value per element. The portable binary archive swaps the byte order per real element, complex
+ * data are written as pairs of reals for that.
+ *
+ * Tensors are loaded either into an existing tensor of the same data type and number of elements,
+ * which is reshaped to the saved shape, or constructed directly through smart pointers:
+ *
+ *     std::unique_ptr<container::Tensor> psi;
+ *     archive(psi);
+ *
+ * GPU tensors are staged through host memory.
+ */
+
+namespace container {
+
+namespace internal {
+
+// Write n elements of data, as a single block if the archive supports binary data.
+template <class Archive, typename T>
+typename std::enable_if<cereal::traits::is_output_serializable<cereal::BinaryData<T*>, Archive>::value>::type
+save_elements(Archive& ar, const T* data, const int64_t& n) {
+    ar(cereal::binary_data(const_cast<T*>(data), static_cast<size_t>(n) * sizeof(T)));
+}
+
+template <class Archive, typename T>
+typename std::enable_if<!cereal::traits::is_output_serializable<cereal::BinaryData<T*>, Archive>::value>::type
+save_elements(Archive& ar, const T* data, const int64_t& n) {
+    for (int64_t ii = 0; ii < n; ii++) {
+        ar(data[ii]);
+    }
+}
+
+// The pointer is passed as a prvalue, so that the element size of BinaryData<T*> is sizeof(T).
+template <class Archive, typename T>
+typename std::enable_if<cereal::traits::is_input_serializable<cereal::BinaryData<T*>, Archive>::value>::type
+load_elements(Archive& ar, T* data, const int64_t& n) {
+    ar(cereal::binary_data(static_cast<T*>(data), static_cast<size_t>(n) * sizeof(T)));
+}
+
+template <class Archive, typename T>
+typename std::enable_if<!cereal::traits::is_input_serializable<cereal::BinaryData<T*>, Archive>::value>::type
+load_elements(Archive& ar, T* data, const int64_t& n) {
+    for (int64_t ii = 0; ii < n; ii++) {
+        ar(data[ii]);
+    }
+}
+
+// Complex data are blocks of reals, so that portable archives swap the real and imaginary parts separately.
+template <class Archive, typename T>
+void save_data(Archive& ar, const T* data, const int64_t& n) {
+    save_elements(ar, data, n);
+}
+
+template <class Archive, typename T>
+void save_data(Archive& ar, const std::complex<T>* data, const int64_t& n) {
+    save_elements(ar, reinterpret_cast<const T*>(data), 2 * n);
+}
+
+template <class Archive, typename T>
+void load_data(Archive& ar, T* data, const int64_t& n) {
+    load_elements(ar, data, n);
+}
+
+template <class Archive, typename T>
+void load_data(Archive& ar, std::complex<T>* data, const int64_t& n) {
+    load_elements(ar, reinterpret_cast<T*>(data), 2 * n);
+}
+
+// Write the data of a CPU tensor.
+template <class Archive>
+void save_tensor_data(Archive& ar, const Tensor& tensor) {
+    const int64_t n = tensor.NumElements();
+    switch (tensor.data_type()) {
+        case DataType::DT_FLOAT: save_data(ar, tensor.data<float>(), n); break;
+        case DataType::DT_DOUBLE: save_data(ar, tensor.data<double>(), n); break;
+        case DataType::DT_INT: save_data(ar, tensor.data<int>(), n); break;
+        case DataType::DT_INT64: save_data(ar, tensor.data<int64_t>(), n); break;
+        case DataType::DT_COMPLEX: save_data(ar, tensor.data<std::complex<float>>(), n); break;
+        case DataType::DT_COMPLEX_DOUBLE: save_data(ar, tensor.data<std::complex<double>>(), n); break;
+        default: throw std::invalid_argument("Tensor save: unsupported data type.");
+    }
+}
+
+// Read the data of a tensor saved by save(Archive&, const Tensor&) into a CPU tensor.
+template <class Archive>
+void load_tensor_data(Archive& ar, Tensor& tensor) {
+    const int64_t n = tensor.NumElements();
+    switch (tensor.data_type()) {
+        case DataType::DT_FLOAT: load_data(ar, tensor.data<float>(), n); break;
+        case DataType::DT_DOUBLE: load_data(ar, tensor.data<double>(), n); break;
+        case DataType::DT_INT: load_data(ar, tensor.data<int>(), n); break;
+        case DataType::DT_INT64: load_data(ar, tensor.data<int64_t>(), n); break;
+        case DataType::DT_COMPLEX: load_data(ar, tensor.data<std::complex<float>>(), n); break;
+        case DataType::DT_COMPLEX_DOUBLE: load_data(ar, tensor.data<std::complex<double>>(), n); break;
+        default: throw std::invalid_argument("Tensor load: unsupported data type.");
+    }
+}
+
+} // namespace internal
+
+/**
+ * @brief Save a data type as its enum value.
+ */
+template <class Archive>
+int32_t save_minimal(const Archive&, const DataType& data_type) {
+    return static_cast<int32_t>(data_type);
+}
+
+/**
+ * @brief Load a data type saved by save_minimal.
+ */
+template <class Archive>
+void load_minimal(const Archive&, DataType& data_type, const int32_t& value) {
+    data_type = static_cast<DataType>(value);
+}
+
+/**
+ * @brief Save a shape as its number of dimensions and the dimension sizes.
+ */
+template <class Archive>
+void save(Archive& ar, const TensorShape& shape) {
+    ar(cereal::make_size_tag(static_cast<cereal::size_type>(shape.ndim())));
+    for (const int64_t& dim : shape) {
+        ar(dim);
+    }
+}
+
+/**
+ * @brief Load a shape saved by save(Archive&, const TensorShape&).
+ */
+template <class Archive>
+void load(Archive& ar, TensorShape& shape) {
+    cereal::size_type ndim = 0;
+    ar(cereal::make_size_tag(ndim));
+    TensorShape result;
+    for (cereal::size_type ii = 0; ii < ndim; ii++) {
+        int64_t dim = 0;
+        ar(dim);
+        result.add_dim(dim);
+    }
+    shape = result;
+}
+
+/**
+ * @brief Save a tensor as its data type, shape and data.
+ */
+template <class Archive>
+void save(Archive& ar, const Tensor& tensor) {
+    if (tensor.device_type() != DeviceType::CpuDevice) {
+        save(ar, tensor.to_device<DEVICE_CPU>());
+        return;
+    }
+    ar(cereal::make_nvp("data_type", tensor.data_type()), cereal::make_nvp("shape", tensor.shape()));
+    internal::save_tensor_data(ar, tensor);
+}
+
+/**
+ * @brief Load a tensor into an existing tensor, which is reshaped to the saved shape.
+ *
+ * @throw std::invalid_argument if the data type or the number of elements differ.
+ */
+template <class Archive>
+void load(Archive& ar, Tensor& tensor) {
+    DataType data_type = DataType::DT_INVALID;
+    TensorShape shape;
+    ar(cereal::make_nvp("data_type", data_type), cereal::make_nvp("shape", shape));
+    if (data_type != tensor.data_type() || shape.NumElements() != tensor.NumElements()) {
+        throw std::invalid_argument("Tensor load: the saved data type or size does not match the tensor.");
+    }
+    tensor.reshape(shape);
+    if (tensor.device_type() == DeviceType::CpuDevice) {
+        internal::load_tensor_data(ar, tensor);
+        return;
+    }
+    Tensor staging(data_type, shape);
+    internal::load_tensor_data(ar, staging);
+    TEMPLATE_ALL_2(data_type, tensor.device_type(),
+            op::synchronize_memory_op<T_, DEVICE_, DEVICE_CPU>()(
+                    tensor.data<T_>(), staging.data<T_>(), staging.NumElements()))
+}
+
+} // namespace container
+
+// cereal has a generic serialization of enums, use the one above.
+CEREAL_SPECIALIZE_FOR_ALL_ARCHIVES(container::DataType, cereal::specialization::non_member_load_save_minimal);
+
+namespace cereal {
+
+/**
+ * @brief Construct a loaded tensor in place, Tensor has no default constructor.
+ */
+template <>
+struct LoadAndConstruct<container::Tensor> {
+    template <class Archive>
+    static void load_and_construct(Archive& ar, cereal::construct<container::Tensor>& construct) {
+        container::DataType data_type = container::DataType::DT_INVALID;
+        container::TensorShape shape;
+        ar(cereal::make_nvp("data_type", data_type), cereal::make_nvp("shape", shape));
+        construct(data_type, shape);
+        container::internal::load_tensor_data(ar, *construct.ptr());
+    }
+};
+
+} // namespace cereal
+
+#endif // CONTAINER_TENSOR_CEREAL_H
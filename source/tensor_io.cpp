@@ -0,0 +1,250 @@
+#include <new>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "tensor.h"
+
+namespace container {
+
+namespace {
+
+// The .npy magic string, followed by the format version.
+const char kMagic[] = "\x93NUMPY";
+const size_t kMagicSize = 6;
+// The data of a .npy file start at a multiple of this, as numpy writes them.
+const size_t kAlignment = 64;
+
+bool little_endian() {
+    const uint16_t one = 1;
+    return *reinterpret_cast<const uint8_t*>(&one) == 1;
+}
+
+// The numpy type string of a data type, e.g. "<f8".
+std::string npy_descr(const DataType& data_type) {
+    const std::string order = little_endian() ? "<" : ">";
+    switch (data_type) {
+        case DataType::DT_FLOAT: return order + "f4";
+        case DataType::DT_DOUBLE: return order + "f8";
+        case DataType::DT_INT: return order + "i4";
+        case DataType::DT_INT64: return order + "i8";
+        case DataType::DT_COMPLEX: return order + "c8";
+        case DataType::DT_COMPLEX_DOUBLE: return order + "c16";
+        default:
+            throw std::invalid_argument("Tensor::save: unsupported data type.");
+    }
+}
+
+DataType parse_descr(const std::string& descr) {
+    const DataType types[] = {
+            DataType::DT_FLOAT, DataType::DT_DOUBLE, DataType::DT_INT,
+            DataType::DT_INT64, DataType::DT_COMPLEX, DataType::DT_COMPLEX_DOUBLE};
+    for (const DataType& data_type : types) {
+        if (descr == npy_descr(data_type)) {
+            return data_type;
+        }
+    }
+    throw std::invalid_argument("Tensor::load: unsupported or byte-swapped data type '" + descr + "'.");
+}
+
+// The value of a key in the header dictionary, up to the next top-level comma.
+std::string header_value(const std::string& header, const std::string& key) {
+    const size_t pos = header.find("'" + key + "'");
+    if (pos == std::string::npos) {
+        throw std::invalid_argument("Tensor::load: the .npy header has no '" + key + "' entry.");
+    }
+    size_t begin = header.find(':', pos);
+    if (begin == std::string::npos) {
+        throw std::invalid_argument("Tensor::load: malformed .npy header.");
+    }
+    begin = header.find_first_not_of(' ', begin + 1);
+    if (begin == std::string::npos) {
+        throw std::invalid_argument("Tensor::load: malformed .npy header.");
+    }
+    const size_t end = header[begin] == '(' ? header.find(')', begin) + 1 : header.find_first_of(",}", begin);
+    if (end == std::string::npos || end == 0) {
+        throw std::invalid_argument("Tensor::load: malformed .npy header.");
+    }
+    return header.substr(begin, end - begin);
+}
+
+struct NpyHeader {
+    DataType data_type = DataType::DT_INVALID;
+    TensorShape shape;
+    size_t data_offset = 0;  ///< Offset of the raw data from the start of the file.
+};
+
+// Parse the preamble and the header dictionary, e.g.
+// {'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }
+NpyHeader parse_header(std::istream& in, const std::string& path) {
+    char preamble[kMagicSize + 2];
+    if (!in.read(preamble, sizeof(preamble)) || std::memcmp(preamble, kMagic, kMagicSize) != 0) {
+        throw std::invalid_argument("Tensor::load: " + path + " is not a .npy file.");
+    }
+    const int major = static_cast<unsigned char>(preamble[kMagicSize]);
+    uint32_t header_size = 0;
+    unsigned char length[4] = {0, 0, 0, 0};
+    const int length_bytes = major == 1 ? 2 : 4;
+    if (major < 1 || major > 3 || !in.read(reinterpret_cast<char*>(length), length_bytes)) {
+        throw std::invalid_argument("Tensor::load: unsupported .npy version in " + path + ".");
+    }
+    for (int ii = length_bytes - 1; ii >= 0; ii--) {
+        header_size = (header_size << 8) | length[ii];
+    }
+    std::string header(header_size, ' ');
+    if (!in.read(&header[0], header_size)) {
+        throw std::invalid_argument("Tensor::load: truncated .npy header in " + path + ".");
+    }
+
+    NpyHeader result;
+    result.data_offset = sizeof(preamble) + length_bytes + header_size;
+    const std::string descr = header_value(header, "descr");
+    result.data_type = parse_descr(descr.substr(1, descr.size() - 2));
+    if (header_value(header, "fortran_order") != "False") {
+        throw std::invalid_argument("Tensor::load: Fortran-ordered .npy files are not supported.");
+    }
+    std::string shape = header_value(header, "shape");
+    for (char& c : shape) {
+        if (c == '(' || c == ')' || c == ',') c = ' ';
+    }
+    std::istringstream dims(shape);
+    int64_t dim = 0;
+    while (dims >> dim) {
+        if (dim < 0) {
+            throw std::invalid_argument("Tensor::load: negative dimension in " + path + ".");
+        }
+        result.shape.add_dim(dim);
+    }
+    return result;
+}
+
+// Releases the mapping of a loaded file. Copies of the tensor allocate from the heap.
+class MappedFileAllocator : public Allocator {
+  public:
+    MappedFileAllocator(void* base, size_t length, void* data)
+        : base_(base), length_(length), data_(data) {}
+
+    void* allocate(size_t size) override { return ::operator new(size); }
+
+    void* allocate(size_t size, size_t alignment) override {
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+    }
+
+    void free(void* ptr) override {
+        if (ptr == data_) {
+            munmap(base_, length_);
+        }
+        else {
+            ::operator delete(ptr);
+        }
+    }
+
+    size_t AllocatedSize(void* ptr) override {
+        return ptr == data_ ? length_ - (static_cast<char*>(data_) - static_cast<char*>(base_)) : 0;
+    }
+
+    DeviceType GetDeviceType() override { return DeviceType::CpuDevice; }
+
+  private:
+    void* base_;
+    size_t length_;
+    void* data_;
+};
+
+} // namespace
+
+// Save the tensor to a file in the NumPy .npy format.
+void Tensor::save(const std::string& path) const {
+    if (device_ != DeviceType::CpuDevice) {
+        to_device<DEVICE_CPU>().save(path);
+        return;
+    }
+    std::ostringstream dict;
+    dict << "{'descr': '" << npy_descr(data_type_) << "', 'fortran_order': False, 'shape': (";
+    for (unsigned int ii = 0; ii < shape_.ndim(); ii++) {
+        dict << (ii == 0 ? "" : ", ") << shape_.dim_size(ii);
+    }
+    // A one-element tuple needs a trailing comma.
+    dict << (shape_.ndim() == 1 ? ",), }" : "), }");
+    // Pad with spaces and a newline, so that the data are aligned.
+    std::string header = dict.str();
+    const size_t preamble = kMagicSize + 4;
+    header.append((kAlignment - (preamble + header.size() + 1) % kAlignment) % kAlignment, ' ');
+    header += '\n';
+    if (header.size() > 65535) {
+        throw std::invalid_argument("Tensor::save: the shape is too large for a .npy header.");
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const char version[2] = {1, 0};
+    const unsigned char length[2] = {
+            static_cast<unsigned char>(header.size() & 0xff), static_cast<unsigned char>(header.size() >> 8)};
+    out.write(kMagic, kMagicSize);
+    out.write(version, 2);
+    out.write(reinterpret_cast<const char*>(length), 2);
+    out.write(header.data(), header.size());
+    out.write(static_cast<const char*>(data()), NumElements() * SizeOfType(data_type_));
+    if (!out) {
+        throw std::runtime_error("Tensor::save: failed to write " + path + ".");
+    }
+}
+
+// Map a region of a file into a CPU tensor without copying.
+Tensor Tensor::map(const std::string& path, const size_t& offset, DataType data_type, const TensorShape& shape) {
+    const size_t bytes = shape.NumElements() * SizeOfType(data_type);
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("Tensor::map: failed to open " + path + ".");
+    }
+    if (static_cast<size_t>(status.st_size) < offset + bytes) {
+        close(fd);
+        throw std::runtime_error("Tensor::map: " + path + " is truncated.");
+    }
+    // The mapping starts at a page boundary, and is never empty.
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset / page * page;
+    const size_t length = std::max<size_t>(1, offset + bytes - start);
+    void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(start));
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Tensor::map: failed to map " + path + ".");
+    }
+    void* data = static_cast<char*>(base) + (offset - start);
+    return Tensor(data_type, shape,
+                  std::unique_ptr<Allocator>(new MappedFileAllocator(base, length, data)), data);
+}
+
+// Load a tensor from a .npy file.
+Tensor Tensor::load(const std::string& path, bool map) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Tensor::load: failed to open " + path + ".");
+    }
+    const NpyHeader header = parse_header(in, path);
+    const size_t bytes = header.shape.NumElements() * SizeOfType(header.data_type);
+
+    if (map) {
+        return Tensor::map(path, header.data_offset, header.data_type, header.shape);
+    }
+
+    Tensor output(header.data_type, header.shape);
+    if (!in.read(static_cast<char*>(output.data()), bytes)) {
+        throw std::runtime_error("Tensor::load: " + path + " is truncated.");
+    }
+    return output;
+}
+
+} // namespace container
@@ -1,83 +1,109 @@
 #include "tensor_shape.h"
 
+#include <stdexcept>
+
 namespace container {
-/**
- * @brief Namespace containing constants for default constructor
- */
-namespace {
-    /**
-     * @brief Default size of a dimension
-     */
-    constexpr int kDefaultDimSize = 0;
-} // namespace
+
+constexpr int TensorShape::kMaxDims;
 
 // Default constructor for TensorShape class
-// Initializes TensorShape with default dimensions
-TensorShape::TensorShape() : dims_(kDefaultDimSize) {}
+// Initializes TensorShape with no dimensions
+TensorShape::TensorShape() = default;
+
+// Constructor for TensorShape class
+TensorShape::TensorShape(std::initializer_list<int64_t> dims) {
+    assign(dims.begin(), dims.end());
+}
 
 // Constructor for TensorShape class
-TensorShape::TensorShape(std::initializer_list<int> dims) : dims_(dims) {}
+TensorShape::TensorShape(const std::vector<int>& dims) {
+    assign(dims.begin(), dims.end());
+}
 
 // Constructor for TensorShape class
-TensorShape::TensorShape(const std::vector<int>& dims) : dims_(dims) {}
+TensorShape::TensorShape(const std::vector<int64_t>& dims) {
+    assign(dims.begin(), dims.end());
+}
 
 // Copy constructor for TensorShape class
 TensorShape::TensorShape(const TensorShape& other) = default;
 
-// Get size of a specific dimension in the tensor
-int TensorShape::dim_size(int dim) const {
-    return dims_[dim];
-}
+// Copy assignment for TensorShape class
+TensorShape& TensorShape::operator=(const TensorShape& other) = default;
 
-// Get all dimension sizes in the tensor
-const std::vector<int>& TensorShape::dims() const {
-    return dims_;
+// Set the dimensions from a sequence and update the element count
+template <typename Iterator>
+void TensorShape::assign(Iterator first, Iterator last) {
+    if (last - first > kMaxDims) {
+        throw std::invalid_argument("TensorShape: at most 8 dimensions are supported.");
+    }
+    ndim_ = 0;
+    for (; first != last; ++first) {
+        dims_[ndim_++] = static_cast<int64_t>(*first);
+    }
+    update_num_elements();
 }
 
-// Get ndim of the tensor, i.e., number of dimensions
-unsigned int TensorShape::ndim() const {
-    return dims_.size();
+// Recompute the cached element count
+void TensorShape::update_num_elements() {
+    num_elements_ = 1;
+    for (int i = 0; i < ndim_; ++i) {
+        num_elements_ *= dims_[i];
+    }
 }
 
-// Returns the total number of elements in the shape.
-int64_t TensorShape::NumElements() const {
-    int64_t num_elements = 1;
-    for (int i = 0; i < this->ndim(); ++i) {
-        num_elements *= dims_[i];
-    }
-    return num_elements;
+// Get all dimension sizes in the tensor
+std::vector<int64_t> TensorShape::dims() const {
+    return std::vector<int64_t>(begin(), end());
 }
 
 // Modify size of a specific dimension in the tensor
-void TensorShape::set_dim_size(int dim, int size) {
+void TensorShape::set_dim_size(int dim, int64_t size) {
     dims_[dim] = size;
+    update_num_elements();
 }
 
 // Add a new dimension to the tensor
-void TensorShape::add_dim(int size) {
-    dims_.push_back(size);
+void TensorShape::add_dim(int64_t size) {
+    if (ndim_ == kMaxDims) {
+        throw std::invalid_argument("TensorShape: at most 8 dimensions are supported.");
+    }
+    dims_[ndim_++] = size;
+    num_elements_ *= size;
 }
 
 // Remove a dimension from the tensor
 void TensorShape::remove_dim(int dim) {
-    dims_.erase(dims_.begin() + dim);
+    for (int i = dim; i < ndim_ - 1; ++i) {
+        dims_[i] = dims_[i + 1];
+    }
+    dims_[--ndim_] = 0;
+    update_num_elements();
 }
 
 // Overload the == operator to compare two TensorShape objects
 bool TensorShape::operator==(const TensorShape& other) const {
-    return dims_ == other.dims_;
+    if (ndim_ != other.ndim_) {
+        return false;
+    }
+    for (int i = 0; i < ndim_; ++i) {
+        if (dims_[i] != other.dims_[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // Overload the != operator to compare two TensorShape objects
 bool TensorShape::operator!=(const TensorShape& other) const {
-    return dims_ != other.dims_;
+    return !(*this == other);
 }
 
 // Overload the << operator to print the tensor shape
 std::ostream& operator<<(std::ostream& os, const TensorShape& shape) {
     os << "[";
     for (int i = 0; i < shape.ndim(); ++i) {
-        os << shape.dims()[i];
+        os << shape.dim_size(i);
         if (i < shape.ndim() - 1) {
             os << ",";
         }
@@ -86,4 +112,4 @@ std::ostream& operator<<(std::ostream& os, const TensorShape& shape) {
     return os;
 }
 
-} // namespace container
\ No newline at end of file
+} // namespace container
@@ -2,6 +2,7 @@
 #define CONTAINER_TENSOR_SHAPE_H_
 
 #include <vector>
+#include <cstdint>
 #include <iostream>
 #include <initializer_list>
 
@@ -9,63 +10,93 @@ namespace container {
 
 /**
  * @brief A class for representing the shape of a tensor.
+ *
+ * The dimension sizes are stored inline, up to kMaxDims of them, and the number of elements is
+ * cached, so creating and copying a shape never allocates and NumElements() is a load.
  */
 class TensorShape {
 public:
     /**
-     * @brief Default constructor.
+     * @brief The maximum number of dimensions.
+     */
+    static constexpr int kMaxDims = 8;
+
+    /**
+     * @brief Default constructor, a scalar shape with no dimensions.
      */
     TensorShape();
 
     /**
      * @brief Constructor with an initializer list of integers.
      * @param dims An initializer list of integers representing the dimensions of the tensor.
+     * @throw std::invalid_argument if there are more than kMaxDims dimensions.
      */
-    TensorShape(std::initializer_list<int> dims);
+    TensorShape(std::initializer_list<int64_t> dims);
 
     /**
      * @brief Constructor with a vector of integers.
      * @param dims A vector of integers representing the dimensions of the tensor.
+     * @throw std::invalid_argument if there are more than kMaxDims dimensions.
      */
     explicit TensorShape(const std::vector<int>& dims);
 
+    /**
+     * @brief Constructor with a vector of 64-bit integers.
+     * @param dims A vector of integers representing the dimensions of the tensor.
+     * @throw std::invalid_argument if there are more than kMaxDims dimensions.
+     */
+    explicit TensorShape(const std::vector<int64_t>& dims);
+
     /**
      * @brief Copy constructor.
      * @param other The TensorShape object to be copied.
      */
     TensorShape(const TensorShape& other);
 
+    /**
+     * @brief Copy assignment.
+     * @param other The TensorShape object to be copied.
+     */
+    TensorShape& operator=(const TensorShape& other);
+
     /**
      * @brief Get the size of a dimension in the tensor.
      * @param dim The index of the dimension.
      * @return The size of the specified dimension.
      */
-    int dim_size(int dim) const;
+    int64_t dim_size(int dim) const { return dims_[dim]; }
 
     /**
      * @brief Get all dimension sizes in the tensor.
-     * @return A const reference to the vector of dimension sizes.
+     * @return A copy of the dimension sizes, iterate over the shape to avoid the allocation.
+     */
+    std::vector<int64_t> dims() const;
+
+    /**
+     * @brief Iterators over the dimension sizes.
      */
-    const std::vector<int>& dims() const;
+    const int64_t* begin() const { return dims_; }
+    const int64_t* end() const { return dims_ + ndim_; }
 
     /**
      * @brief Get the ndim of the tensor.
      * @return The number of dimensions in the tensor.
      */
-    unsigned int ndim() const;
+    unsigned int ndim() const { return ndim_; }
 
     /**
      * @brief Modify the size of a dimension in the tensor.
      * @param dim The index of the dimension to be modified.
      * @param size The new size of the dimension.
      */
-    void set_dim_size(int dim, int size);
+    void set_dim_size(int dim, int64_t size);
 
     /**
      * @brief Add a new dimension to the tensor.
      * @param size The size of the new dimension.
+     * @throw std::invalid_argument if the shape already has kMaxDims dimensions.
      */
-    void add_dim(int size);
+    void add_dim(int64_t size);
 
     /**
      * @brief Remove a dimension from the tensor.
@@ -78,7 +109,7 @@ public:
     *
     * @return int64_t The number of elements.
     */
-    int64_t NumElements() const;
+    int64_t NumElements() const { return num_elements_; }
 
     /**
      * @brief Overload the == operator to compare two TensorShape objects.
@@ -95,7 +126,16 @@ public:
     bool operator!=(const TensorShape& other) const;
 
 private:
-    std::vector<int> dims_;  // Save dimension sizes of the tensor
+    // Set the dimensions from a sequence and update the element count.
+    template <typename Iterator>
+    void assign(Iterator first, Iterator last);
+
+    // Recompute the cached element count.
+    void update_num_elements();
+
+    int64_t dims_[kMaxDims] = {};  // Save dimension sizes of the tensor
+    int ndim_ = 0;                 // Number of dimensions in use
+    int64_t num_elements_ = 1;     // Product of the dimension sizes
 };
 
 /**
@@ -2,6 +2,17 @@
 
 namespace container {
 
+// Out-of-class definitions of the constexpr members, required in C++11 when they are odr-used,
+// e.g. bound to a const reference.
+constexpr DataType DataTypeToEnum<int>::value;
+constexpr DataType DataTypeToEnum<float>::value;
+constexpr DataType DataTypeToEnum<double>::value;
+constexpr DataType DataTypeToEnum<int64_t>::value;
+constexpr DataType DataTypeToEnum<std::complex<float>>::value;
+constexpr DataType DataTypeToEnum<std::complex<double>>::value;
+constexpr DeviceType DeviceTypeToEnum<DEVICE_CPU>::value;
+constexpr DeviceType DeviceTypeToEnum<DEVICE_GPU>::value;
+
 // Overloaded operator<< for the Tensor class.
 // Prints the data type of the enum type DataType.
 std::ostream& operator<<(std::ostream& os, const DataType& data_type) {
@@ -111,6 +111,25 @@ struct DataTypeToEnum<std::complex<double>> {
     static constexpr DataType value = DataType::DT_COMPLEX_DOUBLE;
 };
 
+/**
+ * @brief Template struct for determining the real type of a data type.
+ *
+ * @param T The data type, real or complex.
+ *
+ * @return The underlying real type, e.g. `double` for both `double` and `std::complex<double>`.
+ *  Example usage:
+ *      GetTypeReal<std::complex<float>>::type; // Returns float
+ */
+template <typename T>
+struct GetTypeReal {
+    using type = T;
+};
+// Specialization of GetTypeReal for complex types.
+template <typename T>
+struct GetTypeReal<std::complex<T>> {
+    using type = T;
+};
+
 /**
  * @brief Overloaded operator<< for the Tensor class.
  *
@@ -178,6 +197,21 @@ std::ostream& operator<<(std::ostream& os, const DeviceType& memory_type);
       break;                                                             \
   }
 
+#define CASES_SDCZ_WITH_DEFAULT_2(TYPE_ENUM, DEVICE_ENUM, STMTS, DEFAULT)\
+  switch (int(TYPE_ENUM) * 10 + int(DEVICE_ENUM)) {                      \
+    CASE_2(float, DEVICE_CPU, SINGLE_ARG(STMTS))                         \
+    CASE_2(float, DEVICE_GPU, SINGLE_ARG(STMTS))                         \
+    CASE_2(double, DEVICE_CPU, SINGLE_ARG(STMTS))                        \
+    CASE_2(double, DEVICE_GPU, SINGLE_ARG(STMTS))                        \
+    CASE_2(std::complex<float>, DEVICE_CPU, SINGLE_ARG(STMTS))           \
+    CASE_2(std::complex<float>, DEVICE_GPU, SINGLE_ARG(STMTS))           \
+    CASE_2(std::complex<double>, DEVICE_CPU, SINGLE_ARG(STMTS))          \
+    CASE_2(std::complex<double>, DEVICE_GPU, SINGLE_ARG(STMTS))          \
+    default:                                                             \
+      DEFAULT;                                                           \
+      break;                                                             \
+  }
+
 // TODO: add a log solution to container.
 #define TEMPLATE_ALL_2(TYPE_ENUM, DEVICE_ENUM, ...)                      \
   CASES_ALL_WITH_DEFAULT_2(TYPE_ENUM, DEVICE_ENUM, (__VA_ARGS__),        \
@@ -187,5 +221,9 @@ std::ostream& operator<<(std::ostream& os, const DeviceType& memory_type);
   CASES_CZ_WITH_DEFAULT_2(TYPE_ENUM, DEVICE_ENUM, (__VA_ARGS__),         \
                            std::cerr << "Unexpected type: " << TYPE_ENUM; exit(EXIT_FAILURE));
 
+#define TEMPLATE_SDCZ_2(TYPE_ENUM, DEVICE_ENUM, ...)                     \
+  CASES_SDCZ_WITH_DEFAULT_2(TYPE_ENUM, DEVICE_ENUM, (__VA_ARGS__),       \
+                           std::cerr << "Unexpected type: " << TYPE_ENUM; exit(EXIT_FAILURE));
+
 } // namespace container
 #endif // CONTAINER_TENSOR_TYPES_H_
\ No newline at end of file
@@ -1,10 +1,13 @@
 #ifndef CONTAINER_TENSOR_UTILS_H
 #define CONTAINER_TENSOR_UTILS_H
 
-#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
 #include <complex>
+#include <algorithm>
 
 #include "tensor.h"
 #include "tensor_shape.h"
@@ -12,191 +15,267 @@
 namespace container {
 
 /**
- *
- * @brief Removes trailing zeros from a string.
- *
- * This function removes any trailing zeros from a given string.
- *
- * @param str The string to remove trailing zeros from.
- *
- * @return A string without trailing zeros.
+ * @brief The largest print precision, beyond it the digits of a double carry no information.
+ */
+constexpr int kMaxPrintPrecision = 17;
+
+/**
+ * @brief Options of the tensor output by operator<<, similar to numpy.set_printoptions.
+ */
+struct PrintOptions {
+    int64_t threshold = 1000;  ///< Tensors with more elements than this are summarized.
+    int64_t edge_items = 3;    ///< The number of leading and trailing items of each dimension in a summary.
+    int precision = 8;         ///< The maximum number of fractional digits of floating point values.
+};
+
+/**
+ * @brief The options used by operator<<, set_print_options changes them.
  */
 __inline__
-std::string removeTrailingZeros(std::string str) {
-    int i = str.length() - 1;
-    while (i >= 0 && str[i] == '0') {
-        i--;
-    }
-    if (i == -1) {
-        return "0";
-    }
-    return str.substr(0, i + 1);
+PrintOptions& _print_options() {
+    static PrintOptions options;
+    return options;
 }
 
 /**
- *
- * @brief Calculates the length of the longest integer and fractional part of an array of numbers.
- *
- * This function takes an array of numbers and determines the length of the longest integer and fractional part.
- *
- * @tparam T The type of the array.
- *
- * @param arr The array of numbers.
- * @param size The size of the array.
- * @param integer_count The length of the longest integer part.
- * @param fraction_count The length of the longest fractional part.
- *
- * @return The total length of the longest integer and fractional part.
+ * @brief Get the current print options.
  */
+__inline__
+PrintOptions get_print_options() {
+    return _print_options();
+}
 
-template<typename T>
+/**
+ * @brief Set the print options of all subsequent tensor output.
+ *
+ * @param options The new options, e.g. a larger threshold to print tensors in full.
+ *        The precision is clamped to [0, kMaxPrintPrecision].
+ */
 __inline__
-int _get_digit_places(
-        const T* arr,
-        int size,
-        int& integer_count,
-        int& fraction_count)
-{
-    integer_count = 0;
-    fraction_count = 0;
+void set_print_options(const PrintOptions& options) {
+    _print_options() = options;
+    _print_options().precision = std::max(0, std::min(options.precision, kMaxPrintPrecision));
+}
 
-    for (int i = 0; i < size; i++) {
-        int digits = 0;
-        if (arr[i] < 0) {
-            digits = log10(-arr[i]) + 1;
-            if (digits + 1 > integer_count) {
-                integer_count = digits + 1;
-            }
-        }
-        else {
-            digits = log10(arr[i]) + 1;
-            if (digits > integer_count) {
-                integer_count = digits;
-            }
-        }
+/**
+ * @brief The widths of the printed values of a tensor.
+ */
+struct _PrintFormat {
+    int integer_width = 0;   ///< The width of the sign and the integer part.
+    int fraction_count = 0;  ///< The number of significant fractional digits.
+    bool floating = false;   ///< Whether the values are floating point values.
+};
 
-        T fraction = arr[i] - std::floor(arr[i]);
-        if (fraction == 0) {
-            continue;
-        }
-        std::string str = removeTrailingZeros(std::to_string(fraction));
-        digits = str.length() - str.find('.');
-        if (digits > fraction_count) {
-            fraction_count = digits;
-        }
+/**
+ * @brief Widen a format to fit an integer value.
+ *
+ * The digits are counted without formatting the value.
+ */
+template <typename T>
+__inline__
+void _update_format(
+        const T& value,
+        const int& precision,
+        _PrintFormat& format)
+{
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    int digits = value < 0 ? 2 : 1;
+    while (magnitude >= 10) {
+        magnitude /= 10;
+        digits++;
     }
-
-    return integer_count + fraction_count;
+    format.integer_width = std::max(format.integer_width, digits);
 }
 
 /**
+ * @brief Widen a format to fit a floating point value.
  *
- * @brief Overloaded function to calculate the length of the longest integer and fractional part of an array of complex numbers.
- *
- * This function is an overloaded version of _get_digit_places for an array of complex numbers.
- *
- * @tparam T The type of the array.
- *
- * @param arr The array of numbers.
- * @param size The size of the array.
- * @param integer_count The length of the longest integer part.
- * @param fraction_count The length of the longest fractional part.
- *
- * @return The total length of the longest integer and fractional part.
+ * The value is formatted once into a stack buffer at the maximum precision, the trailing
+ * zeros of the fraction do not count.
  */
-template<typename T>
+template <typename T>
+__inline__
+void _update_float_format(
+        const T& value,
+        const int& precision,
+        _PrintFormat& format)
+{
+    char buffer[512];
+    // snprintf returns the untruncated length, only the written part is scanned.
+    const int length = std::min(std::snprintf(buffer, sizeof(buffer), "%.*f", precision, static_cast<double>(value)),
+                                static_cast<int>(sizeof(buffer)) - 1);
+    const char* dot = static_cast<const char*>(std::memchr(buffer, '.', length));
+    // inf and nan have no fraction.
+    const int integer_width = dot == nullptr ? length : static_cast<int>(dot - buffer);
+    int fraction_count = dot == nullptr ? 0 : length - integer_width - 1;
+    while (fraction_count > 0 && buffer[integer_width + fraction_count] == '0') {
+        fraction_count--;
+    }
+    format.floating = true;
+    format.integer_width = std::max(format.integer_width, integer_width);
+    format.fraction_count = std::max(format.fraction_count, fraction_count);
+}
+
+template <>
+__inline__
+void _update_format(const float& value, const int& precision, _PrintFormat& format) {
+    _update_float_format(value, precision, format);
+}
+
+template <>
 __inline__
-int _get_digit_places(
-        const std::complex<T>* arr,
-        int size,
-        int& integer_count,
-        int& fraction_count)
+void _update_format(const double& value, const int& precision, _PrintFormat& format) {
+    _update_float_format(value, precision, format);
+}
+
+template <typename T>
+__inline__
+void _update_format(
+        const std::complex<T>& value,
+        const int& precision,
+        _PrintFormat& format)
 {
-    return _get_digit_places<T>(reinterpret_cast<const T*>(arr), size * 2, integer_count, fraction_count);
+    _update_float_format(value.real(), precision, format);
+    _update_float_format(value.imag(), precision, format);
 }
 
 /**
- *
- * @brief Output wrapper for a data value with given formatting parameters.
- *
- * @tparam T The type of data to output.
- *
- * @param os The output stream to write the data to.
- * @param data The data value to output.
- * @param digit_width The minimum width for the output.
- * @param fraction_count The number of digits to display after the decimal point.
+ * @brief Output a value with the given format.
  */
 template <typename T>
 __inline__
 void _output_wrapper(
         std::ostream& os,
-        const T data,
-        const int& digit_width,
-        const int& fraction_count)
+        const T& data,
+        const _PrintFormat& format)
 {
-    os << std::setw(digit_width) \
-       << std::setprecision(fraction_count) << std::fixed << data;
+    if (!format.floating) {
+        os << std::setw(format.integer_width) << data;
+        return;
+    }
+    // At least one fractional digit, so that floating point values read as such.
+    const int fraction_count = std::max(format.fraction_count, 1);
+    char buffer[512];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", fraction_count, static_cast<double>(data));
+    os << std::setw(format.integer_width + 1 + fraction_count) << buffer;
 }
 
 /**
- *
- * @brief Output wrapper for a complex data value with given formatting parameters.
- *
- * @tparam T The type of data to output.
- *
- * @param os The output stream to write the data to.
- * @param data The data value to output.
- * @param digit_width The minimum width for the output.
- * @param fraction_count The number of digits to display after the decimal point.
+ * @brief Output a complex value as {real, imag} with the given format.
  */
 template <typename T>
 __inline__
 void _output_wrapper(
         std::ostream& os,
-        const std::complex<T> data,
-        const int& digit_width,
-        const int& fraction_count)
+        const std::complex<T>& data,
+        const _PrintFormat& format)
 {
-    // Write the real and imaginary parts of the complex value to the output stream
-    // with the specified formatting.
     os << "{";
-    os << std::setw(digit_width) \
-       << std::setprecision(fraction_count) << std::fixed
-       << data.real();
+    _output_wrapper(os, data.real(), format);
     os << ", ";
-    os << std::setw(digit_width) \
-       << std::setprecision(fraction_count) << std::fixed
-       << data.imag();
+    _output_wrapper(os, data.imag(), format);
     os << "}";
 }
 
 /**
+ * @brief The number of items of a dimension that are skipped in a summary, 0 if none.
+ */
+__inline__
+int64_t _skipped_items(
+        const int64_t& dim_size,
+        const bool& summarize,
+        const int64_t& edge_items)
+{
+    return summarize && dim_size > 2 * edge_items ? dim_size - 2 * edge_items : 0;
+}
+
+/**
+ * @brief Visit the printed elements of a row-major tensor, in order.
  *
- * @brief Output wrapper for an integer data value with given formatting parameters.
+ * @param func Called with the offset of every printed element.
+ */
+template <typename Func>
+__inline__
+void _for_each_printed(
+        const TensorShape& shape,
+        const int& dim,
+        const int64_t& offset,
+        const int64_t& stride,
+        const bool& summarize,
+        const int64_t& edge_items,
+        Func& func)
+{
+    if (dim == static_cast<int>(shape.ndim())) {
+        func(offset);
+        return;
+    }
+    const int64_t dim_size = shape.dim_size(dim);
+    const int64_t skipped = _skipped_items(dim_size, summarize, edge_items);
+    const int64_t inner = dim_size == 0 ? 0 : stride / dim_size;
+    for (int64_t ii = 0; ii < dim_size; ii++) {
+        if (skipped != 0 && ii == edge_items) {
+            ii += skipped - 1;
+            continue;
+        }
+        _for_each_printed(shape, dim + 1, offset + ii * inner, inner, summarize, edge_items, func);
+    }
+}
+
+/**
+ * @brief Output a dimension of a tensor as a nested list, recursing into the inner dimensions.
  *
- * @param os The output stream to write the data to.
- * @param data The data value to output.
- * @param digit_width The minimum width for the output.
- * @param fraction_count The number of digits to display after the decimal point.
+ * @param indent The column of the opening bracket of the outermost dimension.
  */
-template <>
+template <typename T>
 __inline__
-void _output_wrapper(
+void _output_dim(
         std::ostream& os,
-        const int data,
-        const int& digit_width,
-        const int& fraction_count)
+        const T* data,
+        const TensorShape& shape,
+        const int& dim,
+        const int64_t& offset,
+        const int64_t& stride,
+        const bool& summarize,
+        const int64_t& edge_items,
+        const int& indent,
+        const _PrintFormat& format)
 {
-    os << std::setw(digit_width - 1) \
-       << std::setprecision(fraction_count) << std::fixed << data;
+    const int ndim = static_cast<int>(shape.ndim());
+    const int64_t dim_size = shape.dim_size(dim);
+    const int64_t skipped = _skipped_items(dim_size, summarize, edge_items);
+    const int64_t inner = dim_size == 0 ? 0 : stride / dim_size;
+    // Inner dimensions are separated by a line break, and a blank line per further dimension.
+    std::string separator = ", ";
+    if (dim != ndim - 1) {
+        separator = "," + std::string(ndim - dim - 1, '\n') + std::string(indent + dim + 1, ' ');
+    }
+    os << "[";
+    for (int64_t ii = 0; ii < dim_size; ii++) {
+        if (ii != 0) {
+            os << separator;
+        }
+        if (skipped != 0 && ii == edge_items) {
+            os << "..." << separator;
+            ii += skipped;
+        }
+        if (dim == ndim - 1) {
+            _output_wrapper(os, data[offset + ii], format);
+        }
+        else {
+            _output_dim(os, data, shape, dim + 1, offset + ii * inner, inner,
+                        summarize, edge_items, indent, format);
+        }
+    }
+    os << "]";
 }
 
 /**
- *
  * @brief Outputs tensor data to a given output stream.
  *
- * This function outputs tensor data to the specified output stream. It determines the format of the tensor
- * data and prints it accordingly. The format is determined based on the number of dimensions of the tensor.
+ * The data are printed as nested lists of any number of dimensions, aligned to a common width.
+ * Tensors with more elements than the threshold of the print options are summarized as in numpy:
+ * only the leading and trailing edge items of every dimension are printed, the others are replaced
+ * by "...". The width is computed in a single pass over the printed elements only.
  *
  * @tparam T The data type of the tensor.
  *
@@ -204,75 +283,34 @@ void _output_wrapper(
  * @param data A pointer to the tensor data.
  * @param shape The shape of the tensor.
  * @param num_elements The total number of elements in the tensor.
-*/
+ * @param indent The column at which the data start, the width of the preceding prefix.
+ */
 template <typename T>
 __inline__
 void _internal_output(
         std::ostream& os,
         const T * data,
         const TensorShape& shape,
-        const int64_t& num_elements)
+        const int64_t& num_elements,
+        const int& indent = 6)
 {
-    int integer_count = 0, fraction_count = 0;
-    int digit_width = _get_digit_places(data, num_elements, integer_count, fraction_count) + 1;
-    if (shape.ndim() == 1) {
-        os << "[";
-        for (int i = 0; i < num_elements; ++i) {
-            _output_wrapper(os, data[i], digit_width, fraction_count);
-            if (i != num_elements - 1) {
-                os << ",";
-            }
-        }
-        os << "]";
-    }
-    else if (shape.ndim() == 2) {
-        os << "[";
-        for (int i = 0; i < shape.dim_size(0); ++i) {
-            if (i != 0) os << "       ";
-            os << "[";
-            for (int j = 0; j < shape.dim_size(1); ++j) {
-                _output_wrapper(os, data[i * shape.dim_size(1) + j], digit_width, fraction_count);
-                if (j != shape.dim_size(1) - 1) {
-                    os << ", ";
-                }
-            }
-            os << "]";
-            if (i != shape.dim_size(0) - 1) os << ",\n";
-        }
-        os << "]";
-    }
-    else if (shape.ndim() == 3) {
-        os << "[";
-        for (int i = 0; i < shape.dim_size(0); ++i) {
-            if (i != 0) os << "       ";
-            os << "[";
-            for (int j = 0; j < shape.dim_size(1); ++j) {
-                if (j != 0) os << "        ";
-                os << "[";
-                for (int k = 0; k < shape.dim_size(2); ++k) {
-                    _output_wrapper(os, data[i * shape.dim_size(1) * shape.dim_size(2) + j * shape.dim_size(2) + k], digit_width, fraction_count);
-                    if (k != shape.dim_size(2) - 1) {
-                        os << ", ";
-                    }
-                }
-                os << "]";
-                if (j != shape.dim_size(1) - 1) os << ",\n";
-            }
-            os << "]";
-            if (i != shape.dim_size(0) - 1) os << ",\n\n";
-        }
-        os << "]";
-    }
-    else {
-        for (int64_t i = 0; i < num_elements; ++i) {
-            _output_wrapper(os, data[i], 0, 0);
-            if (i < num_elements - 1) {
-                os << ", ";
-            }
-        }
+    const PrintOptions& options = _print_options();
+    const bool summarize = num_elements > options.threshold;
+    const int64_t edge_items = std::max<int64_t>(options.edge_items, 1);
+
+    _PrintFormat format;
+    auto update = [&](const int64_t& offset) {
+        _update_format(data[offset], options.precision, format);
+    };
+    _for_each_printed(shape, 0, 0, num_elements, summarize, edge_items, update);
+
+    if (shape.ndim() == 0) {
+        _output_wrapper(os, data[0], format);
+        return;
     }
+    _output_dim(os, data, shape, 0, 0, num_elements, summarize, edge_items, indent, format);
 }
 
 } // namespace container
 
-#endif // CONTAINER_TENSOR_UTILS_H
\ No newline at end of file
+#endif // CONTAINER_TENSOR_UTILS_H
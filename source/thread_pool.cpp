@@ -0,0 +1,212 @@
+#include "thread_pool.h"
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace container {
+
+namespace {
+
+// Whether the thread is a worker or is running a chunk, nested loops run serially.
+thread_local bool in_region = false;
+
+// More chunks than threads, so that stealing can balance uneven chunks.
+const int64_t kChunksPerThread = 4;
+
+std::mutex global_pool_mutex;
+std::unique_ptr<ThreadPool> global_pool;
+
+int env_int(const char* name, const int& fallback) {
+    const char* value = std::getenv(name);
+    return value == nullptr || *value == '\0' ? fallback : std::atoi(value);
+}
+
+void pin_to_core(const int& core) {
+#if defined(__linux__)
+    const int num_cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % num_cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(const int& num_threads, const bool& pin_threads) {
+    int total = num_threads > 0 ? num_threads : static_cast<int>(std::thread::hardware_concurrency());
+    total = std::max(1, total);
+    for (int ii = 0; ii < total; ii++) {
+        queues_.emplace_back(new Queue);
+    }
+    for (int ii = 1; ii < total; ii++) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, ii, pin_threads);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+int ThreadPool::num_threads() const {
+    return static_cast<int>(queues_.size());
+}
+
+bool ThreadPool::in_parallel_region() {
+    return in_region;
+}
+
+bool ThreadPool::pop(const int& queue, Task& task) {
+    Queue& q = *queues_[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) {
+        return false;
+    }
+    task = q.tasks.front();
+    q.tasks.pop_front();
+    queued_--;
+    return true;
+}
+
+bool ThreadPool::steal(const int& thief, Task& task) {
+    const int num_queues = static_cast<int>(queues_.size());
+    for (int ii = 1; ii < num_queues; ii++) {
+        Queue& q = *queues_[(thief + ii) % num_queues];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            task = q.tasks.back();
+            q.tasks.pop_back();
+            queued_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(const Task& task) {
+    Region* region = task.region;
+    if (!region->failed.load()) {
+        try {
+            (*region->body)(task.chunk);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(region->mutex);
+            if (!region->error) {
+                region->error = std::current_exception();
+            }
+            region->failed.store(true);
+        }
+    }
+    // The region lives on the stack of the caller, it must not be touched after this.
+    region->pending.fetch_sub(1);
+}
+
+void ThreadPool::worker_loop(const int& id, const bool& pin_thread) {
+    if (pin_thread) {
+        pin_to_core(id);
+    }
+    in_region = true;
+    Task task;
+    while (true) {
+        if (pop(id, task) || steal(id, task)) {
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this]() { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::run(const int64_t& num_chunks, const std::function<void(int64_t)>& body) {
+    if (num_chunks <= 0) {
+        return;
+    }
+    if (num_chunks == 1 || workers_.empty() || in_region) {
+        for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+            body(chunk);
+        }
+        return;
+    }
+    Region region;
+    region.body = &body;
+    region.pending.store(num_chunks);
+    const int64_t num_queues = static_cast<int64_t>(queues_.size());
+    for (int64_t queue = 0; queue < std::min(num_queues, num_chunks); queue++) {
+        Queue& q = *queues_[queue];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        for (int64_t chunk = queue; chunk < num_chunks; chunk += num_queues) {
+            Task task;
+            task.region = &region;
+            task.chunk = chunk;
+            q.tasks.push_back(task);
+        }
+    }
+    queued_ += num_chunks;
+    {
+        // Pairs with the predicate check of the sleeping workers, no wake-up is lost.
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+
+    in_region = true;
+    Task task;
+    while (region.pending.load() > 0) {
+        if (pop(0, task) || steal(0, task)) {
+            execute(task);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    in_region = false;
+    if (region.error) {
+        std::rethrow_exception(region.error);
+    }
+}
+
+ThreadPool& get_thread_pool() {
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    if (global_pool == nullptr) {
+        global_pool.reset(new ThreadPool(
+                env_int("CONTAINER_NUM_THREADS", 0), env_int("CONTAINER_PIN_THREADS", 0) != 0));
+    }
+    return *global_pool;
+}
+
+void set_num_threads(const int& num_threads, const bool& pin_threads) {
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    global_pool.reset();
+    global_pool.reset(new ThreadPool(num_threads, pin_threads));
+}
+
+int get_num_threads() {
+    return get_thread_pool().num_threads();
+}
+
+int64_t parallel_chunks(const int64_t& n, const int64_t& grain_size) {
+    const int64_t grain = std::max<int64_t>(1, grain_size);
+    if (n <= grain || ThreadPool::in_parallel_region()) {
+        return 1;
+    }
+    const int64_t num_threads = get_num_threads();
+    if (num_threads == 1) {
+        return 1;
+    }
+    return std::min((n + grain - 1) / grain, kChunksPerThread * num_threads);
+}
+
+} // namespace container
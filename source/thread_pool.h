@@ -0,0 +1,207 @@
+#ifndef CONTAINER_THREAD_POOL_H
+#define CONTAINER_THREAD_POOL_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace container {
+
+/**
+ * @brief A work-stealing pool of CPU worker threads.
+ *
+ * A parallel loop is cut into chunks, which are dealt round-robin to the queues of the workers
+ * and of the calling thread. Every thread runs the chunks of its own queue first and then steals
+ * from the back of the other queues, so that uneven chunks are balanced without a central queue.
+ * The calling thread takes part in the loop and returns when all the chunks are done.
+ *
+ * Loops started from inside a chunk run serially on the thread that started them, so that nested
+ * kernels never oversubscribe the cores or wait for themselves.
+ */
+class ThreadPool {
+  public:
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param num_threads The total number of threads including the caller, 0 for the hardware concurrency.
+     * @param pin_threads Bind worker ii to core ii (the calling thread is not bound), Linux only.
+     */
+    explicit ThreadPool(const int& num_threads = 0, const bool& pin_threads = false);
+
+    /**
+     * @brief Stop the workers after the queued chunks are done.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief The number of threads taking part in a loop, including the caller.
+     */
+    int num_threads() const;
+
+    /**
+     * @brief Run body(chunk) for chunk = 0, ..., num_chunks - 1 in parallel and wait for them.
+     *
+     * The remaining chunks are skipped after a chunk threw, and the first exception is rethrown.
+     */
+    void run(const int64_t& num_chunks, const std::function<void(int64_t)>& body);
+
+    /**
+     * @brief Whether the calling thread is running a chunk of a loop.
+     */
+    static bool in_parallel_region();
+
+  private:
+    struct Region {
+        const std::function<void(int64_t)>* body = nullptr;
+        std::atomic<int64_t> pending{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex mutex;
+    };
+
+    struct Task {
+        Region* region = nullptr;
+        int64_t chunk = 0;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Take a task from the front of the own queue, or from the back of another one.
+    bool pop(const int& queue, Task& task);
+    bool steal(const int& thief, Task& task);
+    void execute(const Task& task);
+    void worker_loop(const int& id, const bool& pin_thread);
+
+    std::vector<std::unique_ptr<Queue>> queues_; ///< queues_[0] is shared by the calling threads.
+    std::vector<std::thread> workers_;
+    std::atomic<int64_t> queued_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};
+
+/**
+ * @brief Get the pool shared by all the CPU kernels.
+ *
+ * It is created on the first use, with the number of threads given by the environment variable
+ * CONTAINER_NUM_THREADS (the hardware concurrency if unset), and bound to cores if
+ * CONTAINER_PIN_THREADS is set to a nonzero value.
+ */
+ThreadPool& get_thread_pool();
+
+/**
+ * @brief Replace the shared pool, e.g. to leave cores to MPI ranks or to a threaded BLAS.
+ *
+ * Must not be called while a parallel loop is running.
+ *
+ * @param num_threads The total number of threads, 0 for the hardware concurrency, 1 runs all loops serially.
+ * @param pin_threads Bind the workers to cores.
+ */
+void set_num_threads(const int& num_threads, const bool& pin_threads = false);
+
+/**
+ * @brief The number of threads of the shared pool.
+ */
+int get_num_threads();
+
+/**
+ * @brief The number of chunks for a loop of n iterations with at least grain_size iterations each,
+ * 1 if the loop should run serially.
+ */
+int64_t parallel_chunks(const int64_t& n, const int64_t& grain_size);
+
+/**
+ * @brief Memory-bound loops over less data than this run on the calling thread,
+ * a single core nearly saturates the bandwidth.
+ */
+constexpr size_t kParallelBytes = 1 << 18;
+
+/**
+ * @brief The grain size of a memory-bound loop over elements of type T, kParallelBytes per chunk.
+ */
+template <typename T>
+int64_t parallel_grain_size() {
+    return static_cast<int64_t>(std::max<size_t>(1, kParallelBytes / sizeof(T)));
+}
+
+/**
+ * @brief Run f(chunk_begin, chunk_end) over disjoint chunks of [begin, end) on the shared pool.
+ *
+ * @param begin The first index.
+ * @param end One past the last index.
+ * @param grain_size The minimal number of iterations per chunk, loops not larger than this run
+ *                   serially on the calling thread.
+ * @param f The loop body, called with the bounds of a chunk.
+ */
+template <typename Function>
+void parallel_for(const int64_t& begin, const int64_t& end, const int64_t& grain_size, const Function& f) {
+    const int64_t n = end - begin;
+    if (n <= 0) {
+        return;
+    }
+    const int64_t chunks = parallel_chunks(n, grain_size);
+    if (chunks == 1) {
+        f(begin, end);
+        return;
+    }
+    get_thread_pool().run(chunks, [&](int64_t chunk) {
+        f(begin + n * chunk / chunks, begin + n * (chunk + 1) / chunks);
+    });
+}
+
+/**
+ * @brief Reduce over [begin, end) on the shared pool.
+ *
+ * Every chunk computes f(chunk_begin, chunk_end, identity), and the partial results are combined
+ * with reduce in the order of the chunks, so the result only depends on the number of threads.
+ *
+ * @param identity The neutral element of reduce.
+ * @param f The chunk body, T f(int64_t begin, int64_t end, T init).
+ * @param reduce The combination of two partial results, T reduce(T a, T b).
+ */
+template <typename T, typename Function, typename Reduce>
+T parallel_reduce(
+        const int64_t& begin,
+        const int64_t& end,
+        const int64_t& grain_size,
+        const T& identity,
+        const Function& f,
+        const Reduce& reduce)
+{
+    const int64_t n = end - begin;
+    if (n <= 0) {
+        return identity;
+    }
+    const int64_t chunks = parallel_chunks(n, grain_size);
+    if (chunks == 1) {
+        return f(begin, end, identity);
+    }
+    std::vector<T> partial(chunks, identity);
+    get_thread_pool().run(chunks, [&](int64_t chunk) {
+        partial[chunk] = f(begin + n * chunk / chunks, begin + n * (chunk + 1) / chunks, identity);
+    });
+    T result = identity;
+    for (const T& value : partial) {
+        result = reduce(result, value);
+    }
+    return result;
+}
+
+} // namespace container
+
+#endif // CONTAINER_THREAD_POOL_H